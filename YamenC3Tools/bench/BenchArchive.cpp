@@ -0,0 +1,137 @@
+#include "C3Bench.h"
+#include "Core/C3DnpArchive.h"
+#include "Core/C3WdfArchive.h"
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <random>
+
+namespace {
+
+// Writes a DNP with 'count' random ids and 16-byte payloads
+bool WriteSyntheticDnp(const std::string& path, uint32_t count, std::vector<uint32_t>& ids) {
+    std::mt19937 rng(1234);
+    ids.resize(count);
+    for (auto& id : ids) id = rng();
+
+    C3DnpArchive::Header header{};
+    strncpy(header.tag, C3DnpArchive::kTag, sizeof(header.tag));
+    header.version = C3DnpArchive::kVersion;
+    header.count = count;
+
+    const uint32_t dataStart = static_cast<uint32_t>(sizeof(header) + count * sizeof(C3DnpArchive::IndexEntry));
+    std::vector<C3DnpArchive::IndexEntry> index(count);
+    for (uint32_t i = 0; i < count; i++) {
+        index[i] = { ids[i], 16, dataStart + i * 16 };
+    }
+
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    std::vector<uint8_t> payload(size_t(count) * 16, 0xCD);
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+        fwrite(index.data(), sizeof(C3DnpArchive::IndexEntry), count, f) == count &&
+        fwrite(payload.data(), 1, payload.size(), f) == payload.size();
+    fclose(f);
+    return ok;
+}
+
+void BenchLookups(const char* bench, const std::string& label, const C3Archive& archive,
+    const std::vector<uint32_t>& hitIds) {
+    if (hitIds.empty()) return;
+
+    std::mt19937 rng(42);
+    std::vector<uint32_t> order(1 << 20);
+    for (auto& id : order) id = hitIds[rng() % hitIds.size()];
+    std::vector<uint32_t> misses(1 << 20);
+    for (auto& id : misses) id = rng();
+
+    size_t i = 0;
+    C3Archive::Entry entry;
+    double hitNs = C3Bench::TimeNs(order.size(), [&] {
+        C3Bench::Consume(archive.Find(order[i++], entry) ? entry.offset : 0);
+    });
+    i = 0;
+    double missNs = C3Bench::TimeNs(misses.size(), [&] {
+        C3Bench::Consume(archive.Find(misses[i++], entry) ? 1 : 0);
+    });
+
+    C3Bench::Report(bench, label + " hit", hitNs, "ns/lookup");
+    C3Bench::Report(bench, label + " miss", missNs, "ns/lookup");
+}
+
+} // namespace
+
+C3_BENCHMARK(ArchiveLookup) {
+    const uint32_t count = 200000;
+    std::string path = ctx.workDir + "/synthetic.dnp";
+    std::vector<uint32_t> ids;
+    if (!WriteSyntheticDnp(path, count, ids)) {
+        printf("ArchiveLookup: failed to write %s\n", path.c_str());
+        return;
+    }
+
+    C3DnpArchive dnp;
+    if (!dnp.Open(path)) {
+        printf("ArchiveLookup: %s\n", dnp.GetLastError().c_str());
+        return;
+    }
+    BenchLookups("ArchiveLookup", "DNP flat table (200k)", dnp, ids);
+
+    auto stats = dnp.GetLookupStats();
+    C3Bench::Report("ArchiveLookup", "DNP load factor", stats.loadFactor, "");
+    C3Bench::Report("ArchiveLookup", "DNP average probes", stats.averageProbes, "slots");
+    C3Bench::Report("ArchiveLookup", "DNP max probes", stats.maxProbes, "slots");
+    C3Bench::Report("ArchiveLookup", "DNP repeated ids", double(stats.shadowed), "");
+
+    // Random ids repeat now and then; each must resolve to its last index entry
+    std::map<uint32_t, uint32_t> lastEntry;
+    for (uint32_t e = 0; e < count; e++) lastEntry[ids[e]] = e;
+    const uint64_t dataStart = sizeof(C3DnpArchive::Header) + uint64_t(count) * sizeof(C3DnpArchive::IndexEntry);
+    size_t wrongWinner = 0;
+    for (const auto& [id, e] : lastEntry) {
+        C3Archive::Entry entry;
+        if (!dnp.Find(id, entry) || entry.offset != dataStart + uint64_t(e) * 16) wrongWinner++;
+    }
+    if (wrongWinner || dnp.GetEntryCount() != lastEntry.size()) {
+        printf("ArchiveLookup: %zu repeated ids resolve to the wrong entry, %zu entries listed for %zu ids\n",
+            wrongWinner, dnp.GetEntryCount(), lastEntry.size());
+    }
+
+    // Baseline: the legacy CDnFile index, one heap node per entry
+    struct FileIndexInfo { unsigned long size, offset; };
+    std::map<unsigned long, std::unique_ptr<FileIndexInfo>> legacy;
+    for (size_t i = 0; i < dnp.GetEntryCount(); i++) {
+        auto e = dnp.GetEntry(i);
+        legacy[e.id] = std::make_unique<FileIndexInfo>(FileIndexInfo{ e.size, static_cast<unsigned long>(e.offset) });
+    }
+    std::mt19937 rng(42);
+    size_t i = 0;
+    std::vector<uint32_t> order(1 << 20);
+    for (auto& id : order) id = ids[rng() % ids.size()];
+    double mapNs = C3Bench::TimeNs(order.size(), [&] {
+        auto it = legacy.find(order[i++]);
+        C3Bench::Consume(it != legacy.end() ? it->second->offset : 0);
+    });
+    C3Bench::Report("ArchiveLookup", "std::map baseline (200k) hit", mapNs, "ns/lookup");
+
+    // Real archives passed on the command line
+    for (const auto& input : ctx.inputs) {
+        std::unique_ptr<C3Archive> archive;
+        if (input.size() > 4 && input.compare(input.size() - 4, 4, ".dnp") == 0) {
+            archive = std::make_unique<C3DnpArchive>();
+        }
+        else if (input.size() > 4 && input.compare(input.size() - 4, 4, ".wdf") == 0) {
+            archive = std::make_unique<C3WdfArchive>();
+        }
+        if (!archive) continue;
+        if (!archive->Open(input)) {
+            printf("ArchiveLookup: %s\n", archive->GetLastError().c_str());
+            continue;
+        }
+
+        std::vector<uint32_t> archiveIds(archive->GetEntryCount());
+        for (size_t e = 0; e < archiveIds.size(); e++) archiveIds[e] = archive->GetEntry(e).id;
+        BenchLookups("ArchiveLookup", input, *archive, archiveIds);
+    }
+}
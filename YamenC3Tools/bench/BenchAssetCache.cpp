@@ -0,0 +1,97 @@
+#include "C3Bench.h"
+#include "Core/C3AssetCache.h"
+#include "Core/C3Model.h"
+#include "Core/C3VirtualFileSystem.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <thread>
+
+namespace {
+
+constexpr size_t kFileCount = 1000;
+
+// Skewed like a scene: a few meshes are drawn constantly, most rarely
+std::vector<std::string> BuildAccesses(size_t count) {
+    std::mt19937 rng(8);
+    std::vector<std::string> accesses;
+    accesses.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        size_t file = std::min(kFileCount - 1, size_t(std::pow(double(rng() % 10000) / 10000.0, 3.0) * kFileCount));
+        accesses.push_back("c3/mesh" + std::to_string(file % 16) + "/" + std::to_string(file) + ".c3");
+    }
+    return accesses;
+}
+
+} // namespace
+
+C3_BENCHMARK(AssetCache) {
+    const std::string corpus = ctx.workDir + "/assetcache";
+    std::filesystem::remove_all(corpus);
+    if (!C3Bench::WriteMeshCorpus(corpus, kFileCount, 32)) {
+        printf("AssetCache: failed to write corpus\n");
+        return;
+    }
+    C3VirtualFileSystem vfs;
+    vfs.AddDirectory(corpus);
+    const std::vector<std::string> accesses = BuildAccesses(20000);
+
+    // Working set size, from a cache that keeps everything
+    size_t workingSet = 0;
+    {
+        C3AssetCache all(SIZE_MAX);
+        for (const auto& path : accesses) all.LoadModel(vfs, path);
+        workingSet = all.GetStats().bytes;
+    }
+    C3Bench::Report("AssetCache", "working set", workingSet / (1024.0 * 1024.0), "MB");
+
+    double uncachedNs = C3Bench::TimeNs(1, [&] {
+        C3VirtualFileSystem::FileData file;
+        for (const auto& path : accesses) {
+            C3Model model;
+            if (vfs.Open(path, file)) C3Bench::Consume(model.LoadFromMemory(file.Data(), file.Size()));
+        }
+    });
+    C3Bench::Report("AssetCache", "no cache (parse every access)", uncachedNs / accesses.size() / 1000.0, "us/access");
+
+    for (int percent : { 10, 25, 50 }) {
+        C3AssetCache cache(workingSet * percent / 100);
+        double ns = C3Bench::TimeNs(1, [&] {
+            for (const auto& path : accesses) C3Bench::Consume(cache.LoadModel(vfs, path) != nullptr);
+        });
+        C3AssetCache::Stats stats = cache.GetStats();
+        const std::string label = "budget " + std::to_string(percent) + "% of working set";
+        C3Bench::Report("AssetCache", label, ns / accesses.size() / 1000.0, "us/access");
+        C3Bench::Report("AssetCache", label + " hit rate", stats.HitRate() * 100.0, "%");
+        C3Bench::Report("AssetCache", label + " evictions", double(stats.evictions), "");
+        if (stats.bytes > stats.budget) printf("AssetCache: %zu bytes held over a %zu budget\n", stats.bytes, stats.budget);
+    }
+
+    // Readers hammering hot entries: hits take shard locks in shared mode only
+    C3AssetCache cache(SIZE_MAX);
+    std::vector<C3AssetCache::Key> keys;
+    for (size_t i = 0; i < 64; i++) {
+        const std::string path = "c3/mesh" + std::to_string(i % 16) + "/" + std::to_string(i) + ".c3";
+        cache.LoadModel(vfs, path);
+        keys.push_back(C3AssetCache::KeyForPath(path));
+    }
+    for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+        constexpr size_t kLookups = 400000;
+        std::atomic<uint64_t> found{ 0 };
+        double ns = C3Bench::TimeNs(1, [&] {
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threads; t++) {
+                workers.emplace_back([&, t] {
+                    uint64_t local = 0;
+                    for (size_t i = 0; i < kLookups; i++) local += cache.GetModel(keys[(i * 7 + t) % keys.size()]) != nullptr;
+                    found += local;
+                });
+            }
+            for (auto& w : workers) w.join();
+        });
+        C3Bench::Consume(found);
+        C3Bench::Report("AssetCache", std::to_string(threads) + " thread hits", double(kLookups) * threads / (ns * 1e-9) / 1e6, "M/s");
+    }
+}
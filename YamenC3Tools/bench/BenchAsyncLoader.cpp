@@ -0,0 +1,106 @@
+#include "C3Bench.h"
+#include "Core/C3AsyncLoader.h"
+#include "Core/C3Model.h"
+#include "Core/C3VirtualFileSystem.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+namespace {
+
+constexpr size_t kFileCount = 1000;
+
+std::string MeshPath(size_t i) {
+    return "c3/mesh" + std::to_string(i % 16) + "/" + std::to_string(i) + ".c3";
+}
+
+// Stand-in for whatever the caller does between requests, e.g. drawing
+void OtherWork(uint64_t iterations) {
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (uint64_t i = 0; i < iterations; i++) x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    C3Bench::Consume(x);
+}
+
+} // namespace
+
+C3_BENCHMARK(AsyncLoader) {
+    const std::string corpus = ctx.workDir + "/asyncloader";
+    std::filesystem::remove_all(corpus);
+    std::vector<std::string> files;
+    if (!C3Bench::WriteMeshCorpus(corpus, kFileCount, 32, &files)) {
+        printf("AsyncLoader: failed to write corpus\n");
+        return;
+    }
+    C3VirtualFileSystem vfs;
+    vfs.AddDirectory(corpus);
+    const unsigned workers = std::max(2u, std::thread::hardware_concurrency());
+    constexpr uint64_t kWorkPerFile = 20000;
+
+    // Load then work, one file at a time, as GetDataAni does
+    C3Bench::EvictFromPageCache(files);
+    double syncNs = C3Bench::TimeNs(1, [&] {
+        C3VirtualFileSystem::FileData file;
+        for (size_t i = 0; i < kFileCount; i++) {
+            C3Model model;
+            if (vfs.Open(MeshPath(i), file)) C3Bench::Consume(model.LoadFromMemory(file.Data(), file.Size()));
+            OtherWork(kWorkPerFile);
+        }
+    });
+    C3Bench::Report("AsyncLoader", "synchronous load + work", syncNs / 1e6, "ms");
+
+    // Queue everything, work, then collect
+    C3Bench::EvictFromPageCache(files);
+    double asyncNs = C3Bench::TimeNs(1, [&] {
+        C3AsyncLoader loader(vfs, nullptr, workers);
+        std::vector<C3AsyncLoader::Handle> handles;
+        handles.reserve(kFileCount);
+        for (size_t i = 0; i < kFileCount; i++) handles.push_back(loader.LoadModel(MeshPath(i), C3AsyncLoader::Priority::Background));
+        for (size_t i = 0; i < kFileCount; i++) OtherWork(kWorkPerFile);
+        size_t loaded = 0;
+        for (auto& handle : handles) loaded += handle.Wait();
+        C3Bench::Consume(loaded);
+    });
+    C3Bench::Report("AsyncLoader", std::to_string(workers) + " workers, load overlapped with work", asyncNs / 1e6, "ms");
+
+    // One urgent asset requested behind a full background queue
+    {
+        C3AsyncLoader loader(vfs, nullptr, workers);
+        std::vector<C3AsyncLoader::Handle> background;
+        for (size_t i = 0; i + 1 < kFileCount; i++) background.push_back(loader.LoadModel(MeshPath(i), C3AsyncLoader::Priority::Background));
+        double queuedNs = C3Bench::TimeNs(1, [&] {
+            auto handle = loader.LoadModel(MeshPath(kFileCount - 1), C3AsyncLoader::Priority::Background);
+            while (!handle.IsReady()) std::this_thread::yield();
+        });
+        C3Bench::Report("AsyncLoader", "urgent asset, polled at background priority", queuedNs / 1000.0, "us");
+        loader.WaitIdle();
+    }
+    {
+        C3AsyncLoader loader(vfs, nullptr, workers);
+        std::vector<C3AsyncLoader::Handle> background;
+        for (size_t i = 0; i + 1 < kFileCount; i++) background.push_back(loader.LoadModel(MeshPath(i), C3AsyncLoader::Priority::Background));
+        double waitNs = C3Bench::TimeNs(1, [&] {
+            auto handle = loader.LoadModel(MeshPath(kFileCount - 1), C3AsyncLoader::Priority::Background);
+            C3Bench::Consume(handle.Wait());
+        });
+        C3Bench::Report("AsyncLoader", "urgent asset, Wait() promotes", waitNs / 1000.0, "us");
+        loader.CancelAll();
+        C3AsyncLoader::Stats stats = loader.GetStats();
+        C3Bench::Report("AsyncLoader", "background requests cancelled", double(stats.cancelled), "");
+    }
+
+    // Many callers asking for the same few assets at once: repeats join the
+    // load in flight or, once it is done, find the result in the cache
+    {
+        C3AssetCache cache(SIZE_MAX);
+        C3AsyncLoader loader(vfs, &cache, workers);
+        std::vector<C3AsyncLoader::Handle> handles;
+        for (size_t i = 0; i < 10000; i++) handles.push_back(loader.LoadModel(MeshPath(i % 100)));
+        loader.WaitIdle();
+        C3AsyncLoader::Stats stats = loader.GetStats();
+        C3Bench::Report("AsyncLoader", "10000 requests over 100 paths, loads", double(stats.loaded), "");
+        C3Bench::Report("AsyncLoader", "10000 requests over 100 paths, merged", double(stats.merged), "");
+        C3Bench::Report("AsyncLoader", "10000 requests over 100 paths, cache hits", double(stats.cacheHits), "");
+    }
+}
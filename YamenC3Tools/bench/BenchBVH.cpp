@@ -0,0 +1,121 @@
+#include "C3Bench.h"
+#include "Core/C3MeshBVH.h"
+#include "Core/C3Model.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+constexpr uint32_t kGridSide = 230;   // 229 * 229 * 2 = 104,882 triangles in 52,900 vertices
+constexpr size_t kRayCount = 100000;
+constexpr size_t kBuildRuns = 5;
+
+// A rolling terrain, so rays hit at varied depths and the tree is not flat
+C3Model::MeshPart MakeTerrain() {
+    C3Model::MeshPart mesh;
+    std::vector<PhyVertex> vertices(size_t(kGridSide) * kGridSide);
+    for (uint32_t z = 0; z < kGridSide; z++) {
+        for (uint32_t x = 0; x < kGridSide; x++) {
+            PhyVertex& v = vertices[size_t(z) * kGridSide + x];
+            v = PhyVertex{};
+            const float fx = float(x), fz = float(z);
+            const float y = 6.0f * sinf(fx * 0.07f) * cosf(fz * 0.05f) + 2.0f * sinf((fx + fz) * 0.23f);
+            for (auto& p : v.positions) p = XMFLOAT3(fx, y, fz);
+            v.u = fx / (kGridSide - 1);
+            v.v = fz / (kGridSide - 1);
+        }
+    }
+    std::vector<uint16_t> indices;
+    indices.reserve(size_t(kGridSide - 1) * (kGridSide - 1) * 6);
+    for (uint32_t z = 0; z + 1 < kGridSide; z++) {
+        for (uint32_t x = 0; x + 1 < kGridSide; x++) {
+            const uint16_t i = static_cast<uint16_t>(z * kGridSide + x);
+            const uint16_t right = static_cast<uint16_t>(i + 1);
+            const uint16_t below = static_cast<uint16_t>(i + kGridSide);
+            indices.insert(indices.end(), { i, below, right, right, below, static_cast<uint16_t>(below + 1) });
+        }
+    }
+    mesh.name = "terrain";
+    mesh.vertices = std::move(vertices);
+    mesh.normalIndices = std::move(indices);
+    C3Model::ComputeMeshBounds(mesh, mesh.bboxMin, mesh.bboxMax);
+    return mesh;
+}
+
+struct Ray {
+    XMFLOAT3 origin;
+    XMFLOAT3 direction;
+};
+
+// Picking-style rays from above at random slants, plus grazing rays
+// across the surface that walk many nodes and often miss
+std::vector<Ray> MakeRays(std::mt19937& rng) {
+    const float side = float(kGridSide - 1);
+    std::uniform_real_distribution<float> pos(0.0f, side);
+    std::uniform_real_distribution<float> slant(-0.5f, 0.5f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::vector<Ray> rays(kRayCount);
+    for (size_t i = 0; i < rays.size(); i++) {
+        if (i % 4 != 3) {
+            rays[i] = { XMFLOAT3(pos(rng), 50.0f, pos(rng)), XMFLOAT3(slant(rng), -1.0f, slant(rng)) };
+        }
+        else {
+            const float a = angle(rng);
+            rays[i] = { XMFLOAT3(pos(rng), 9.0f, pos(rng)), XMFLOAT3(cosf(a), -0.05f, sinf(a)) };
+        }
+    }
+    return rays;
+}
+
+} // namespace
+
+C3_BENCHMARK(BVH) {
+    (void)ctx;
+    const C3Model::MeshPart mesh = MakeTerrain();
+
+    C3MeshBVH bvh;
+    const double buildNs = C3Bench::TimeNs(kBuildRuns, [&] { bvh.Build(mesh); });
+    if (bvh.IsEmpty()) {
+        printf("BVH: build failed\n");
+        return;
+    }
+    C3Bench::Report("BVH", "triangles", double(bvh.GetTriangleCount()), "");
+    C3Bench::Report("BVH", "nodes", double(bvh.GetNodeCount()), "");
+    C3Bench::Report("BVH", "build", buildNs / 1e6, "ms");
+
+    std::mt19937 rng(28);
+    const std::vector<Ray> rays = MakeRays(rng);
+
+    // Each ray timed on its own for the latency distribution
+    std::vector<double> latencies(rays.size());
+    size_t hits = 0;
+    for (size_t i = 0; i < rays.size(); i++) {
+        C3MeshBVH::Hit hit;
+        const auto start = std::chrono::steady_clock::now();
+        const bool found = bvh.Raycast(rays[i].origin, rays[i].direction, 1e30f, hit);
+        const auto end = std::chrono::steady_clock::now();
+        latencies[i] = std::chrono::duration<double, std::nano>(end - start).count();
+        hits += found;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) { return latencies[std::min(latencies.size() - 1, size_t(p * latencies.size()))]; };
+
+    // Back to back, without the clock reads, for throughput
+    uint64_t checksum = 0;
+    const double batchNs = C3Bench::TimeNs(1, [&] {
+        for (const Ray& ray : rays) {
+            C3MeshBVH::Hit hit;
+            if (bvh.Raycast(ray.origin, ray.direction, 1e30f, hit)) checksum += hit.triangleIndex;
+        }
+    });
+    C3Bench::Consume(checksum);
+
+    C3Bench::Report("BVH", "ray hit rate", double(hits) / rays.size() * 100.0, "%");
+    C3Bench::Report("BVH", "ray latency p50", percentile(0.50), "ns");
+    C3Bench::Report("BVH", "ray latency p99", percentile(0.99), "ns");
+    C3Bench::Report("BVH", "ray latency max", latencies.back(), "ns");
+    C3Bench::Report("BVH", "rays, back to back", batchNs / rays.size(), "ns/ray");
+}
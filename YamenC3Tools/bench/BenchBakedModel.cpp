@@ -0,0 +1,103 @@
+#include "C3Bench.h"
+#include "Core/C3BakedModel.h"
+#include "Core/C3Model.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+
+namespace {
+
+constexpr size_t kFileCount = 1000;
+
+bool SameMesh(const C3Model::MeshPart& a, const C3Model::MeshPart& b) {
+    return a.name == b.name && a.textureName == b.textureName && a.vertices.size() == b.vertices.size() &&
+        memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(PhyVertex)) == 0 &&
+        a.normalIndices == b.normalIndices && a.alphaIndices == b.alphaIndices &&
+        memcmp(&a.initialMatrix, &b.initialMatrix, sizeof(XMFLOAT4X4)) == 0 && a.lods.size() == b.lods.size();
+}
+
+} // namespace
+
+C3_BENCHMARK(BakedModel) {
+    const std::string corpus = ctx.workDir + "/baked";
+    std::filesystem::remove_all(corpus);
+    std::vector<std::string> files;
+    if (!C3Bench::WriteMeshCorpus(corpus, kFileCount, 64, &files)) {
+        printf("BakedModel: failed to write corpus\n");
+        return;
+    }
+
+    std::vector<std::string> bakedFiles;
+    size_t mismatches = 0;
+    for (const auto& path : files) {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        C3Model model;
+        std::string error;
+        const std::string bakedPath = C3BakedModel::GetBakedPath(path);
+        if (!model.LoadFromMemory(bytes) ||
+            !model.SaveBaked(bakedPath, C3BakedModel::SourceChecksum(bytes.data(), bytes.size()), &error)) {
+            printf("BakedModel: %s %s\n", path.c_str(), error.empty() ? model.GetError().c_str() : error.c_str());
+            return;
+        }
+        bakedFiles.push_back(bakedPath);
+
+        C3Model reloaded;
+        if (!reloaded.LoadBaked(bakedPath) || reloaded.GetMeshes().size() != model.GetMeshes().size() ||
+            !SameMesh(reloaded.GetMeshes()[0], model.GetMeshes()[0])) mismatches++;
+    }
+    if (mismatches) printf("BakedModel: %zu models differ after a round trip\n", mismatches);
+
+    uint64_t sourceBytes = 0, bakedBytes = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        sourceBytes += std::filesystem::file_size(files[i]);
+        bakedBytes += std::filesystem::file_size(bakedFiles[i]);
+    }
+    C3Bench::Report("BakedModel", "size, .c3", sourceBytes / (1024.0 * 1024.0), "MB");
+    C3Bench::Report("BakedModel", "size, baked", bakedBytes / (1024.0 * 1024.0), "MB");
+
+    auto loadFromFile = [&] {
+        for (const auto& path : files) {
+            C3Model model;
+            C3Bench::Consume(model.LoadFromFile(path));
+        }
+    };
+    auto loadBaked = [&] {
+        for (const auto& path : bakedFiles) {
+            C3Model model;
+            C3Bench::Consume(model.LoadBaked(path));
+        }
+    };
+    // The view alone, reading every position as an uploader would
+    auto openBaked = [&] {
+        for (const auto& path : bakedFiles) {
+            C3BakedModel baked;
+            if (!baked.Open(path)) continue;
+            float sum = 0.0f;
+            for (const auto& mesh : baked.GetMeshes()) {
+                for (const XMFLOAT3& p : baked.GetBlock<XMFLOAT3>(mesh.positions[0])) sum += p.x;
+            }
+            C3Bench::Consume(static_cast<uint64_t>(sum));
+        }
+    };
+
+    struct Case {
+        const char* label;
+        const std::vector<std::string>* paths;
+        std::function<void()> run;
+    };
+    const Case cases[] = {
+        { "LoadFromFile", &files, loadFromFile },
+        { "LoadBaked (to C3Model)", &bakedFiles, loadBaked },
+        { "C3BakedModel::Open + read positions", &bakedFiles, openBaked },
+    };
+    for (const Case& c : cases) {
+        C3Bench::EvictFromPageCache(*c.paths);
+        double coldNs = C3Bench::TimeNs(1, c.run);
+        double warmNs = C3Bench::TimeNs(3, c.run);
+        C3Bench::Report("BakedModel", std::string(c.label) + " (cold)", coldNs / kFileCount / 1000.0, "us/file");
+        C3Bench::Report("BakedModel", std::string(c.label) + " (warm)", warmNs / kFileCount / 1000.0, "us/file");
+    }
+}
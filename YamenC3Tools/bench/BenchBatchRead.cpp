@@ -0,0 +1,68 @@
+#include "C3Bench.h"
+#include "Core/C3BatchReader.h"
+#include "Core/C3Model.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+C3_BENCHMARK(BatchRead) {
+    const std::string corpus = ctx.workDir + "/batch";
+    std::filesystem::remove_all(corpus);
+    std::vector<std::string> paths;
+    if (!C3Bench::WriteMeshCorpus(corpus, 4000, 24, &paths)) {
+        printf("BatchRead: failed to write corpus\n");
+        return;
+    }
+    uint64_t totalBytes = 0;
+    for (const auto& path : paths) totalBytes += std::filesystem::file_size(path);
+
+    auto report = [&](const std::string& label, double ns) {
+        C3Bench::Report("BatchRead", label + " (cold)", double(paths.size()) / (ns * 1e-9), "files/s");
+        C3Bench::Report("BatchRead", label + " (cold)", C3Bench::ThroughputMBs(totalBytes, ns), "MB/s");
+    };
+
+    // Baseline: one blocking open/read per asset on the calling thread
+    C3Bench::EvictFromPageCache(paths);
+    report("Sequential ifstream", C3Bench::TimeNs(1, [&] {
+        std::vector<char> buffer;
+        for (const auto& path : paths) {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            buffer.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(buffer.data(), buffer.size());
+            C3Bench::Consume(buffer.empty() ? 0 : uint8_t(buffer[0]));
+        }
+    }));
+
+    for (bool uring : { false, true }) {
+        C3BatchReader::Options options;
+        options.allowIoUring = uring;
+        C3BatchReader reader(options);
+        if (uring && reader.GetBackend() != C3BatchReader::Backend::IoUring) {
+            printf("BatchRead: io_uring unavailable (%s)\n", reader.GetLastError().c_str());
+            continue;
+        }
+        const std::string name = C3BatchReader::GetBackendName(reader.GetBackend());
+
+        C3Bench::EvictFromPageCache(paths);
+        report("ReadAll, " + name, C3Bench::TimeNs(1, [&] {
+            reader.ReadAll(paths, [](size_t, std::vector<uint8_t>&, const std::string&) {});
+        }));
+        C3Bench::Report("BatchRead", "ReadAll, " + name + " peak files in flight", reader.GetStats().peakInFlight, "");
+
+        std::vector<C3Model> models;
+        size_t loaded = 0;
+        C3Bench::EvictFromPageCache(paths);
+        report("LoadModels, " + name, C3Bench::TimeNs(1, [&] { loaded = reader.LoadModels(paths, models); }));
+        C3Bench::Report("BatchRead", "LoadModels, " + name + " models parsed", double(loaded), "");
+    }
+
+    // Baseline: C3Model::LoadFromFile one model at a time
+    C3Bench::EvictFromPageCache(paths);
+    report("Sequential LoadFromFile", C3Bench::TimeNs(1, [&] {
+        for (const auto& path : paths) {
+            C3Model model;
+            C3Bench::Consume(model.LoadFromFile(path));
+        }
+    }));
+}
@@ -0,0 +1,100 @@
+#include "C3Bench.h"
+#include "Core/C3WdfArchive.h"
+#include "Core/C3WdzArchive.h"
+#include "Export/C3ArchivePacker.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+C3_BENCHMARK(ArchiveCompression) {
+    const std::string corpus = ctx.workDir + "/corpus";
+    std::filesystem::remove_all(corpus);
+    if (!C3Bench::WriteMeshCorpus(corpus, 2000)) {
+        printf("ArchiveCompression: failed to write corpus\n");
+        return;
+    }
+
+    C3ArchivePacker packer;
+    packer.AddDirectory(corpus + "/c3", "c3/");
+    C3ArchivePacker::Options options;
+    options.format = C3ArchivePacker::Format::WDF;
+    if (!packer.Write(ctx.workDir + "/c3.wdf", options)) {
+        printf("ArchiveCompression: %s\n", packer.GetLastError().c_str());
+        return;
+    }
+    options.format = C3ArchivePacker::Format::WDZ;
+    if (!packer.Write(ctx.workDir + "/c3.wdz", options)) {
+        printf("ArchiveCompression: %s\n", packer.GetLastError().c_str());
+        return;
+    }
+    C3Bench::Report("ArchiveCompression", "WDZ pack time", packer.GetStats().writeMs, "ms");
+
+    C3WdfArchive wdf;
+    C3WdzArchive wdz;
+    if (!wdf.Open(ctx.workDir + "/c3.wdf") || !wdz.Open(ctx.workDir + "/c3.wdz")) {
+        printf("ArchiveCompression: failed to reopen archives\n");
+        return;
+    }
+    C3Bench::Report("ArchiveCompression", "compression ratio (stored/raw)",
+        double(wdz.GetStoredBytes()) / double(wdz.GetRawBytes()), "");
+
+    const uint64_t rawBytes = wdz.GetRawBytes();
+    std::vector<uint8_t> buffer;
+    auto readAll = [&](const C3Archive& archive) {
+        for (size_t i = 0; i < archive.GetEntryCount(); i++) {
+            archive.ReadFile(archive.GetEntry(i).id, buffer);
+            C3Bench::Consume(buffer.empty() ? 0 : buffer[0]);
+        }
+    };
+
+    C3Bench::Report("ArchiveCompression", "WDF ReadFile", C3Bench::ThroughputMBs(rawBytes, C3Bench::TimeNs(5, [&] { readAll(wdf); })), "MB/s");
+    wdz.SetDecodeThreads(1);
+    C3Bench::Report("ArchiveCompression", "WDZ ReadFile (1 thread)", C3Bench::ThroughputMBs(rawBytes, C3Bench::TimeNs(5, [&] { readAll(wdz); })), "MB/s");
+
+    // One large file exercises the parallel block decode
+    std::vector<uint8_t> large(32u << 20);
+    for (size_t i = 0; i < large.size(); i++) large[i] = uint8_t((i * 2654435761u) >> 27) & 0x0F;
+    std::filesystem::create_directories(corpus + "/big/c3");
+    {
+        std::ofstream out(corpus + "/big/c3/large.bin", std::ios::binary);
+        out.write(reinterpret_cast<const char*>(large.data()), large.size());
+    }
+    std::filesystem::create_directories(ctx.workDir + "/big");
+    C3ArchivePacker bigPacker;
+    bigPacker.AddDirectory(corpus + "/big/c3", "c3/");
+    if (bigPacker.Write(ctx.workDir + "/big/c3.wdz", options)) {
+        C3WdzArchive big;
+        if (big.Open(ctx.workDir + "/big/c3.wdz")) {
+            uint32_t id = big.GetEntry(0).id;
+            for (unsigned threads : { 1u, 2u, 4u, 0u }) {
+                big.SetDecodeThreads(threads);
+                double ns = C3Bench::TimeNs(5, [&] { big.ReadFile(id, buffer); });
+                std::string label = "WDZ 32 MB file, " + (threads ? std::to_string(threads) : std::string("all")) + " threads";
+                C3Bench::Report("ArchiveCompression", label, C3Bench::ThroughputMBs(large.size(), ns), "MB/s");
+            }
+        }
+    }
+
+    // Random 4 KB range reads decode at most two blocks
+    std::mt19937 rng(3);
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    for (int i = 0; i < 20000; i++) {
+        auto e = wdf.GetEntry(rng() % wdf.GetEntryCount());
+        if (e.size < 4096) continue;
+        ranges.push_back({ e.id, static_cast<uint32_t>(rng() % (e.size - 4096 + 1)) });
+    }
+    uint8_t chunk[4096];
+    size_t r = 0;
+    double wdfNs = C3Bench::TimeNs(ranges.size(), [&] {
+        wdf.ReadRange(ranges[r].first, ranges[r].second, chunk, sizeof(chunk));
+        r++;
+    });
+    r = 0;
+    double wdzNs = C3Bench::TimeNs(ranges.size(), [&] {
+        wdz.ReadRange(ranges[r].first, ranges[r].second, chunk, sizeof(chunk));
+        r++;
+    });
+    C3Bench::Report("ArchiveCompression", "WDF 4 KB random ReadRange", wdfNs / 1000.0, "us/read");
+    C3Bench::Report("ArchiveCompression", "WDZ 4 KB random ReadRange", wdzNs / 1000.0, "us/read");
+}
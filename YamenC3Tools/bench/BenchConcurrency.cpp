@@ -0,0 +1,141 @@
+#include "C3Bench.h"
+#include "Core/C3WdfArchive.h"
+#include "Core/C3WdzArchive.h"
+#include "Export/C3ArchivePacker.h"
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace {
+
+constexpr size_t kFileCount = 512;
+constexpr size_t kReadsPerThread = 2000;
+
+bool WriteCorpus(const std::string& root) {
+    std::mt19937 rng(11);
+    std::filesystem::create_directories(root);
+    std::vector<uint8_t> data;
+    for (size_t i = 0; i < kFileCount; i++) {
+        // Half-entropy bytes so WDZ blocks still compress
+        data.resize(16384 + rng() % (192 * 1024));
+        for (auto& b : data) b = uint8_t(rng() & 0x0F);
+        std::ofstream out(root + "/" + std::to_string(i) + ".bin", std::ios::binary);
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+        if (!out) return false;
+    }
+    return true;
+}
+
+// The old CDnFile pattern: one FILE*, one scratch buffer, one lock
+class LegacyReader {
+public:
+    explicit LegacyReader(const std::string& path) { m_file = fopen(path.c_str(), "rb"); }
+    ~LegacyReader() { if (m_file) fclose(m_file); }
+
+    bool IsOpen() const { return m_file != nullptr; }
+
+    uint64_t Read(const C3Archive::Entry& entry) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_buffer.resize(static_cast<size_t>(entry.size));
+        fseek(m_file, static_cast<long>(entry.offset), SEEK_SET);
+        size_t read = fread(m_buffer.data(), 1, m_buffer.size(), m_file);
+        return read ? m_buffer[0] : 0;
+    }
+
+private:
+    FILE* m_file = nullptr;
+    std::mutex m_mutex;
+    std::vector<uint8_t> m_buffer;
+};
+
+// Runs 'threads' workers, each reading kReadsPerThread random entries.
+// Returns MB/s over the bytes actually read.
+template <typename ReadFn>
+double MeasureThreads(const C3Archive& archive, unsigned threads, ReadFn&& read) {
+    std::atomic<uint64_t> totalBytes{ 0 }, totalSink{ 0 };
+    double ns = C3Bench::TimeNs(1, [&] {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                std::mt19937 rng(t + 1);
+                std::vector<uint8_t> buffer;
+                uint64_t bytes = 0, sink = 0;
+                for (size_t i = 0; i < kReadsPerThread; i++) {
+                    const C3Archive::Entry& entry = archive.GetEntry(rng() % archive.GetEntryCount());
+                    sink += read(entry, buffer);
+                    bytes += entry.size;
+                }
+                totalSink += sink;
+                totalBytes += bytes;
+            });
+        }
+        for (auto& worker : workers) worker.join();
+    });
+    C3Bench::Consume(totalSink); // Consume() itself is not thread-safe
+    return C3Bench::ThroughputMBs(totalBytes, ns);
+}
+
+} // namespace
+
+C3_BENCHMARK(ArchiveConcurrency) {
+    const std::string corpus = ctx.workDir + "/concurrency";
+    std::filesystem::remove_all(corpus);
+    if (!WriteCorpus(corpus + "/c3")) {
+        printf("ArchiveConcurrency: failed to write corpus\n");
+        return;
+    }
+
+    C3ArchivePacker packer;
+    packer.AddDirectory(corpus + "/c3", "c3/");
+    C3ArchivePacker::Options options;
+    options.format = C3ArchivePacker::Format::WDF;
+    bool packed = packer.Write(corpus + "/c3.wdf", options);
+    options.format = C3ArchivePacker::Format::WDZ;
+    packed = packed && packer.Write(corpus + "/c3.wdz", options);
+    if (!packed) {
+        printf("ArchiveConcurrency: %s\n", packer.GetLastError().c_str());
+        return;
+    }
+
+    C3WdfArchive wdf;
+    C3WdzArchive wdz;
+    LegacyReader legacy(corpus + "/c3.wdf");
+    if (!wdf.Open(corpus + "/c3.wdf") || !wdz.Open(corpus + "/c3.wdz") || !legacy.IsOpen()) {
+        printf("ArchiveConcurrency: failed to reopen archives\n");
+        return;
+    }
+    wdz.SetDecodeThreads(1); // Scale across readers, not within one file
+
+    printf("ArchiveConcurrency: %u hardware threads\n", std::thread::hardware_concurrency());
+    for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+        std::string suffix = " (" + std::to_string(threads) + (threads == 1 ? " thread)" : " threads)");
+
+        double mapped = MeasureThreads(wdf, threads, [&](const C3Archive::Entry& entry, std::vector<uint8_t>&) -> uint64_t {
+            // Touches one byte per page, so this measures mapping faults rather than copies
+            auto view = wdf.GetData(entry.id);
+            uint64_t sum = 0;
+            for (size_t i = 0; i < view.size(); i += 4096) sum += view[i];
+            return sum;
+        });
+        double positional = MeasureThreads(wdf, threads, [&](const C3Archive::Entry& entry, std::vector<uint8_t>& buffer) -> uint64_t {
+            wdf.ReadFile(entry.id, buffer);
+            return buffer.empty() ? 0 : buffer[0];
+        });
+        double compressed = MeasureThreads(wdz, threads, [&](const C3Archive::Entry& entry, std::vector<uint8_t>& buffer) -> uint64_t {
+            wdz.ReadFile(entry.id, buffer);
+            return buffer.empty() ? 0 : buffer[0];
+        });
+        double locked = MeasureThreads(wdf, threads, [&](const C3Archive::Entry& entry, std::vector<uint8_t>&) -> uint64_t {
+            return legacy.Read(entry);
+        });
+
+        C3Bench::Report("ArchiveConcurrency", "WDF GetData" + suffix, mapped, "MB/s");
+        C3Bench::Report("ArchiveConcurrency", "WDF ReadFile" + suffix, positional, "MB/s");
+        C3Bench::Report("ArchiveConcurrency", "WDZ ReadFile" + suffix, compressed, "MB/s");
+        C3Bench::Report("ArchiveConcurrency", "Locked fseek/fread" + suffix, locked, "MB/s");
+    }
+}
@@ -0,0 +1,181 @@
+#include "C3Bench.h"
+#include "Core/C3DedupStore.h"
+#include "Core/C3DuplicateScanner.h"
+#include "Core/C3Model.h"
+#include "Core/C3VirtualFileSystem.h"
+#include "Core/C3WdfArchive.h"
+#include "Export/C3ArchivePacker.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+
+namespace {
+
+constexpr size_t kUniqueCount = 500;
+constexpr size_t kRecolorSets = 3;     // Identical copies of the first half under new names
+constexpr size_t kVariantCount = 100;  // Same PHY chunk, different file header
+constexpr size_t kReskinCount = 100;   // Same geometry, different texture name
+
+// The corpus generator repeats grid sizes; nudging the low mantissa bits of
+// the first vertex makes every file distinct without changing its shape
+bool MakeDistinct(const std::string& path, uint32_t salt) {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    uint32_t nameLen = 0;
+    file.seekg(sizeof(C3FileHeader) + 4);
+    file.read(reinterpret_cast<char*>(&nameLen), 4);
+    if (!file || nameLen >= 256) return false;
+    file.seekp(sizeof(C3FileHeader) + 8 + nameLen + 12);
+    uint16_t bits = static_cast<uint16_t>(salt);
+    file.write(reinterpret_cast<const char*>(&bits), sizeof(bits));
+    return bool(file);
+}
+
+// Lays out unique meshes plus the kinds of repeats real archives carry
+bool WriteDuplicatedCorpus(const std::string& root, std::vector<std::string>& paths) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> unique;
+    if (!C3Bench::WriteMeshCorpus(root + "/base", kUniqueCount, 48, &unique)) return false;
+    for (size_t i = 0; i < unique.size(); i++) {
+        if (!MakeDistinct(unique[i], static_cast<uint32_t>(i))) return false;
+    }
+
+    std::error_code ec;
+    fs::create_directories(root + "/pack", ec);
+    fs::copy(root + "/base/c3", root + "/pack/c3", fs::copy_options::recursive, ec);
+    if (ec) return false;
+    for (size_t i = 0; i < kUniqueCount; i++) paths.push_back("c3/mesh" + std::to_string(i % 16) + "/" + std::to_string(i) + ".c3");
+
+    for (size_t set = 0; set < kRecolorSets; set++) {
+        const std::string dir = "c3/recolor" + std::to_string(set);
+        fs::create_directories(root + "/pack/" + dir, ec);
+        for (size_t i = 0; i < kUniqueCount / 2; i++) {
+            const std::string path = dir + "/" + std::to_string(i) + ".c3";
+            fs::copy_file(unique[i], root + "/pack/" + path, fs::copy_options::overwrite_existing, ec);
+            paths.push_back(path);
+        }
+    }
+
+    fs::create_directories(root + "/pack/c3/variant", ec);
+    for (size_t i = 0; i < kVariantCount; i++) {
+        std::ifstream in(unique[kUniqueCount - 1 - i], std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (bytes.size() < 16) return false;
+        bytes[15] ^= 0x01; // Past the "MAXFILE C3" the loader checks
+        const std::string path = "c3/variant/" + std::to_string(i) + ".c3";
+        std::ofstream out(root + "/pack/" + path, std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        paths.push_back(path);
+    }
+
+    // The corpus ends each PHY chunk with an empty texture name; give it one
+    fs::create_directories(root + "/pack/c3/reskin", ec);
+    for (size_t i = 0; i < kReskinCount; i++) {
+        std::ifstream in(unique[i], std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (bytes.size() < sizeof(C3FileHeader) + 8) return false;
+        const std::string texture = "reskin" + std::to_string(i) + ".dds";
+        const uint32_t textureLen = static_cast<uint32_t>(texture.size());
+        bytes.resize(bytes.size() - 4);
+        bytes.insert(bytes.end(), reinterpret_cast<const char*>(&textureLen), reinterpret_cast<const char*>(&textureLen) + 4);
+        bytes.insert(bytes.end(), texture.begin(), texture.end());
+        uint32_t chunkSize = 0;
+        memcpy(&chunkSize, bytes.data() + sizeof(C3FileHeader), 4);
+        chunkSize += textureLen;
+        memcpy(bytes.data() + sizeof(C3FileHeader), &chunkSize, 4);
+        const std::string path = "c3/reskin/" + std::to_string(i) + ".c3";
+        std::ofstream out(root + "/pack/" + path, std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        paths.push_back(path);
+    }
+    return !ec;
+}
+
+} // namespace
+
+C3_BENCHMARK(Dedup) {
+    const std::string corpus = ctx.workDir + "/dedup";
+    std::filesystem::remove_all(corpus);
+    std::vector<std::string> paths;
+    if (!WriteDuplicatedCorpus(corpus, paths)) {
+        printf("Dedup: failed to write corpus\n");
+        return;
+    }
+
+    C3ArchivePacker packer;
+    packer.AddDirectory(corpus + "/pack/c3", "c3/");
+    C3ArchivePacker::Options options;
+    if (!packer.Write(corpus + "/c3.wdf", options)) {
+        printf("Dedup: %s\n", packer.GetLastError().c_str());
+        return;
+    }
+    C3WdfArchive archive;
+    if (!archive.Open(corpus + "/c3.wdf")) {
+        printf("Dedup: %s\n", archive.GetLastError().c_str());
+        return;
+    }
+
+    C3DuplicateScanner scanner;
+    if (!scanner.Scan({ &archive })) {
+        printf("Dedup: %s\n", scanner.GetLastError().c_str());
+        return;
+    }
+    const auto& report = scanner.GetReports().front();
+    C3Bench::Report("Dedup", "scan", C3Bench::ThroughputMBs(report.bytes, scanner.GetElapsedMs() * 1e6), "MB/s");
+    C3Bench::Report("Dedup", "duplicate file bytes", double(report.duplicateBytes) / report.bytes * 100.0, "%");
+    C3Bench::Report("Dedup", "repeated chunk bytes", double(report.chunkDuplicateBytes) / report.bytes * 100.0, "%");
+    C3Bench::Report("Dedup", "duplicate groups", double(report.groups.size()), "");
+    printf("%s", scanner.FormatReport(3).c_str());
+
+    // Every path loaded and kept, as a scene holding all of them would
+    C3VirtualFileSystem vfs;
+    vfs.MountArchive(corpus + "/c3.wdf");
+    size_t plainBytes = 0;
+    double plainNs = C3Bench::TimeNs(1, [&] {
+        std::vector<std::shared_ptr<const C3Model>> models;
+        C3VirtualFileSystem::FileData file;
+        for (const auto& path : paths) {
+            auto model = std::make_shared<C3Model>();
+            if (vfs.Open(path, file) && model->LoadFromMemory(file.Data(), file.Size())) models.push_back(model);
+        }
+        for (const auto& model : models) plainBytes += model->GetMemoryUsage();
+    });
+
+    size_t internedBytes = 0;
+    C3DedupStore store;
+    double internedNs = C3Bench::TimeNs(1, [&] {
+        std::vector<std::shared_ptr<const C3Model>> models;
+        C3VirtualFileSystem::FileData file;
+        for (const auto& path : paths) {
+            if (vfs.Open(path, file)) {
+                if (auto model = store.InternModel({ file.Data(), file.Size() })) models.push_back(model);
+            }
+        }
+        // GetMemoryUsage counts shared geometry in every model; count each buffer once
+        std::unordered_set<const C3Model*> distinct;
+        std::unordered_set<const void*> buffers;
+        auto countOnce = [&](const auto& buffer) {
+            if (!buffer.empty() && !buffers.insert(buffer.data()).second) {
+                internedBytes -= buffer.capacity() * sizeof(buffer[0]);
+            }
+        };
+        for (const auto& model : models) {
+            if (!distinct.insert(model.get()).second) continue;
+            internedBytes += model->GetMemoryUsage();
+            for (const auto& mesh : model->GetMeshes()) {
+                countOnce(mesh.vertices);
+                countOnce(mesh.normalIndices);
+                countOnce(mesh.alphaIndices);
+            }
+        }
+    });
+    C3Bench::Report("Dedup", "load all, parse each", plainNs / 1e6, "ms");
+    C3Bench::Report("Dedup", "load all, interned", internedNs / 1e6, "ms");
+    C3Bench::Report("Dedup", "resident, parse each", plainBytes / (1024.0 * 1024.0), "MB");
+    C3Bench::Report("Dedup", "resident, interned", internedBytes / (1024.0 * 1024.0), "MB");
+    const C3DedupStore::Stats stats = store.GetStats();
+    C3Bench::Report("Dedup", "interned lookups shared", double(stats.shared), "");
+    C3Bench::Report("Dedup", "geometry buffers shared", double(stats.sharedBuffers), "");
+    C3Bench::Report("Dedup", "geometry bytes shared", stats.sharedBufferBytes / (1024.0 * 1024.0), "MB");
+}
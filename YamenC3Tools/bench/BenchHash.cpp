@@ -0,0 +1,86 @@
+#include "C3Bench.h"
+#include "Core/C3HashSystem.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace {
+
+// The previous RealName: a heap string for the normalized path, then a
+// bounded copy into the hash's stack buffer
+uint32_t LegacyRealName(const char* path) {
+    std::string normalized;
+    normalized.reserve(256);
+    for (int i = 0; path[i]; i++) {
+        char ch = path[i];
+        if (ch >= 'A' && ch <= 'Z') normalized += static_cast<char>(ch - 'A' + 'a');
+        else if (ch == '\\') normalized += '/';
+        else normalized += ch;
+    }
+    char buffer[280] = {};
+    strncpy(buffer, normalized.c_str(), 256);
+    return C3HashSystem::StringToID(buffer);
+}
+
+std::vector<std::string> BuildPaths(size_t count) {
+    static const char* const kDirs[] = { "c3/mesh/", "C3\\Effect\\", "data/map/puzzle/", "ini/", "c3/texture/" };
+    std::mt19937 rng(11);
+    std::vector<std::string> paths;
+    paths.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        std::string path = kDirs[rng() % 5];
+        path += std::to_string(rng() % 100000);
+        path += (i & 1) ? ".C3" : ".dds";
+        paths.push_back(std::move(path));
+    }
+    return paths;
+}
+
+template <typename Fn>
+void ReportCalls(const std::string& metric, const std::vector<std::string>& paths, Fn&& fn) {
+    constexpr size_t kRounds = 20;
+    double ns = C3Bench::TimeNs(kRounds, [&] {
+        uint64_t sum = 0;
+        for (const auto& path : paths) sum += fn(path);
+        C3Bench::Consume(sum);
+    });
+    C3Bench::Report("Hash", metric, ns > 0 ? double(paths.size()) * 1e3 / ns : 0.0, "Mcalls/s");
+}
+
+} // namespace
+
+C3_BENCHMARK(Hash) {
+    (void)ctx;
+    const std::vector<std::string> paths = BuildPaths(100000);
+
+    ReportCalls("RealName, legacy std::string + copy", paths, [](const std::string& p) { return LegacyRealName(p.c_str()); });
+    ReportCalls("RealName(const char*)", paths, [](const std::string& p) { return C3HashSystem::RealName(p.c_str()); });
+    ReportCalls("RealName(string_view)", paths, [](const std::string& p) { return C3HashSystem::RealName(std::string_view(p)); });
+    ReportCalls("PackName(string_view)", paths, [](const std::string& p) { return C3HashSystem::PackName(std::string_view(p)); });
+    ReportCalls("StringToID(string_view)", paths, [](const std::string& p) { return C3HashSystem::StringToID(std::string_view(p)); });
+    ReportCalls("DnpRealName(string_view)", paths, [](const std::string& p) { return C3HashSystem::DnpRealName(std::string_view(p)); });
+    ReportCalls("DnpPackName(string_view)", paths, [](const std::string& p) { return C3HashSystem::DnpPackName(std::string_view(p)); });
+
+    // Interleaved lanes against the same strings one at a time
+    const std::vector<std::string_view> views(paths.begin(), paths.end());
+    std::vector<uint32_t> ids(views.size());
+    auto reportBatch = [&](const std::string& metric, void (*batch)(std::span<const std::string_view>, std::span<uint32_t>)) {
+        constexpr size_t kRounds = 20;
+        double ns = C3Bench::TimeNs(kRounds, [&] {
+            batch(views, ids);
+            C3Bench::Consume(ids[0]);
+        });
+        C3Bench::Report("Hash", metric, ns > 0 ? double(views.size()) * 1e3 / ns : 0.0, "Mcalls/s");
+    };
+    reportBatch("StringToIDBatch", C3HashSystem::StringToIDBatch);
+    reportBatch("RealNameBatch", C3HashSystem::RealNameBatch);
+    reportBatch("DnpRealNameBatch", C3HashSystem::DnpRealNameBatch);
+
+    size_t mismatches = 0;
+    C3HashSystem::RealNameBatch(views, ids);
+    for (size_t i = 0; i < paths.size(); i++) {
+        mismatches += LegacyRealName(paths[i].c_str()) != C3HashSystem::RealName(paths[i]);
+        mismatches += ids[i] != C3HashSystem::RealName(views[i]);
+    }
+    if (mismatches) printf("Hash: %zu ids differ from the scalar or legacy RealName\n", mismatches);
+}
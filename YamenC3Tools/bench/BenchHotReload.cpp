@@ -0,0 +1,202 @@
+#include "C3Bench.h"
+#include "Core/C3AssetCache.h"
+#include "Core/C3HotReloader.h"
+#include "Core/C3Model.h"
+#include "Core/C3VirtualFileSystem.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace {
+
+constexpr size_t kFileCount = 200;
+constexpr size_t kEdits = 40;
+constexpr size_t kBurstWrites = 20;
+constexpr unsigned kDebounceMs = 20;
+
+std::vector<uint8_t> ReadBytes(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+// Saves in two halves, as an editor flushing a large file would
+void WriteBytes(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const size_t half = bytes.size() / 2;
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(half));
+    out.flush();
+    out.write(reinterpret_cast<const char*>(bytes.data() + half), static_cast<std::streamsize>(bytes.size() - half));
+}
+
+class ChangeRecorder : public C3HotReloader::Listener {
+public:
+    void OnAssetChanged(const C3HotReloader::Change&) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_count++;
+        m_last = std::chrono::steady_clock::now();
+        m_changed.notify_all();
+    }
+
+    // Time of the first notification after 'count' of them had arrived
+    bool WaitBeyond(size_t count, std::chrono::steady_clock::time_point& at) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_changed.wait_for(lock, std::chrono::seconds(5), [&] { return m_count > count; })) return false;
+        at = m_last;
+        return true;
+    }
+
+    size_t GetCount() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_count;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    size_t m_count = 0;
+    std::chrono::steady_clock::time_point m_last;
+};
+
+// Lookups per second from four reader threads while 'during' runs
+template <typename Fn>
+double LookupRate(C3AssetCache& cache, const std::vector<std::string>& paths, Fn&& during) {
+    std::vector<C3AssetCache::Key> keys;
+    for (const auto& path : paths) keys.push_back(C3AssetCache::KeyForPath(path));
+    std::atomic<bool> stop{ false };
+    std::atomic<uint64_t> lookups{ 0 };
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&, t] {
+            std::mt19937 rng(t);
+            uint64_t count = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (auto model = cache.GetModel(keys[rng() % keys.size()])) C3Bench::Consume(model->GetMeshes().size());
+                count++;
+            }
+            lookups += count;
+        });
+    }
+    double ns = C3Bench::TimeNs(1, during);
+    stop = true;
+    for (auto& reader : readers) reader.join();
+    return lookups.load() / (ns * 1e-9) / 1e6;
+}
+
+} // namespace
+
+C3_BENCHMARK(HotReload) {
+    const std::string corpus = ctx.workDir + "/hotreload";
+    std::filesystem::remove_all(corpus);
+    std::vector<std::string> files;
+    if (!C3Bench::WriteMeshCorpus(corpus, kFileCount, 32, &files)) {
+        printf("HotReload: failed to write corpus\n");
+        return;
+    }
+    std::vector<std::vector<uint8_t>> contents;
+    for (const auto& path : files) contents.push_back(ReadBytes(path));
+    std::vector<std::string> virtualPaths;
+    for (const auto& path : files) {
+        virtualPaths.push_back(std::filesystem::relative(path, corpus).generic_string());
+    }
+
+    C3VirtualFileSystem vfs;
+    vfs.AddDirectory(corpus);
+
+    for (bool inotify : { true, false }) {
+        C3AssetCache cache(SIZE_MAX);
+        for (const auto& path : virtualPaths) cache.LoadModel(vfs, path);
+
+        C3HotReloader::Options options;
+        options.debounceMs = kDebounceMs;
+        options.pollIntervalMs = 20;
+        options.allowInotify = inotify;
+        C3HotReloader reloader(options);
+        ChangeRecorder recorder;
+        reloader.Watch(corpus);
+        reloader.AddCache(&cache);
+        reloader.SetFileSystem(&vfs);
+        reloader.AddListener(&recorder);
+        if (!reloader.Start()) {
+            printf("HotReload: %s\n", reloader.GetLastError().c_str());
+            return;
+        }
+        const std::string backend = C3HotReloader::GetBackendName(reloader.GetBackend());
+
+        // One save at a time, from the write to the listener seeing the new model
+        const C3AssetCache::Key firstKey = C3AssetCache::KeyForPath(virtualPaths[0]);
+        std::shared_ptr<const C3Model> held = cache.GetModel(firstKey);
+        double totalMs = 0.0;
+        size_t measured = 0;
+        for (size_t i = 0; i < kEdits; i++) {
+            const size_t before = recorder.GetCount();
+            auto start = std::chrono::steady_clock::now();
+            WriteBytes(files[i], contents[(i + 1) % kFileCount]);
+            std::chrono::steady_clock::time_point done;
+            if (!recorder.WaitBeyond(before, done)) break;
+            totalMs += std::chrono::duration<double, std::milli>(done - start).count();
+            measured++;
+        }
+        if (measured) C3Bench::Report("HotReload", backend + ", save to swap", totalMs / measured, "ms");
+
+        // Readers holding the old version keep it; new lookups see the swap
+        std::shared_ptr<const C3Model> current = cache.GetModel(firstKey);
+        if (!held || held->GetMeshes().empty() || !current || current == held) {
+            printf("HotReload: %s did not swap %s\n", backend.c_str(), virtualPaths[0].c_str());
+        }
+
+        // A file created after startup stops being a cached miss, and goes away again with it
+        const std::string created = "created_" + backend + ".c3";
+        std::vector<uint8_t> probe;
+        vfs.ReadFile(created, probe);
+        size_t before = recorder.GetCount();
+        WriteBytes(corpus + "/" + created, contents[0]);
+        std::chrono::steady_clock::time_point seen;
+        if (!recorder.WaitBeyond(before, seen) || !vfs.ReadFile(created, probe) || probe != contents[0]) {
+            printf("HotReload: %s did not register %s\n", backend.c_str(), created.c_str());
+        }
+        before = recorder.GetCount();
+        std::filesystem::remove(corpus + "/" + created);
+        if (!recorder.WaitBeyond(before, seen) || vfs.Exists(created)) {
+            printf("HotReload: %s did not unregister %s\n", backend.c_str(), created.c_str());
+        }
+
+        // A burst of saves to one file settles into one reload
+        const size_t burstBefore = recorder.GetCount();
+        for (size_t i = 0; i < kBurstWrites; i++) WriteBytes(files[kEdits], contents[i]);
+        std::chrono::steady_clock::time_point settled;
+        recorder.WaitBeyond(burstBefore, settled);
+        std::this_thread::sleep_for(std::chrono::milliseconds(kDebounceMs * 4 + options.pollIntervalMs));
+        C3Bench::Report("HotReload", backend + ", reloads per " + std::to_string(kBurstWrites) + "-write burst",
+            double(recorder.GetCount() - burstBefore), "");
+
+        // Lookups while every file is rewritten at once, against the same readers idle
+        std::chrono::steady_clock::time_point stormStart, stormEnd;
+        const double idleRate = LookupRate(cache, virtualPaths, [] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        });
+        const double stormRate = LookupRate(cache, virtualPaths, [&] {
+            const size_t before = recorder.GetCount();
+            stormStart = std::chrono::steady_clock::now();
+            stormEnd = stormStart;
+            for (size_t i = 0; i < kFileCount; i++) WriteBytes(files[i], contents[(i + 7) % kFileCount]);
+            while (recorder.GetCount() < before + kFileCount && recorder.WaitBeyond(recorder.GetCount(), stormEnd)) {}
+        });
+        C3Bench::Report("HotReload", backend + ", rewrite all to last swap",
+            std::chrono::duration<double, std::milli>(stormEnd - stormStart).count(), "ms");
+        C3Bench::Report("HotReload", backend + ", lookups idle", idleRate, "M/s");
+        C3Bench::Report("HotReload", backend + ", lookups during storm", stormRate, "M/s");
+
+        reloader.Stop();
+        const C3HotReloader::Stats stats = reloader.GetStats();
+        C3Bench::Report("HotReload", backend + ", events per reload",
+            stats.reloaded ? double(stats.events) / double(stats.reloaded) : 0.0, "");
+        if (stats.failed) printf("HotReload: %s, %llu reloads failed\n", backend.c_str(), (unsigned long long)stats.failed);
+
+        for (size_t i = 0; i < kFileCount; i++) WriteBytes(files[i], contents[i]);
+    }
+}
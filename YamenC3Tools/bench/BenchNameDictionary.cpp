@@ -0,0 +1,85 @@
+#include "C3Bench.h"
+#include "Core/C3HashSystem.h"
+#include "Core/C3NameDictionary.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace {
+
+// Client-like layout: a few top-level packs, nested directories, numbered assets
+std::vector<std::string> BuildPathList(size_t count) {
+    static const char* const kRoots[] = { "c3/mesh/", "c3/texture/", "c3/effect/", "data/map/puzzle/", "ani/" };
+    static const char* const kExtensions[] = { ".c3", ".dds", ".ani", ".tga" };
+    std::mt19937 rng(21);
+    std::vector<std::string> paths;
+    paths.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        std::string path = kRoots[rng() % 5];
+        path += std::to_string(rng() % 400) + "/";
+        path += std::to_string(i) + kExtensions[rng() % 4];
+        paths.push_back(std::move(path));
+    }
+    return paths;
+}
+
+} // namespace
+
+C3_BENCHMARK(NameDictionary) {
+    const std::string dir = ctx.workDir + "/names";
+    std::filesystem::create_directories(dir);
+    constexpr size_t kPathCount = 1000000;
+    const std::vector<std::string> paths = BuildPathList(kPathCount);
+
+    size_t rawBytes = 0;
+    {
+        std::ofstream list(dir + "/paths.txt");
+        for (const auto& path : paths) {
+            list << path << '\n';
+            rawBytes += path.size() + 1;
+        }
+    }
+
+    C3NameDictionary built;
+    double buildNs = C3Bench::TimeNs(1, [&] { built.BuildFromList(dir + "/paths.txt", C3NameDictionary::Scheme::Wdf); });
+    if (!built.IsLoaded() || !built.Save(dir + "/paths.c3nd")) {
+        printf("NameDictionary: %s\n", built.GetLastError().c_str());
+        return;
+    }
+    C3Bench::Report("NameDictionary", "build from 1M-line list", buildNs / 1e6, "ms");
+    C3Bench::Report("NameDictionary", "path list size", rawBytes / (1024.0 * 1024.0), "MB");
+    C3Bench::Report("NameDictionary", "dictionary size", built.GetStorageSize() / (1024.0 * 1024.0), "MB");
+
+    C3NameDictionary dictionary;
+    double loadNs = C3Bench::TimeNs(1, [&] { dictionary.Load(dir + "/paths.c3nd"); });
+    if (!dictionary.IsLoaded()) {
+        printf("NameDictionary: %s\n", dictionary.GetLastError().c_str());
+        return;
+    }
+    C3Bench::Report("NameDictionary", "load (map + validate)", loadNs / 1e6, "ms");
+
+    std::vector<uint32_t> ids(paths.size());
+    std::vector<std::string_view> views(paths.begin(), paths.end());
+    C3HashSystem::RealNameBatch(views, ids);
+
+    std::mt19937 rng(4);
+    std::vector<uint32_t> probes(200000);
+    for (auto& id : probes) id = ids[rng() % ids.size()];
+    double lookupNs = C3Bench::TimeNs(1, [&] {
+        std::string path;
+        uint64_t found = 0;
+        for (uint32_t id : probes) found += dictionary.Lookup(id, path);
+        C3Bench::Consume(found);
+    });
+    C3Bench::Report("NameDictionary", "lookup", lookupNs / probes.size(), "ns");
+
+    // Every id must give back its own path (or a colliding one with the same id)
+    size_t wrong = 0;
+    for (size_t i = 0; i < paths.size(); i += 97) {
+        bool matched = false;
+        for (const auto& path : dictionary.LookupAll(ids[i])) matched |= path == paths[i];
+        wrong += !matched;
+    }
+    if (wrong) printf("NameDictionary: %zu paths not recovered\n", wrong);
+}
@@ -0,0 +1,134 @@
+#include "C3Bench.h"
+#include "Core/C3DnpArchive.h"
+#include "Core/C3PerfectHash.h"
+#include "Core/C3WdfArchive.h"
+#include "Export/C3ArchivePacker.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <unordered_set>
+
+namespace {
+
+std::vector<uint32_t> DistinctIds(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::unordered_set<uint32_t> seen;
+    std::vector<uint32_t> ids;
+    ids.reserve(count);
+    while (ids.size() < count) {
+        uint32_t id = rng();
+        if (seen.insert(id).second) ids.push_back(id);
+    }
+    return ids;
+}
+
+// Find() over every id plus as many absent ones, before and after the sidecar is loaded
+template <typename Archive>
+void RunArchive(const char* label, const std::string& path) {
+    const std::string name = label;
+    Archive archive;
+    if (!archive.Open(path)) {
+        printf("PerfectHash: %s\n", archive.GetLastError().c_str());
+        return;
+    }
+    std::vector<uint32_t> probes;
+    for (size_t i = 0; i < archive.GetEntryCount(); i++) probes.push_back(archive.GetEntry(i).id);
+    for (uint32_t id : DistinctIds(probes.size(), 9)) probes.push_back(id);
+    std::shuffle(probes.begin(), probes.end(), std::mt19937(3));
+
+    auto findAll = [&](std::vector<uint64_t>& offsets) {
+        offsets.clear();
+        C3Archive::Entry entry;
+        for (uint32_t id : probes) offsets.push_back(archive.Find(id, entry) ? entry.offset : UINT64_MAX);
+    };
+    std::vector<uint64_t> expected;
+    std::vector<uint64_t> actual;
+    constexpr size_t kRounds = 50;
+    double searchNs = C3Bench::TimeNs(kRounds, [&] { findAll(expected); });
+
+    const std::string sidecar = C3Archive::GetPerfectHashPath(archive);
+    if (!archive.WritePerfectHash(sidecar)) {
+        printf("PerfectHash: %s\n", archive.GetLastError().c_str());
+        return;
+    }
+    archive.DropPerfectHash();
+    if (!archive.LoadPerfectHash(sidecar)) {
+        printf("PerfectHash: %s\n", archive.GetLastError().c_str());
+        return;
+    }
+    double hashNs = C3Bench::TimeNs(kRounds, [&] { findAll(actual); });
+
+    C3Bench::Report("PerfectHash", name + " Find, built-in search", searchNs / probes.size(), "ns");
+    C3Bench::Report("PerfectHash", name + " Find, perfect hash", hashNs / probes.size(), "ns");
+    if (actual != expected) printf("PerfectHash: %s lookups differ from the built-in search\n", label);
+}
+
+} // namespace
+
+C3_BENCHMARK(PerfectHash) {
+    // The hash itself over a large id set, against a binary search
+    for (size_t count : { size_t(10000), size_t(1000000) }) {
+        const std::vector<uint32_t> ids = DistinctIds(count, 1);
+        C3PerfectHash hash;
+        if (!hash.Build(ids)) {
+            printf("PerfectHash: %s\n", hash.GetLastError().c_str());
+            return;
+        }
+        const C3PerfectHash::Stats& stats = hash.GetStats();
+        const std::string label = std::to_string(count) + " ids";
+        C3Bench::Report("PerfectHash", label + " build", stats.buildMs, "ms");
+        C3Bench::Report("PerfectHash", label + " pilot trials per id", double(stats.pilotTrials) / count, "");
+        C3Bench::Report("PerfectHash", label + " max pilot", double(stats.maxPilot), "");
+        C3Bench::Report("PerfectHash", label + " pilot bits per id", stats.bitsPerKey, "bits");
+        C3Bench::Report("PerfectHash", label + " seeds tried", double(stats.seedAttempts), "");
+
+        std::vector<uint32_t> sorted = ids;
+        std::sort(sorted.begin(), sorted.end());
+        std::vector<uint32_t> probes(1000000);
+        std::mt19937 rng(2);
+        for (auto& id : probes) id = ids[rng() % ids.size()];
+
+        size_t wrong = 0;
+        double hashNs = C3Bench::TimeNs(1, [&] {
+            for (uint32_t id : probes) wrong += ids[hash.Lookup(id)] != id;
+        });
+        double searchNs = C3Bench::TimeNs(1, [&] {
+            uint64_t sum = 0;
+            for (uint32_t id : probes) sum += std::lower_bound(sorted.begin(), sorted.end(), id) - sorted.begin();
+            C3Bench::Consume(sum);
+        });
+        C3Bench::Report("PerfectHash", label + " lookup, binary search", searchNs / probes.size(), "ns");
+        C3Bench::Report("PerfectHash", label + " lookup, perfect hash", hashNs / probes.size(), "ns");
+        if (wrong) printf("PerfectHash: %zu ids mapped to the wrong position\n", wrong);
+    }
+
+    const std::string corpus = ctx.workDir + "/perfecthash";
+    std::filesystem::remove_all(corpus);
+    if (!C3Bench::WriteMeshCorpus(corpus, 3000, 8)) {
+        printf("PerfectHash: failed to write corpus\n");
+        return;
+    }
+    C3ArchivePacker packer;
+    packer.AddDirectory(corpus + "/c3", "c3/");
+    C3ArchivePacker::Options options;
+    options.format = C3ArchivePacker::Format::WDF;
+    bool packed = packer.Write(corpus + "/c3.wdf", options);
+    options.format = C3ArchivePacker::Format::DNP;
+    packed = packed && packer.Write(corpus + "/c3.dnp", options);
+    if (!packed) {
+        printf("PerfectHash: %s\n", packer.GetLastError().c_str());
+        return;
+    }
+    RunArchive<C3WdfArchive>("WDF", corpus + "/c3.wdf");
+
+    // A sidecar must not attach to an archive with other contents
+    C3DnpArchive dnp;
+    C3WdfArchive wdf;
+    if (!dnp.Open(corpus + "/c3.dnp") || !dnp.WritePerfectHash(corpus + "/c3.dnp.c3mph") || !wdf.Open(corpus + "/c3.wdf")) {
+        printf("PerfectHash: %s\n", dnp.GetLastError().c_str());
+    }
+    else if (wdf.LoadPerfectHash(corpus + "/c3.dnp.c3mph")) {
+        printf("PerfectHash: sidecar accepted for the wrong archive\n");
+    }
+}
@@ -0,0 +1,109 @@
+#include "C3Bench.h"
+#include "Core/C3AccessTrace.h"
+#include "Core/C3Model.h"
+#include "Core/C3Prefetcher.h"
+#include "Export/C3ArchivePacker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+namespace {
+
+// A replay touches "characters": runs of consecutive meshes, popular ones more often
+std::vector<std::string> BuildReplay(size_t fileCount, size_t accesses) {
+    constexpr size_t kPartsPerCharacter = 6;
+    const size_t characters = fileCount / kPartsPerCharacter;
+    std::mt19937 rng(5);
+    std::vector<std::string> replay;
+    while (replay.size() < accesses) {
+        size_t character = std::min(characters - 1, size_t(std::pow(double(rng() % 10000) / 10000.0, 2.0) * characters));
+        for (size_t part = 0; part < kPartsPerCharacter; part++) {
+            size_t i = character * kPartsPerCharacter + part;
+            replay.push_back("c3/mesh" + std::to_string(i % 16) + "/" + std::to_string(i) + ".c3");
+        }
+    }
+    return replay;
+}
+
+double RunReplay(C3VirtualFileSystem& vfs, const std::vector<std::string>& replay) {
+    return C3Bench::TimeNs(1, [&] {
+        C3VirtualFileSystem::FileData file;
+        for (const auto& path : replay) {
+            C3Model model;
+            if (vfs.Open(path, file)) C3Bench::Consume(model.LoadFromMemory(file.Data(), file.Size()));
+        }
+    });
+}
+
+} // namespace
+
+C3_BENCHMARK(Prefetch) {
+    const std::string corpus = ctx.workDir + "/prefetch";
+    std::filesystem::remove_all(corpus);
+    constexpr size_t kFileCount = 3000;
+    if (!C3Bench::WriteMeshCorpus(corpus, kFileCount, 48)) {
+        printf("Prefetch: failed to write corpus\n");
+        return;
+    }
+
+    C3ArchivePacker packer;
+    packer.AddDirectory(corpus + "/c3", "c3/");
+    C3ArchivePacker::Options options;
+    options.format = C3ArchivePacker::Format::WDF;
+    const std::string archivePath = corpus + "/c3.wdf";
+    if (!packer.Write(archivePath, options)) {
+        printf("Prefetch: %s\n", packer.GetLastError().c_str());
+        return;
+    }
+    const std::vector<std::string> replay = BuildReplay(kFileCount, 3000);
+
+    // Archive pages can only be dropped while nothing maps them
+    C3VirtualFileSystem vfs;
+    auto remountCold = [&] {
+        vfs.GetResolver().UnmountAll();
+        C3Bench::EvictFromPageCache({ archivePath });
+        return vfs.MountArchive(archivePath);
+    };
+
+    // Record a first run, then round-trip the trace through its file format
+    C3AccessTrace recorder;
+    if (!remountCold()) {
+        printf("Prefetch: %s\n", vfs.GetLastError().c_str());
+        return;
+    }
+    vfs.AddListener(&recorder);
+    recorder.Start();
+    RunReplay(vfs, replay);
+    recorder.Stop();
+    vfs.RemoveListener(&recorder);
+
+    C3AccessTrace trace;
+    if (!recorder.Save(corpus + "/replay.c3tr") || !trace.Load(corpus + "/replay.c3tr")) {
+        printf("Prefetch: %s\n", trace.GetLastError().c_str());
+        return;
+    }
+    C3Bench::Report("Prefetch", "trace entries", double(trace.GetEntryCount()), "");
+
+    remountCold();
+    C3Bench::Report("Prefetch", "cold replay, no prefetch", RunReplay(vfs, replay) / 1e6, "ms");
+
+    for (size_t lookahead : { 16u, 64u, 256u }) {
+        remountCold();
+        C3Prefetcher prefetcher(vfs.GetResolver(), lookahead);
+        prefetcher.SetTrace(trace.GetEntries());
+        vfs.AddListener(&prefetcher);
+        prefetcher.Start();
+        double ns = RunReplay(vfs, replay);
+        prefetcher.Stop();
+        vfs.RemoveListener(&prefetcher);
+
+        const std::string label = "cold replay, lookahead " + std::to_string(lookahead);
+        C3Prefetcher::Stats stats = prefetcher.GetStats();
+        C3Bench::Report("Prefetch", label, ns / 1e6, "ms");
+        C3Bench::Report("Prefetch", label + " hit rate", stats.HitRate() * 100.0, "%");
+        C3Bench::Report("Prefetch", label + " late", double(stats.late), "");
+        C3Bench::Report("Prefetch", label + " wasted", double(stats.wasted), "");
+    }
+}
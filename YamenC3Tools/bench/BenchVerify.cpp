@@ -0,0 +1,111 @@
+#include "C3Bench.h"
+#include "Core/C3ArchiveVerifier.h"
+#include "Core/C3DnpArchive.h"
+#include "Core/C3WdfArchive.h"
+#include "Export/C3ArchivePacker.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+// Raw sequential read of the whole file: the bandwidth the verifier aims for
+double SequentialReadMBs(const std::string& path) {
+    std::vector<char> buffer(8u << 20);
+    uint64_t total = 0;
+    double ns = C3Bench::TimeNs(1, [&] {
+        std::ifstream file(path, std::ios::binary);
+        while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0) {
+            total += static_cast<uint64_t>(file.gcount());
+            C3Bench::Consume(uint8_t(buffer[0]));
+        }
+    });
+    return C3Bench::ThroughputMBs(total, ns);
+}
+
+// Opens a fresh archive per pass: pages still mapped cannot be evicted
+template <typename Archive>
+void RunArchive(const char* label, const std::string& path) {
+    const std::string name = label;
+    C3Bench::EvictFromPageCache({ path });
+    C3Bench::Report("ArchiveVerify", name + " sequential read (cold)", SequentialReadMBs(path), "MB/s");
+
+    for (unsigned threads : { 1u, 0u }) {
+        C3ArchiveVerifier verifier;
+        C3ArchiveVerifier::Options options;
+        options.threads = threads;
+        C3Bench::EvictFromPageCache({ path });
+        Archive archive;
+        if (!archive.Open(path)) {
+            printf("ArchiveVerify: %s\n", archive.GetLastError().c_str());
+            return;
+        }
+        verifier.Verify(archive, options);
+        const std::string suffix = threads ? " verify, 1 thread (cold)" : " verify, all threads (cold)";
+        C3Bench::Report("ArchiveVerify", name + suffix, verifier.GetStats().ThroughputMBs(), "MB/s");
+        if (verifier.GetStats().problemCount) {
+            printf("ArchiveVerify: %zu problems in a clean archive\n", verifier.GetStats().problemCount);
+        }
+    }
+}
+
+} // namespace
+
+C3_BENCHMARK(ArchiveVerify) {
+    const std::string corpus = ctx.workDir + "/verify";
+    std::filesystem::remove_all(corpus);
+    if (!C3Bench::WriteMeshCorpus(corpus, 3000, 96)) {
+        printf("ArchiveVerify: failed to write corpus\n");
+        return;
+    }
+
+    C3ArchivePacker packer;
+    packer.AddDirectory(corpus + "/c3", "c3/");
+    C3ArchivePacker::Options options;
+    options.format = C3ArchivePacker::Format::WDF;
+    bool packed = packer.Write(corpus + "/c3.wdf", options);
+    options.format = C3ArchivePacker::Format::DNP;
+    packed = packed && packer.Write(corpus + "/c3.dnp", options);
+    if (!packed) {
+        printf("ArchiveVerify: %s\n", packer.GetLastError().c_str());
+        return;
+    }
+
+    RunArchive<C3WdfArchive>("WDF", corpus + "/c3.wdf");
+    RunArchive<C3DnpArchive>("DNP", corpus + "/c3.dnp");
+
+    // Sidecar round trip, then one flipped byte must be caught
+    C3WdfArchive wdf;
+    if (!wdf.Open(corpus + "/c3.wdf")) {
+        printf("ArchiveVerify: %s\n", wdf.GetLastError().c_str());
+        return;
+    }
+    C3ArchiveVerifier verifier;
+    verifier.Verify(wdf);
+    const std::string sidecar = C3ArchiveVerifier::GetSidecarPath(wdf);
+    if (!verifier.SaveSidecar(sidecar)) {
+        printf("ArchiveVerify: %s\n", verifier.GetLastError().c_str());
+        return;
+    }
+    wdf.Close();
+
+    {
+        std::fstream file(corpus + "/c3.wdf", std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(4096);
+        char byte = 0;
+        file.read(&byte, 1);
+        file.seekp(4096);
+        byte ^= 0x5A;
+        file.write(&byte, 1);
+    }
+    C3WdfArchive corrupted;
+    C3ArchiveVerifier checker;
+    if (!corrupted.Open(corpus + "/c3.wdf") || !checker.LoadSidecar(sidecar) || !checker.Verify(corrupted)) {
+        printf("ArchiveVerify: %s\n", checker.GetLastError().c_str());
+        return;
+    }
+    C3Bench::Report("ArchiveVerify", "problems after one flipped byte", double(checker.GetStats().problemCount), "");
+    for (const auto& problem : checker.GetProblems()) {
+        printf("ArchiveVerify: entry %08X: %s\n", problem.id, C3ArchiveVerifier::GetProblemName(problem.problem));
+    }
+}
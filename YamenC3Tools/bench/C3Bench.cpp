@@ -0,0 +1,139 @@
+#include "C3Bench.h"
+#include "Core/C3Types.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+volatile uint64_t g_sink = 0;
+}
+
+std::vector<C3Bench::Case>& C3Bench::Registry() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+void C3Bench::Report(const char* bench, const std::string& metric, double value, const char* unit) {
+    printf("%-24s %-40s %14.2f %s\n", bench, metric.c_str(), value, unit);
+}
+
+void C3Bench::Consume(uint64_t value) {
+    g_sink = g_sink + value;
+}
+
+bool C3Bench::WriteMeshCorpus(const std::string& root, size_t fileCount, uint32_t maxSide,
+    std::vector<std::string>* paths) {
+    std::mt19937 rng(7);
+    const uint32_t minSide = std::min(16u, maxSide);
+    for (size_t i = 0; i < fileCount; i++) {
+        std::string dir = root + "/c3/mesh" + std::to_string(i % 16);
+        std::filesystem::create_directories(dir);
+
+        uint32_t side = maxSide > minSide ? minSide + rng() % (maxSide - minSide) : minSide;
+        std::vector<PhyVertex> vertices(size_t(side) * side);
+        for (uint32_t y = 0; y < side; y++) {
+            for (uint32_t x = 0; x < side; x++) {
+                PhyVertex& v = vertices[size_t(y) * side + x];
+                memset(&v, 0, sizeof(v));
+                float h = std::sin(x * 0.3f) * std::cos(y * 0.2f);
+                for (int k = 0; k < 4; k++) v.positions[k] = { float(x), h + k * 0.01f, float(y) };
+                v.u = float(x) / side;
+                v.v = float(y) / side;
+                v.color = 0xFFFFFFFF;
+                v.boneWeights[0] = 1.0f;
+            }
+        }
+
+        std::vector<uint16_t> indices;
+        for (uint32_t y = 0; y + 1 < side; y++) {
+            for (uint32_t x = 0; x + 1 < side; x++) {
+                uint16_t v0 = static_cast<uint16_t>(y * side + x);
+                uint16_t v1 = static_cast<uint16_t>(v0 + 1), v2 = static_cast<uint16_t>(v0 + side), v3 = static_cast<uint16_t>(v2 + 1);
+                indices.insert(indices.end(), { v0, v2, v1, v1, v2, v3 });
+            }
+        }
+
+        // One PHY chunk: name, blend count, vertex counts, vertices, triangle counts, indices, texture name
+        std::vector<uint8_t> chunk;
+        auto put = [&chunk](const void* data, size_t size) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            chunk.insert(chunk.end(), bytes, bytes + size);
+        };
+        auto putU32 = [&put](uint32_t value) { put(&value, 4); };
+        putU32(0);
+        putU32(1);
+        putU32(static_cast<uint32_t>(vertices.size()));
+        putU32(0);
+        put(vertices.data(), vertices.size() * sizeof(PhyVertex));
+        putU32(static_cast<uint32_t>(indices.size() / 3));
+        putU32(0);
+        put(indices.data(), indices.size() * sizeof(uint16_t));
+        putU32(0);
+
+        std::string path = dir + "/" + std::to_string(i) + ".c3";
+        std::ofstream out(path, std::ios::binary);
+        C3FileHeader header{};
+        memcpy(header.magic, "MAXFILE C3", 10);
+        memcpy(header.physicsType, "PHY ", 4);
+        uint32_t chunkSize = static_cast<uint32_t>(chunk.size());
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(&chunkSize), sizeof(chunkSize));
+        out.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+        if (!out) return false;
+        if (paths) paths->push_back(path);
+    }
+    return true;
+}
+
+void C3Bench::EvictFromPageCache(const std::vector<std::string>& paths) {
+#if defined(__linux__)
+    for (const auto& path : paths) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) continue;
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+#else
+    (void)paths;
+#endif
+}
+
+// Usage: YamenC3Bench [--filter <substring>] [--work <dir>] [inputs...]
+int main(int argc, char** argv) {
+    C3BenchContext ctx;
+    std::string filter;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        }
+        else if (strcmp(argv[i], "--work") == 0 && i + 1 < argc) {
+            ctx.workDir = argv[++i];
+        }
+        else {
+            ctx.inputs.push_back(argv[i]);
+        }
+    }
+
+    if (ctx.workDir.empty()) {
+        ctx.workDir = (std::filesystem::temp_directory_path() / "YamenC3Bench").string();
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(ctx.workDir, ec);
+
+    for (const auto& bench : C3Bench::Registry()) {
+        if (!filter.empty() && strstr(bench.name, filter.c_str()) == nullptr) continue;
+        bench.function(ctx);
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Small benchmark harness for the Core library. Each Bench*.cpp registers
+// its cases with C3_BENCHMARK and main() runs those matching the filter.
+struct C3BenchContext {
+    std::vector<std::string> inputs; // Archives or models given on the command line
+    std::string workDir;             // Scratch directory for generated data
+};
+
+class C3Bench {
+public:
+    using Function = void (*)(const C3BenchContext&);
+
+    struct Case {
+        const char* name;
+        Function function;
+    };
+
+    struct Registrar {
+        Registrar(const char* name, Function function) { Registry().push_back({ name, function }); }
+    };
+
+    static std::vector<Case>& Registry();
+
+    // Runs fn() 'iterations' times and returns nanoseconds per iteration
+    template <typename Fn>
+    static double TimeNs(size_t iterations, Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) fn();
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        return iterations ? ns / double(iterations) : 0.0;
+    }
+
+    static void Report(const char* bench, const std::string& metric, double value, const char* unit);
+
+    static double ThroughputMBs(uint64_t bytes, double ns) {
+        return ns > 0 ? (double(bytes) / (1024.0 * 1024.0)) / (ns * 1e-9) : 0.0;
+    }
+
+    // Writes 'fileCount' loadable C3 files, each one PHY chunk holding a
+    // smooth triangulated grid narrower than maxSide, under root/c3/meshN/
+    static bool WriteMeshCorpus(const std::string& root, size_t fileCount, uint32_t maxSide = 64,
+        std::vector<std::string>* paths = nullptr);
+
+    // Best effort: asks the kernel to drop each file from the page cache so
+    // the next pass goes to the device (a no-op on tmpfs and off Linux)
+    static void EvictFromPageCache(const std::vector<std::string>& paths);
+
+    // Defeats dead-code elimination of benchmarked results
+    static void Consume(uint64_t value);
+};
+
+#define C3_BENCHMARK(name) \
+    static void name(const C3BenchContext& ctx); \
+    static C3Bench::Registrar name##_registrar(#name, name); \
+    static void name(const C3BenchContext& ctx)
@@ -0,0 +1,96 @@
+#include "C3AccessTrace.h"
+#include <cstring>
+#include <fstream>
+
+void C3AccessTrace::Start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_start = std::chrono::steady_clock::now();
+    m_recording = true;
+}
+
+void C3AccessTrace::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
+
+void C3AccessTrace::OnAccess(const C3AssetResolver::Location& location) {
+    if (m_recording) Record(location.packId, location.fileId, location.size);
+}
+
+void C3AccessTrace::Record(uint32_t packId, uint32_t fileId, uint32_t size) {
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry entry;
+    entry.timeUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - m_start).count());
+    entry.packId = packId;
+    entry.fileId = fileId;
+    entry.size = size;
+    m_entries.push_back(entry);
+}
+
+std::vector<C3AccessTrace::Entry> C3AccessTrace::GetEntries() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries;
+}
+
+size_t C3AccessTrace::GetEntryCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+bool C3AccessTrace::Save(const std::string& path) {
+    std::vector<Entry> entries = GetEntries();
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        m_lastError = "Failed to create trace file: " + path;
+        return false;
+    }
+
+    FileHeader header{};
+    memcpy(header.magic, "C3TR", 4);
+    header.version = kVersion;
+    header.count = entries.size();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+    if (!file) {
+        m_lastError = "Failed to write trace file: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool C3AccessTrace::Load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        m_lastError = "Failed to open trace file: " + path;
+        return false;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+
+    FileHeader header{};
+    if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        memcmp(header.magic, "C3TR", 4) != 0) {
+        m_lastError = "Not a C3 access trace: " + path;
+        return false;
+    }
+    if (header.version != kVersion) {
+        m_lastError = "Unsupported trace version: " + std::to_string(header.version);
+        return false;
+    }
+    if (header.count > (fileSize - sizeof(header)) / sizeof(Entry)) {
+        m_lastError = "Truncated trace file: " + path;
+        return false;
+    }
+
+    std::vector<Entry> entries(static_cast<size_t>(header.count));
+    if (!file.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(Entry))) {
+        m_lastError = "Failed to read trace file: " + path;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries = std::move(entries);
+    return true;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "C3VirtualFileSystem.h"
+#include <chrono>
+
+// Records the order in which archive assets are opened. Register it with
+// C3VirtualFileSystem::AddListener and call Start(); a saved trace drives
+// C3Prefetcher on the next run. Recording is a mutex-guarded append.
+class C3AccessTrace : public C3VirtualFileSystem::AccessListener {
+public:
+#pragma pack(push, 1)
+    struct Entry {
+        uint64_t timeUs = 0; // Since Start()
+        uint32_t packId = 0;
+        uint32_t fileId = 0;
+        uint32_t size = 0;
+        uint32_t reserved = 0;
+    };
+
+    struct FileHeader {
+        char magic[4];  // "C3TR"
+        uint32_t version;
+        uint64_t count;
+    };
+#pragma pack(pop)
+
+    static constexpr uint32_t kVersion = 1;
+
+    void Start();
+    void Stop() { m_recording = false; }
+    bool IsRecording() const { return m_recording; }
+    void Clear();
+
+    void OnAccess(const C3AssetResolver::Location& location) override;
+    void Record(uint32_t packId, uint32_t fileId, uint32_t size);
+
+    // Snapshot of the entries recorded so far
+    std::vector<Entry> GetEntries() const;
+    size_t GetEntryCount() const;
+
+    bool Save(const std::string& path);
+    bool Load(const std::string& path);
+
+    const std::string& GetLastError() const { return m_lastError; }
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+    std::atomic<bool> m_recording{ false };
+    std::chrono::steady_clock::time_point m_start;
+    std::string m_lastError;
+};
@@ -0,0 +1,115 @@
+#include "C3Archive.h"
+
+void C3Archive::Close() {
+    m_file.Close();
+    m_perfectHash.Clear();
+    m_packId = 0;
+}
+
+bool C3Archive::Contains(const char* path) const {
+    Entry entry;
+    return Find(path, entry);
+}
+
+bool C3Archive::Find(const char* path, Entry& out) const {
+    if (!path || !IsOpen()) return false;
+    if (PackIdFromPath(path) != m_packId) return false;
+    return Find(FileIdFromPath(path), out);
+}
+
+std::span<const uint8_t> C3Archive::GetData(uint32_t fileId) const {
+    Entry entry;
+    if (!SupportsZeroCopy() || !Find(fileId, entry)) return {};
+    return m_file.View(entry.offset, entry.size);
+}
+
+std::span<const uint8_t> C3Archive::GetData(const char* path) const {
+    Entry entry;
+    if (!SupportsZeroCopy() || !Find(path, entry)) return {};
+    return m_file.View(entry.offset, entry.size);
+}
+
+bool C3Archive::ReadFile(uint32_t fileId, std::vector<uint8_t>& out, std::string* error) const {
+    Entry entry;
+    if (!Find(fileId, entry)) {
+        if (error) *error = "File not found in archive";
+        return false;
+    }
+
+    out.resize(entry.size);
+    if (entry.size > 0 && !m_file.ReadAt(entry.offset, out.data(), entry.size)) {
+        if (error) *error = "Failed to read archive entry";
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+bool C3Archive::ReadFile(const char* path, std::vector<uint8_t>& out, std::string* error) const {
+    if (!path || PackIdFromPath(path) != m_packId) {
+        if (error) *error = "Path does not belong to this archive";
+        return false;
+    }
+    return ReadFile(FileIdFromPath(path), out, error);
+}
+
+bool C3Archive::ReadRange(uint32_t fileId, uint64_t offset, void* dst, size_t size, std::string* error) const {
+    Entry entry;
+    if (!Find(fileId, entry)) {
+        if (error) *error = "File not found in archive";
+        return false;
+    }
+    if (offset > entry.size || size > entry.size - offset) {
+        if (error) *error = "Read past end of archive entry";
+        return false;
+    }
+    if (size > 0 && !m_file.ReadAt(entry.offset + offset, dst, size)) {
+        if (error) *error = "Failed to read archive entry";
+        return false;
+    }
+    return true;
+}
+
+bool C3Archive::Prefetch(uint32_t fileId, bool blocking) const {
+    Entry entry;
+    return Find(fileId, entry) && PrefetchStored(entry.offset, entry.size, blocking);
+}
+
+bool C3Archive::PrefetchStored(uint64_t offset, uint64_t size, bool blocking) const {
+    if (size == 0) return true;
+    if (!m_file.Prefetch(offset, size)) return false;
+    if (blocking) {
+        // One read per page forces it resident before returning
+        std::span<const uint8_t> range = m_file.View(offset, size);
+        uint8_t sink = 0;
+        for (size_t i = 0; i < range.size(); i += 4096) sink ^= static_cast<const volatile uint8_t&>(range[i]);
+        sink ^= static_cast<const volatile uint8_t&>(range.back());
+        (void)sink;
+    }
+    return true;
+}
+
+std::vector<uint32_t> C3Archive::GetEntryIds() const {
+    std::vector<uint32_t> ids(GetEntryCount());
+    for (size_t i = 0; i < ids.size(); i++) ids[i] = GetEntry(i).id;
+    return ids;
+}
+
+bool C3Archive::WritePerfectHash(const std::string& path) {
+    const std::vector<uint32_t> ids = GetEntryIds();
+    if (!m_perfectHash.Build(ids) || !m_perfectHash.Save(path, C3PerfectHash::KeyChecksum(ids))) {
+        m_lastError = m_perfectHash.GetLastError();
+        m_perfectHash.Clear();
+        return false;
+    }
+    return true;
+}
+
+bool C3Archive::LoadPerfectHash(const std::string& path) {
+    const std::vector<uint32_t> ids = GetEntryIds();
+    if (!m_perfectHash.Load(path, ids.size(), C3PerfectHash::KeyChecksum(ids))) {
+        m_lastError = m_perfectHash.GetLastError();
+        return false;
+    }
+    return true;
+}
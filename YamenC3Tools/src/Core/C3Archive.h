@@ -0,0 +1,90 @@
+#pragma once
+#include "C3MappedFile.h"
+#include "C3PerfectHash.h"
+#include <span>
+#include <string>
+#include <vector>
+
+// Common interface for the client's packed archive formats. Archives are
+// mapped read-only and file data is handed out as spans into the mapping,
+// which C3Model::LoadFromMemory can parse without copying.
+//
+// Once Open() returns, every const member is safe to call from any number
+// of threads: reads are positional or go through the shared mapping, and
+// each call decodes into its caller's buffer. There is no archive lock and
+// no shared scratch buffer (unlike the legacy CDnFile).
+class C3Archive {
+public:
+    struct Entry {
+        uint32_t id = 0;     // File id within the archive
+        uint64_t offset = 0; // Byte offset of the stored data
+        uint32_t size = 0;   // Stored size in bytes
+    };
+
+    virtual ~C3Archive() = default;
+    virtual bool Open(const std::string& path) = 0;
+    virtual const char* GetFormatName() const = 0;
+    virtual const char* GetFileExtension() const = 0;
+
+    // Ids the client derives from a virtual path such as "c3/mesh/1.c3"
+    virtual uint32_t PackIdFromPath(const char* path) const = 0;
+    virtual uint32_t FileIdFromPath(const char* path) const = 0;
+    // Formats that derive the same ids from a path report the same name
+    virtual const char* GetIdScheme() const = 0;
+
+    virtual size_t GetEntryCount() const = 0;
+    virtual Entry GetEntry(size_t index) const = 0;
+    virtual bool Find(uint32_t fileId, Entry& out) const = 0;
+
+    virtual void Close();
+
+    // False for formats whose stored bytes are not the file contents (compressed)
+    virtual bool SupportsZeroCopy() const { return true; }
+
+    bool IsOpen() const { return m_file.IsOpen(); }
+    uint32_t GetPackId() const { return m_packId; }
+    const std::string& GetPath() const { return m_file.GetPath(); }
+    const std::string& GetLastError() const { return m_lastError; }
+
+    bool Contains(const char* path) const;
+    bool Find(const char* path, Entry& out) const;
+
+    // Zero-copy view of a stored file; empty if it is missing or SupportsZeroCopy() is false
+    std::span<const uint8_t> GetData(uint32_t fileId) const;
+    std::span<const uint8_t> GetData(const char* path) const;
+
+    // Copies a stored file into 'out'
+    virtual bool ReadFile(uint32_t fileId, std::vector<uint8_t>& out, std::string* error = nullptr) const;
+    bool ReadFile(const char* path, std::vector<uint8_t>& out, std::string* error = nullptr) const;
+
+    // Reads 'size' bytes starting 'offset' bytes into the file
+    virtual bool ReadRange(uint32_t fileId, uint64_t offset, void* dst, size_t size, std::string* error = nullptr) const;
+
+    // Starts reading the file's stored bytes into memory. With 'blocking'
+    // set, returns only once every page has been faulted in.
+    virtual bool Prefetch(uint32_t fileId, bool blocking = false) const;
+    // Same for a raw byte range of the archive file, e.g. a run of entries
+    bool PrefetchStored(uint64_t offset, uint64_t size, bool blocking = false) const;
+
+    // Optional minimal perfect hash over the entry ids, kept in a sidecar
+    // ("<archive>.c3mph") for shipped archives that never change. Once one
+    // is loaded, WDF and WDZ lookups cost one hash, one table read and one
+    // id check instead of a binary search. DNP keeps its open-addressing
+    // table, which already averages about one probe. A sidecar built for
+    // other contents is rejected by LoadPerfectHash().
+    bool WritePerfectHash(const std::string& path);
+    bool LoadPerfectHash(const std::string& path);
+    void DropPerfectHash() { m_perfectHash.Clear(); }
+    bool HasPerfectHash() const { return m_perfectHash.IsLoaded(); }
+    const C3PerfectHash::Stats& GetPerfectHashStats() const { return m_perfectHash.GetStats(); }
+    static std::string GetPerfectHashPath(const C3Archive& archive) { return archive.GetPath() + ".c3mph"; }
+
+protected:
+    // Entry ids in GetEntry() order, the perfect hash's key list
+    std::vector<uint32_t> GetEntryIds() const;
+
+    C3MappedFile m_file;
+    C3PerfectHash m_perfectHash; // Lookup() gives a GetEntry() index
+    uint32_t m_packId = 0;
+    std::string m_lastError;
+};
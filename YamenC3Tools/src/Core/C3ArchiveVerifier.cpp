@@ -0,0 +1,319 @@
+#include "C3ArchiveVerifier.h"
+#include "C3Model.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+namespace {
+
+constexpr uint64_t kPrime1 = 11400714785074694791ULL;
+constexpr uint64_t kPrime2 = 14029467366897019727ULL;
+constexpr uint64_t kPrime3 = 1609587929392839161ULL;
+constexpr uint64_t kPrime4 = 9650029242287828579ULL;
+constexpr uint64_t kPrime5 = 2870177450012600261ULL;
+
+inline uint64_t Rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+inline uint64_t Read64(const uint8_t* p) { uint64_t v; memcpy(&v, p, 8); return v; }
+inline uint32_t Read32(const uint8_t* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+
+inline uint64_t Round(uint64_t acc, uint64_t input) {
+    acc += input * kPrime2;
+    return Rotl(acc, 31) * kPrime1;
+}
+
+inline uint64_t MergeRound(uint64_t acc, uint64_t value) {
+    acc ^= Round(0, value);
+    return acc * kPrime1 + kPrime4;
+}
+
+// Mirrors the bounds C3Model::ParsePHY enforces, without copying anything
+bool CheckPhyChunk(const uint8_t* data, size_t offset, size_t end) {
+    if (offset + 4 > end) return false;
+    uint32_t nameLen = Read32(data + offset);
+    offset += 4;
+    if (nameLen > 0 && nameLen < 256 && offset + nameLen <= end) offset += nameLen;
+
+    if (offset + 12 > end) return false;
+    uint64_t totalVerts = uint64_t(Read32(data + offset + 4)) + Read32(data + offset + 8);
+    offset += 12;
+    if (totalVerts == 0 || totalVerts * 40 > end - offset) return false;
+    offset += (end - offset >= totalVerts * 76) ? totalVerts * 76 : totalVerts * 40;
+
+    if (offset + 8 > end) return false;
+    uint64_t indexBytes = (uint64_t(Read32(data + offset)) + Read32(data + offset + 4)) * 3 * sizeof(uint16_t);
+    offset += 8;
+    return indexBytes <= end - offset;
+}
+
+} // namespace
+
+uint64_t C3ArchiveVerifier::Checksum(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    const uint8_t* end = p + size;
+    uint64_t h;
+
+    if (size >= 32) {
+        uint64_t v1 = seed + kPrime1 + kPrime2;
+        uint64_t v2 = seed + kPrime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - kPrime1;
+        const uint8_t* limit = end - 32;
+        do {
+            v1 = Round(v1, Read64(p));
+            v2 = Round(v2, Read64(p + 8));
+            v3 = Round(v3, Read64(p + 16));
+            v4 = Round(v4, Read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        h = Rotl(v1, 1) + Rotl(v2, 7) + Rotl(v3, 12) + Rotl(v4, 18);
+        h = MergeRound(h, v1);
+        h = MergeRound(h, v2);
+        h = MergeRound(h, v3);
+        h = MergeRound(h, v4);
+    }
+    else {
+        h = seed + kPrime5;
+    }
+    h += size;
+
+    for (; p + 8 <= end; p += 8) {
+        h ^= Round(0, Read64(p));
+        h = Rotl(h, 27) * kPrime1 + kPrime4;
+    }
+    if (p + 4 <= end) {
+        h ^= uint64_t(Read32(p)) * kPrime1;
+        h = Rotl(h, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        h ^= *p * kPrime5;
+        h = Rotl(h, 11) * kPrime1;
+    }
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+C3ArchiveVerifier::Problem C3ArchiveVerifier::CheckC3Structure(const uint8_t* data, size_t size) {
+    if (size < 10 || memcmp(data, "MAXFILE C3", 10) != 0) return Problem::None;
+    if (size < sizeof(C3FileHeader) + 4) return Problem::BadC3Header;
+
+    // Only the ids C3Model::LoadFromMemory accepts there
+    const C3Model::ChunkId* first = C3Model::FindChunkId(data + offsetof(C3FileHeader, physicsType));
+    if (!first || !first->inHeader) return Problem::BadC3Header;
+
+    // The first chunk's id lives in the header and only its size follows
+    size_t offset = sizeof(C3FileHeader);
+    uint32_t chunkSize = Read32(data + offset);
+    offset += 4;
+    if (chunkSize == 0 || chunkSize > size - offset) return Problem::BadC3Header;
+    if (first->parser == C3Model::ChunkParser::Phy && !CheckPhyChunk(data, offset, offset + chunkSize)) return Problem::BadChunk;
+    offset += chunkSize;
+
+    // Any further chunks carry their own id and size
+    while (size - offset >= 8 && C3Model::FindChunkId(data + offset)) {
+        uint32_t nextSize = Read32(data + offset + 4);
+        offset += 8;
+        if (nextSize > size - offset) return Problem::BadChunk;
+        offset += nextSize;
+    }
+    return Problem::None;
+}
+
+const char* C3ArchiveVerifier::GetProblemName(Problem problem) {
+    switch (problem) {
+    case Problem::None: return "ok";
+    case Problem::OutOfBounds: return "out of bounds";
+    case Problem::ReadFailed: return "read failed";
+    case Problem::BadC3Header: return "bad C3 header";
+    case Problem::BadChunk: return "bad chunk";
+    case Problem::ChecksumMismatch: return "checksum mismatch";
+    case Problem::NotInSidecar: return "not in sidecar";
+    }
+    return "unknown";
+}
+
+bool C3ArchiveVerifier::Verify(const C3Archive& archive, const Options& options) {
+    m_results.clear();
+    m_stats = {};
+    m_resultPackId = archive.GetPackId();
+    if (!archive.IsOpen()) {
+        m_lastError = "Archive is not open";
+        return false;
+    }
+    if (!m_expected.empty() && m_expectedPackId != archive.GetPackId()) {
+        m_lastError = "Sidecar belongs to a different archive";
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const size_t count = archive.GetEntryCount();
+    std::vector<C3Archive::Entry> entries(count);
+    for (size_t i = 0; i < count; i++) entries[i] = archive.GetEntry(i);
+    std::sort(entries.begin(), entries.end(), [](const C3Archive::Entry& a, const C3Archive::Entry& b) {
+        return a.offset < b.offset;
+    });
+    m_results.resize(count);
+
+    // Batches of neighbouring entries, each prefetched one batch ahead
+    constexpr uint64_t kBatchBytes = 4u << 20;
+    std::vector<size_t> batchStarts;
+    uint64_t batchBytes = kBatchBytes;
+    for (size_t i = 0; i < count; i++) {
+        if (batchBytes >= kBatchBytes) {
+            batchStarts.push_back(i);
+            batchBytes = 0;
+        }
+        batchBytes += entries[i].size;
+    }
+    batchStarts.push_back(count);
+    const size_t batchCount = batchStarts.size() - 1;
+
+    const bool zeroCopy = archive.SupportsZeroCopy();
+    std::atomic<size_t> nextBatch{ 0 };
+    std::atomic<size_t> c3Count{ 0 };
+    std::atomic<size_t> problemCount{ 0 };
+    std::atomic<uint64_t> bytes{ 0 };
+
+    auto worker = [&] {
+        std::vector<uint8_t> buffer;
+        for (size_t batch = nextBatch++; batch < batchCount; batch = nextBatch++) {
+            if (batch + 1 < batchCount) {
+                const C3Archive::Entry& first = entries[batchStarts[batch + 1]];
+                const C3Archive::Entry& last = entries[batchStarts[batch + 2] - 1];
+                archive.PrefetchStored(first.offset, last.offset + last.size - first.offset);
+            }
+
+            for (size_t i = batchStarts[batch]; i < batchStarts[batch + 1]; i++) {
+                const C3Archive::Entry& entry = entries[i];
+                Result& result = m_results[i];
+                result.id = entry.id;
+
+                std::span<const uint8_t> data;
+                if (zeroCopy) {
+                    data = archive.GetData(entry.id);
+                    if (data.size() != entry.size) result.problem = Problem::OutOfBounds;
+                }
+                else if (archive.ReadFile(entry.id, buffer)) {
+                    data = buffer;
+                }
+                else {
+                    result.problem = Problem::ReadFailed;
+                }
+
+                if (result.problem == Problem::None) {
+                    result.size = static_cast<uint32_t>(data.size());
+                    result.checksum = Checksum(data.data(), data.size());
+                    result.isC3 = data.size() >= 10 && memcmp(data.data(), "MAXFILE C3", 10) == 0;
+                    if (result.isC3) {
+                        c3Count++;
+                        if (options.checkStructure) result.problem = CheckC3Structure(data.data(), data.size());
+                    }
+                    bytes += data.size();
+                }
+                else {
+                    result.size = entry.size;
+                }
+
+                if (result.problem == Problem::None && !m_expected.empty()) {
+                    auto expected = std::lower_bound(m_expected.begin(), m_expected.end(), entry.id,
+                        [](const SidecarEntry& e, uint32_t id) { return e.id < id; });
+                    if (expected == m_expected.end() || expected->id != entry.id) result.problem = Problem::NotInSidecar;
+                    else if (expected->size != result.size || expected->checksum != result.checksum) result.problem = Problem::ChecksumMismatch;
+                }
+                if (result.problem != Problem::None) problemCount++;
+            }
+        }
+    };
+
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(1, batchCount)));
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool) thread.join();
+
+    std::sort(m_results.begin(), m_results.end(), [](const Result& a, const Result& b) { return a.id < b.id; });
+
+    m_stats.entryCount = count;
+    m_stats.c3Count = c3Count;
+    m_stats.problemCount = problemCount;
+    m_stats.bytesScanned = bytes;
+    m_stats.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+std::vector<C3ArchiveVerifier::Result> C3ArchiveVerifier::GetProblems() const {
+    std::vector<Result> problems;
+    for (const auto& result : m_results) {
+        if (result.problem != Problem::None) problems.push_back(result);
+    }
+    return problems;
+}
+
+bool C3ArchiveVerifier::SaveSidecar(const std::string& path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        m_lastError = "Failed to create sidecar: " + path;
+        return false;
+    }
+
+    std::vector<SidecarEntry> entries;
+    entries.reserve(m_results.size());
+    for (const auto& result : m_results) {
+        if (result.problem == Problem::OutOfBounds || result.problem == Problem::ReadFailed) continue;
+        entries.push_back({ result.id, result.size, result.checksum });
+    }
+
+    SidecarHeader header{};
+    memcpy(header.magic, "C3SM", 4);
+    header.version = kSidecarVersion;
+    header.packId = m_resultPackId;
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(SidecarEntry));
+    if (!file) {
+        m_lastError = "Failed to write sidecar: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool C3ArchiveVerifier::LoadSidecar(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        m_lastError = "Failed to open sidecar: " + path;
+        return false;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+
+    SidecarHeader header{};
+    if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        memcmp(header.magic, "C3SM", 4) != 0 || header.version != kSidecarVersion) {
+        m_lastError = "Not a checksum sidecar: " + path;
+        return false;
+    }
+    if (header.entryCount > (fileSize - sizeof(header)) / sizeof(SidecarEntry)) {
+        m_lastError = "Truncated sidecar: " + path;
+        return false;
+    }
+
+    std::vector<SidecarEntry> entries(header.entryCount);
+    if (!file.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(SidecarEntry))) {
+        m_lastError = "Failed to read sidecar: " + path;
+        return false;
+    }
+    std::sort(entries.begin(), entries.end(), [](const SidecarEntry& a, const SidecarEntry& b) { return a.id < b.id; });
+    m_expected = std::move(entries);
+    m_expectedPackId = header.packId;
+    return true;
+}
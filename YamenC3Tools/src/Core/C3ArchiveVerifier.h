@@ -0,0 +1,94 @@
+#pragma once
+#include "C3Archive.h"
+
+// Scans every entry of an archive on a pool of threads. Each entry gets a
+// 64-bit checksum (xxHash64) and, if it is a C3 file, a structural check of
+// its header and chunk layout that stops short of parsing vertex data.
+// Entries are visited in storage order so the reads stay sequential.
+//
+// Checksums can be saved to a sidecar index ("<archive>.c3sum") and loaded
+// before a later Verify() to detect entries whose bytes have changed.
+class C3ArchiveVerifier {
+public:
+    enum class Problem : uint8_t {
+        None,
+        OutOfBounds,      // Entry extends past the end of the archive
+        ReadFailed,       // Could not read or decode the stored bytes
+        BadC3Header,      // "MAXFILE C3" file with an unknown type or bad first chunk
+        BadChunk,         // Chunk sizes overrun the file or PHY counts do not fit
+        ChecksumMismatch, // Differs from the loaded sidecar
+        NotInSidecar,     // Entry absent from the loaded sidecar
+    };
+
+    struct Result {
+        uint32_t id = 0;
+        uint32_t size = 0;
+        uint64_t checksum = 0;
+        Problem problem = Problem::None;
+        bool isC3 = false;
+    };
+
+    struct Options {
+        unsigned threads = 0;        // 0 = hardware concurrency
+        bool checkStructure = true;  // C3 header and chunk checks
+    };
+
+    struct Stats {
+        size_t entryCount = 0;
+        size_t c3Count = 0;
+        size_t problemCount = 0;
+        uint64_t bytesScanned = 0;
+        double elapsedMs = 0.0;
+
+        double ThroughputMBs() const { return elapsedMs > 0 ? (bytesScanned / (1024.0 * 1024.0)) / (elapsedMs / 1000.0) : 0.0; }
+    };
+
+#pragma pack(push, 1)
+    struct SidecarHeader {
+        char magic[4]; // "C3SM"
+        uint32_t version;
+        uint32_t packId;
+        uint32_t entryCount;
+    };
+
+    struct SidecarEntry {
+        uint32_t id;
+        uint32_t size;
+        uint64_t checksum;
+    };
+#pragma pack(pop)
+
+    static constexpr uint32_t kSidecarVersion = 1;
+
+    bool Verify(const C3Archive& archive) { return Verify(archive, Options{}); }
+    bool Verify(const C3Archive& archive, const Options& options);
+
+    // Results of the last Verify(), sorted by id
+    const std::vector<Result>& GetResults() const { return m_results; }
+    std::vector<Result> GetProblems() const;
+    const Stats& GetStats() const { return m_stats; }
+
+    // Checksums from the last Verify()
+    bool SaveSidecar(const std::string& path);
+    // Expected checksums for the next Verify(); cleared by ClearSidecar()
+    bool LoadSidecar(const std::string& path);
+    void ClearSidecar() { m_expected.clear(); }
+    bool HasSidecar() const { return !m_expected.empty(); }
+
+    static std::string GetSidecarPath(const C3Archive& archive) { return archive.GetPath() + ".c3sum"; }
+    static const char* GetProblemName(Problem problem);
+
+    static uint64_t Checksum(const void* data, size_t size, uint64_t seed = 0);
+    // Header and chunk walk only; returns Problem::None for valid or non-C3 data
+    static Problem CheckC3Structure(const uint8_t* data, size_t size);
+
+    const std::string& GetLastError() const { return m_lastError; }
+
+private:
+    std::vector<Result> m_results;
+    std::vector<SidecarEntry> m_expected; // Sorted by id
+    uint32_t m_expectedPackId = 0;
+    uint32_t m_resultPackId = 0;
+    Stats m_stats;
+    std::string m_lastError;
+};
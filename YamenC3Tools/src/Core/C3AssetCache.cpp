@@ -0,0 +1,258 @@
+#include "C3AssetCache.h"
+#include "C3HashSystem.h"
+#include "C3Model.h"
+#include "C3VirtualFileSystem.h"
+#include <algorithm>
+#include <mutex>
+
+namespace {
+
+uint64_t MixKey(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    return x ^ (x >> 33);
+}
+
+} // namespace
+
+C3AssetCache::C3AssetCache(size_t budgetBytes, unsigned shardCount)
+    : m_shards(new Shard[std::max(1u, shardCount)]), m_shardCount(std::max(1u, shardCount)) {
+    SetBudget(budgetBytes);
+}
+
+C3AssetCache::~C3AssetCache() = default;
+
+C3AssetCache::Key C3AssetCache::KeyForPath(const std::string& path) {
+    const std::string normalized = C3VirtualFileSystem::NormalizePath(path);
+    return MakeKey(C3HashSystem::PackName(normalized), C3HashSystem::RealName(normalized));
+}
+
+C3AssetCache::Shard& C3AssetCache::ShardFor(Key key) const {
+    return m_shards[(MixKey(key) >> 32) % m_shardCount];
+}
+
+std::shared_ptr<const void> C3AssetCache::Get(Key key, Kind kind) {
+    Shard& shard = ShardFor(key);
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.slots.find(key);
+        if (it != shard.slots.end()) {
+            Slot& slot = shard.ring[it->second];
+            if (slot.kind == kind) {
+                // Skip the store when already set, so hot entries stay in shared cache lines
+                if (!slot.referenced.load(std::memory_order_relaxed)) slot.referenced.store(true, std::memory_order_relaxed);
+                shard.hits.fetch_add(1, std::memory_order_relaxed);
+                return slot.value;
+            }
+        }
+    }
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void C3AssetCache::Put(Key key, std::shared_ptr<const void> value, size_t bytes, Kind kind) {
+    Shard& shard = ShardFor(key);
+    std::vector<std::shared_ptr<const void>> evicted;
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.slots.find(key);
+        if (it != shard.slots.end()) {
+            Slot& old = shard.ring[it->second];
+            shard.bytes -= old.bytes;
+            evicted.push_back(std::move(old.value));
+            old.value.reset();
+            shard.freeSlots.push_back(it->second);
+            shard.slots.erase(it);
+        }
+        if (bytes > shard.budget) {
+            shard.rejected.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        EvictLocked(shard, bytes, evicted);
+        size_t index;
+        if (!shard.freeSlots.empty()) {
+            index = shard.freeSlots.back();
+            shard.freeSlots.pop_back();
+        }
+        else {
+            index = shard.ring.size();
+            shard.ring.emplace_back();
+        }
+        Slot& slot = shard.ring[index];
+        slot.key = key;
+        slot.value = std::move(value);
+        slot.bytes = bytes;
+        slot.kind = kind;
+        slot.referenced.store(false, std::memory_order_relaxed);
+        shard.slots.emplace(key, index);
+        shard.bytes += bytes;
+        shard.insertions.fetch_add(1, std::memory_order_relaxed);
+    }
+    // 'evicted' releases its values here, outside the lock
+}
+
+void C3AssetCache::EvictLocked(Shard& shard, size_t incoming, std::vector<std::shared_ptr<const void>>& evicted) {
+    while (shard.bytes + incoming > shard.budget && !shard.slots.empty()) {
+        const size_t index = shard.hand;
+        shard.hand = (shard.hand + 1) % shard.ring.size();
+        Slot& slot = shard.ring[index];
+        if (!slot.value) continue;
+        // Referenced since the hand last passed: clear and give it another lap
+        if (slot.referenced.exchange(false, std::memory_order_relaxed)) continue;
+
+        shard.slots.erase(slot.key);
+        shard.bytes -= slot.bytes;
+        evicted.push_back(std::move(slot.value));
+        slot.value.reset();
+        shard.freeSlots.push_back(index);
+        shard.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::shared_ptr<const C3Model> C3AssetCache::GetModel(Key key, Kind kind) {
+    if (kind == Kind::Texture) return nullptr;
+    return std::static_pointer_cast<const C3Model>(Get(key, kind));
+}
+
+std::shared_ptr<const C3AssetCache::Blob> C3AssetCache::GetTexture(Key key) {
+    return std::static_pointer_cast<const Blob>(Get(key, Kind::Texture));
+}
+
+void C3AssetCache::PutModel(Key key, std::shared_ptr<const C3Model> model, Kind kind) {
+    if (!model || kind == Kind::Texture) return;
+    const size_t bytes = model->GetMemoryUsage();
+    Put(key, std::move(model), bytes, kind);
+}
+
+void C3AssetCache::PutTexture(Key key, std::shared_ptr<const Blob> bytes) {
+    if (!bytes) return;
+    const size_t size = sizeof(Blob) + bytes->capacity();
+    Put(key, std::move(bytes), size, Kind::Texture);
+}
+
+std::shared_ptr<const C3Model> C3AssetCache::LoadModel(C3VirtualFileSystem& vfs, const std::string& path,
+    Kind kind, std::string* error) {
+    const Key key = KeyForPath(path);
+    if (auto cached = GetModel(key, kind)) return cached;
+
+    C3VirtualFileSystem::FileData file;
+    if (!vfs.Open(path, file, error)) return nullptr;
+    auto model = std::make_shared<C3Model>();
+    if (!model->LoadFromMemory(file.Data(), file.Size())) {
+        if (error) *error = model->GetError();
+        return nullptr;
+    }
+    PutModel(key, model, kind);
+    return model;
+}
+
+std::shared_ptr<const C3AssetCache::Blob> C3AssetCache::LoadTexture(C3VirtualFileSystem& vfs, const std::string& path,
+    std::string* error) {
+    const Key key = KeyForPath(path);
+    if (auto cached = GetTexture(key)) return cached;
+
+    auto bytes = std::make_shared<Blob>();
+    if (!vfs.ReadFile(path, *bytes, error)) return nullptr;
+    bytes->shrink_to_fit();
+    PutTexture(key, bytes);
+    return bytes;
+}
+
+bool C3AssetCache::Contains(Key key) const {
+    Shard& shard = ShardFor(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.slots.count(key) != 0;
+}
+
+bool C3AssetCache::FindKind(Key key, Kind& out) const {
+    Shard& shard = ShardFor(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.slots.find(key);
+    if (it == shard.slots.end()) return false;
+    out = shard.ring[it->second].kind;
+    return true;
+}
+
+bool C3AssetCache::Erase(Key key) {
+    Shard& shard = ShardFor(key);
+    std::shared_ptr<const void> value;
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.slots.find(key);
+    if (it == shard.slots.end()) return false;
+    Slot& slot = shard.ring[it->second];
+    shard.bytes -= slot.bytes;
+    value = std::move(slot.value);
+    slot.value.reset();
+    shard.freeSlots.push_back(it->second);
+    shard.slots.erase(it);
+    lock.unlock();
+    return true;
+}
+
+void C3AssetCache::Clear() {
+    for (unsigned i = 0; i < m_shardCount; i++) {
+        Shard& shard = m_shards[i];
+        std::deque<Slot> ring;
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        ring.swap(shard.ring);
+        shard.slots.clear();
+        shard.freeSlots.clear();
+        shard.hand = 0;
+        shard.bytes = 0;
+        lock.unlock();
+    }
+}
+
+void C3AssetCache::SetBudget(size_t budgetBytes) {
+    m_budget.store(budgetBytes, std::memory_order_relaxed);
+    for (unsigned i = 0; i < m_shardCount; i++) {
+        Shard& shard = m_shards[i];
+        std::vector<std::shared_ptr<const void>> evicted;
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.budget = budgetBytes / m_shardCount;
+        EvictLocked(shard, 0, evicted);
+        lock.unlock();
+    }
+}
+
+C3AssetCache::Stats C3AssetCache::GetStats() const {
+    Stats stats;
+    stats.budget = GetBudget();
+    for (unsigned i = 0; i < m_shardCount; i++) {
+        const Shard& shard = m_shards[i];
+        stats.hits += shard.hits.load(std::memory_order_relaxed);
+        stats.misses += shard.misses.load(std::memory_order_relaxed);
+        stats.insertions += shard.insertions.load(std::memory_order_relaxed);
+        stats.evictions += shard.evictions.load(std::memory_order_relaxed);
+        stats.rejected += shard.rejected.load(std::memory_order_relaxed);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        stats.entryCount += shard.slots.size();
+        stats.bytes += shard.bytes;
+    }
+    return stats;
+}
+
+void C3AssetCache::ResetCounters() {
+    for (unsigned i = 0; i < m_shardCount; i++) {
+        Shard& shard = m_shards[i];
+        shard.hits = 0;
+        shard.misses = 0;
+        shard.insertions = 0;
+        shard.evictions = 0;
+        shard.rejected = 0;
+    }
+}
+
+std::vector<C3AssetCache::EntryInfo> C3AssetCache::GetEntries() const {
+    std::vector<EntryInfo> entries;
+    for (unsigned i = 0; i < m_shardCount; i++) {
+        const Shard& shard = m_shards[i];
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (const auto& [key, index] : shard.slots) {
+            const Slot& slot = shard.ring[index];
+            entries.push_back({ key, slot.kind, slot.bytes });
+        }
+    }
+    return entries;
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class C3Model;
+class C3VirtualFileSystem;
+
+// Parsed assets shared between every user of the same file, held under a
+// byte budget. Entries are immutable (shared_ptr<const T>), keyed by the
+// asset's pack and file id, and charged their exact owned size. When an
+// insert would exceed the budget, entries are evicted in CLOCK order: a
+// hit only sets the entry's reference bit, so lookups take a shard's lock
+// in shared mode and concurrent readers never serialize. Keys are spread
+// over independent shards, each with its own lock and a slice of the budget.
+//
+// Replaces the legacy CGameDataSet age-based expiry (_3DOBJ_DEADLINE),
+// which had no notion of memory.
+class C3AssetCache {
+public:
+    enum class Kind : uint8_t {
+        Model,   // C3Model with meshes, shapes or particles
+        Motion,  // C3Model holding only bones and animations
+        Texture, // Texture file bytes, e.g. DDS or TGA
+    };
+
+    using Key = uint64_t;
+    using Blob = std::vector<uint8_t>;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t insertions = 0;
+        uint64_t evictions = 0;
+        uint64_t rejected = 0;  // Larger than a shard's budget, returned uncached
+        size_t entryCount = 0;
+        size_t bytes = 0;
+        size_t budget = 0;
+
+        double HitRate() const { return hits + misses ? double(hits) / double(hits + misses) : 0.0; }
+    };
+
+    struct EntryInfo {
+        Key key = 0;
+        Kind kind = Kind::Model;
+        size_t bytes = 0;
+    };
+
+    static constexpr unsigned kDefaultShards = 16;
+
+    explicit C3AssetCache(size_t budgetBytes) : C3AssetCache(budgetBytes, kDefaultShards) {}
+    C3AssetCache(size_t budgetBytes, unsigned shardCount);
+    ~C3AssetCache();
+
+    C3AssetCache(const C3AssetCache&) = delete;
+    C3AssetCache& operator=(const C3AssetCache&) = delete;
+
+    static Key MakeKey(uint32_t packId, uint32_t fileId) { return (Key(packId) << 32) | fileId; }
+    // The key of a virtual path, the same whether it is found loose or in an archive
+    static Key KeyForPath(const std::string& path);
+
+    // Null on a miss or when the entry holds another kind
+    std::shared_ptr<const C3Model> GetModel(Key key, Kind kind = Kind::Model);
+    std::shared_ptr<const Blob> GetTexture(Key key);
+
+    // Inserts or replaces, charging the value's own size. A value larger
+    // than a shard's budget is not kept.
+    void PutModel(Key key, std::shared_ptr<const C3Model> model, Kind kind = Kind::Model);
+    void PutTexture(Key key, std::shared_ptr<const Blob> bytes);
+
+    // Cached, or read through the file system, parsed and inserted. Two
+    // threads missing on the same path may both load it; the later insert wins.
+    std::shared_ptr<const C3Model> LoadModel(C3VirtualFileSystem& vfs, const std::string& path,
+        Kind kind = Kind::Model, std::string* error = nullptr);
+    std::shared_ptr<const Blob> LoadTexture(C3VirtualFileSystem& vfs, const std::string& path,
+        std::string* error = nullptr);
+
+    bool Contains(Key key) const;
+    // Kind of the cached entry; false if the key is not cached
+    bool FindKind(Key key, Kind& out) const;
+    bool Erase(Key key);
+    void Clear();
+
+    // Lowering the budget evicts immediately
+    void SetBudget(size_t budgetBytes);
+    size_t GetBudget() const { return m_budget.load(std::memory_order_relaxed); }
+
+    Stats GetStats() const;
+    void ResetCounters();
+    // Snapshot of every entry and its charged size
+    std::vector<EntryInfo> GetEntries() const;
+
+private:
+    struct Slot {
+        Key key = 0;
+        std::shared_ptr<const void> value;
+        size_t bytes = 0;
+        Kind kind = Kind::Model;
+        std::atomic<bool> referenced{ false };
+    };
+
+    // Own cache lines, so readers of different shards do not contend
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<Key, size_t> slots; // Key -> index into ring
+        std::deque<Slot> ring;                 // CLOCK order; empty slots are reused
+        std::vector<size_t> freeSlots;
+        size_t hand = 0;
+        size_t bytes = 0;
+        size_t budget = 0;
+
+        std::atomic<uint64_t> hits{ 0 };
+        std::atomic<uint64_t> misses{ 0 };
+        std::atomic<uint64_t> insertions{ 0 };
+        std::atomic<uint64_t> evictions{ 0 };
+        std::atomic<uint64_t> rejected{ 0 };
+    };
+
+    std::unique_ptr<Shard[]> m_shards;
+    unsigned m_shardCount = 0;
+    std::atomic<size_t> m_budget{ 0 };
+
+    Shard& ShardFor(Key key) const;
+    std::shared_ptr<const void> Get(Key key, Kind kind);
+    void Put(Key key, std::shared_ptr<const void> value, size_t bytes, Kind kind);
+    // Frees the shard down to its budget less 'incoming'; the caller holds the
+    // lock and destroys the evicted values after releasing it
+    void EvictLocked(Shard& shard, size_t incoming, std::vector<std::shared_ptr<const void>>& evicted);
+};
@@ -0,0 +1,254 @@
+#include "C3AssetResolver.h"
+#include "C3DnpArchive.h"
+#include "C3WdfArchive.h"
+#include "C3WdzArchive.h"
+#include <algorithm>
+
+bool C3AssetResolver::MountFile(const std::string& path, int priority) {
+    std::string ext = path.size() >= 4 ? path.substr(path.size() - 4) : std::string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    std::shared_ptr<C3Archive> archive;
+    if (ext == ".wdf") {
+        archive = std::make_shared<C3WdfArchive>();
+    }
+    else if (ext == ".dnp") {
+        archive = std::make_shared<C3DnpArchive>();
+    }
+    else if (ext == ".wdz") {
+        archive = std::make_shared<C3WdzArchive>();
+    }
+    else {
+        m_lastError = "Unknown archive type: " + path;
+        return false;
+    }
+
+    if (!archive->Open(path)) {
+        m_lastError = archive->GetLastError();
+        return false;
+    }
+    return Mount(std::move(archive), priority);
+}
+
+bool C3AssetResolver::Mount(std::shared_ptr<C3Archive> archive, int priority) {
+    if (!archive || !archive->IsOpen()) {
+        m_lastError = "Archive is not open";
+        return false;
+    }
+    for (const auto& m : m_mounts) {
+        if (m.archive == archive) {
+            m_lastError = "Archive is already mounted";
+            return false;
+        }
+    }
+
+    uint32_t index = 0;
+    while (index < m_mounts.size() && m_mounts[index].archive) index++;
+    if (index == m_mounts.size()) m_mounts.emplace_back();
+    m_mounts[index] = { archive, priority, m_nextSequence++ };
+    m_mountCount++;
+    UpdateSchemes();
+
+    const uint32_t packId = archive->GetPackId();
+    const size_t count = archive->GetEntryCount();
+    while ((m_entryCount + count) * 2 > m_table.size()) Grow();
+
+    for (size_t i = 0; i < count; i++) {
+        C3Archive::Entry e = archive->GetEntry(i);
+        Insert(MakeKey(packId, e.id), e.offset, e.size, index);
+    }
+    return true;
+}
+
+bool C3AssetResolver::Unmount(const C3Archive* archive) {
+    uint32_t index = 0;
+    while (index < m_mounts.size() && m_mounts[index].archive.get() != archive) index++;
+    if (!archive || index == m_mounts.size()) {
+        m_lastError = "Archive is not mounted";
+        return false;
+    }
+
+    const uint32_t packId = archive->GetPackId();
+    const size_t count = archive->GetEntryCount();
+    const uint32_t mask = static_cast<uint32_t>(m_table.size() - 1);
+
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t key = MakeKey(packId, archive->GetEntry(i).id);
+
+        size_t slot = HomeSlot(key);
+        while (m_table[slot].mount != kEmpty && m_table[slot].key != key) slot = (slot + 1) & mask;
+        if (m_table[slot].mount != index) continue; // Shadowed by another archive, or a duplicate already handled
+
+        // Fall back to the best remaining archive that also holds this key
+        uint32_t best = kEmpty;
+        C3Archive::Entry bestEntry;
+        for (uint32_t m = 0; m < m_mounts.size(); m++) {
+            if (m == index || !m_mounts[m].archive || m_mounts[m].archive->GetPackId() != packId) continue;
+            C3Archive::Entry e;
+            if (m_mounts[m].archive->Find(static_cast<uint32_t>(key), e) && (best == kEmpty || Outranks(m, best))) {
+                best = m;
+                bestEntry = e;
+            }
+        }
+
+        if (best != kEmpty) {
+            m_table[slot].offset = bestEntry.offset;
+            m_table[slot].size = bestEntry.size;
+            m_table[slot].mount = best;
+        }
+        else {
+            EraseSlot(slot);
+        }
+    }
+
+    m_mounts[index] = {};
+    m_mountCount--;
+    UpdateSchemes();
+    return true;
+}
+
+void C3AssetResolver::UnmountAll() {
+    m_mounts.clear();
+    m_schemes.clear();
+    m_table.clear();
+    m_shift = 32;
+    m_entryCount = 0;
+    m_mountCount = 0;
+}
+
+bool C3AssetResolver::Resolve(uint32_t packId, uint32_t fileId, Location& out) const {
+    const Slot* slot = FindSlot(MakeKey(packId, fileId));
+    if (!slot) return false;
+    out = { m_mounts[slot->mount].archive.get(), packId, fileId, slot->offset, slot->size };
+    return true;
+}
+
+bool C3AssetResolver::Resolve(const char* path, Location& out) const {
+    if (!path) return false;
+
+    // Each scheme's slot already holds its best archive for the key. Once a
+    // hit outranks the next scheme's best mount, nothing later can win.
+    const Slot* best = nullptr;
+    for (const auto& scheme : m_schemes) {
+        if (best && Outranks(best->mount, scheme.top)) break;
+        const Slot* slot = FindSlot(MakeKey(scheme.hasher->PackIdFromPath(path), scheme.hasher->FileIdFromPath(path)));
+        if (slot && (!best || Outranks(slot->mount, best->mount))) best = slot;
+    }
+    if (!best) return false;
+
+    out = { m_mounts[best->mount].archive.get(), static_cast<uint32_t>(best->key >> 32),
+        static_cast<uint32_t>(best->key), best->offset, best->size };
+    return true;
+}
+
+bool C3AssetResolver::Exists(const char* path) const {
+    Location loc;
+    return Resolve(path, loc);
+}
+
+std::span<const uint8_t> C3AssetResolver::GetData(const char* path) const {
+    Location loc;
+    if (!Resolve(path, loc)) return {};
+    return loc.archive->GetData(loc.fileId);
+}
+
+bool C3AssetResolver::ReadFile(const char* path, std::vector<uint8_t>& out, std::string* error) const {
+    Location loc;
+    if (!Resolve(path, loc)) {
+        if (error) *error = std::string("Asset not found: ") + (path ? path : "");
+        return false;
+    }
+    return loc.archive->ReadFile(loc.fileId, out, error);
+}
+
+std::vector<const C3Archive*> C3AssetResolver::GetArchives() const {
+    std::vector<const C3Archive*> archives;
+    for (const auto& m : m_mounts) {
+        if (m.archive) archives.push_back(m.archive.get());
+    }
+    return archives;
+}
+
+bool C3AssetResolver::Outranks(uint32_t a, uint32_t b) const {
+    if (m_mounts[a].priority != m_mounts[b].priority) return m_mounts[a].priority > m_mounts[b].priority;
+    return m_mounts[a].sequence > m_mounts[b].sequence;
+}
+
+void C3AssetResolver::UpdateSchemes() {
+    m_schemes.clear();
+    for (uint32_t m = 0; m < m_mounts.size(); m++) {
+        const C3Archive* archive = m_mounts[m].archive.get();
+        if (!archive) continue;
+        auto scheme = std::find_if(m_schemes.begin(), m_schemes.end(),
+            [&](const Scheme& s) { return s.name == archive->GetIdScheme(); });
+        if (scheme == m_schemes.end()) {
+            m_schemes.push_back({ archive->GetIdScheme(), archive, m });
+        }
+        else if (Outranks(m, scheme->top)) {
+            scheme->top = m;
+        }
+    }
+    std::sort(m_schemes.begin(), m_schemes.end(),
+        [&](const Scheme& a, const Scheme& b) { return Outranks(a.top, b.top); });
+}
+
+const C3AssetResolver::Slot* C3AssetResolver::FindSlot(uint64_t key) const {
+    if (m_table.empty()) return nullptr;
+
+    const uint32_t mask = static_cast<uint32_t>(m_table.size() - 1);
+    for (uint32_t slot = HomeSlot(key);; slot = (slot + 1) & mask) {
+        const Slot& s = m_table[slot];
+        if (s.mount == kEmpty) return nullptr;
+        if (s.key == key) return &s;
+    }
+}
+
+void C3AssetResolver::Insert(uint64_t key, uint64_t offset, uint32_t size, uint32_t mount) {
+    const uint32_t mask = static_cast<uint32_t>(m_table.size() - 1);
+    uint32_t slot = HomeSlot(key);
+    while (m_table[slot].mount != kEmpty && m_table[slot].key != key) slot = (slot + 1) & mask;
+
+    Slot& s = m_table[slot];
+    if (s.mount == kEmpty) {
+        s = { key, offset, size, mount };
+        m_entryCount++;
+    }
+    else if (s.mount == mount || Outranks(mount, s.mount)) {
+        s.offset = offset;
+        s.size = size;
+        s.mount = mount;
+    }
+}
+
+void C3AssetResolver::EraseSlot(size_t slot) {
+    // Backward-shift deletion keeps probe chains intact without tombstones
+    const size_t mask = m_table.size() - 1;
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & mask; m_table[next].mount != kEmpty; next = (next + 1) & mask) {
+        size_t home = HomeSlot(m_table[next].key);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            m_table[hole] = m_table[next];
+            hole = next;
+        }
+    }
+    m_table[hole].mount = kEmpty;
+    m_entryCount--;
+}
+
+void C3AssetResolver::Grow() {
+    std::vector<Slot> old = std::move(m_table);
+    size_t capacity = old.empty() ? 1024 : old.size() * 2;
+    m_table.assign(capacity, Slot{ 0, 0, 0, kEmpty });
+
+    m_shift = 32;
+    while ((size_t(1) << (32 - m_shift)) < capacity) m_shift--;
+
+    const uint32_t mask = static_cast<uint32_t>(capacity - 1);
+    for (const Slot& s : old) {
+        if (s.mount == kEmpty) continue;
+        uint32_t slot = HomeSlot(s.key);
+        while (m_table[slot].mount != kEmpty) slot = (slot + 1) & mask;
+        m_table[slot] = s;
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "C3Archive.h"
+#include <memory>
+
+// Merges the indices of every mounted archive into one flat hash table
+// keyed by (pack id, file id). Archives that derive the same ids from a path
+// (WDF and WDZ) share one id scheme; DNP hashes paths differently. A path
+// lookup probes the schemes in order of their best mount and stops at the
+// first hit nothing later can outrank, so a miss costs one probe per scheme
+// however many archives are mounted. When two archives hold the same path,
+// the higher priority wins and ties go to the archive mounted last.
+//
+// Resolve, GetData and ReadFile are const and safe from any number of
+// threads; Mount and Unmount must not overlap with them.
+class C3AssetResolver {
+public:
+    struct Location {
+        const C3Archive* archive = nullptr;
+        uint32_t packId = 0;
+        uint32_t fileId = 0;
+        uint64_t offset = 0;
+        uint32_t size = 0;
+
+        bool IsValid() const { return archive != nullptr; }
+    };
+
+    // Opens a .wdf, .wdz or .dnp by extension and mounts it
+    bool MountFile(const std::string& path, int priority = 0);
+    bool Mount(std::shared_ptr<C3Archive> archive, int priority = 0);
+    // Removes the archive's entries, restoring any it was shadowing
+    bool Unmount(const C3Archive* archive);
+    void UnmountAll();
+
+    bool Resolve(uint32_t packId, uint32_t fileId, Location& out) const;
+    bool Resolve(const char* path, Location& out) const;
+    bool Exists(const char* path) const;
+
+    // Zero-copy view into the owning archive's mapping
+    std::span<const uint8_t> GetData(const char* path) const;
+    bool ReadFile(const char* path, std::vector<uint8_t>& out, std::string* error = nullptr) const;
+
+    size_t GetMountCount() const { return m_mountCount; }
+    size_t GetEntryCount() const { return m_entryCount; }
+    size_t GetCapacity() const { return m_table.size(); }
+    std::vector<const C3Archive*> GetArchives() const;
+    const std::string& GetLastError() const { return m_lastError; }
+
+private:
+    struct MountPoint {
+        std::shared_ptr<C3Archive> archive;
+        int priority = 0;
+        uint64_t sequence = 0;
+    };
+
+    // Mounted archives sharing a path hashing scheme (see C3Archive::GetIdScheme)
+    struct Scheme {
+        std::string name;
+        const C3Archive* hasher = nullptr; // Any mounted archive using it
+        uint32_t top = 0;                  // Its highest ranked mount
+    };
+
+    struct Slot {
+        uint64_t key;    // packId << 32 | fileId
+        uint64_t offset;
+        uint32_t size;
+        uint32_t mount;  // Index into m_mounts, kEmpty if unused
+    };
+    static_assert(sizeof(Slot) == 24, "Resolver slot must be 24 bytes");
+
+    static constexpr uint32_t kEmpty = UINT32_MAX;
+
+    std::vector<MountPoint> m_mounts; // Unmounted entries keep their index with a null archive
+    std::vector<Scheme> m_schemes; // Best ranked first
+    std::vector<Slot> m_table;
+    uint32_t m_shift = 32;
+    size_t m_entryCount = 0;
+    size_t m_mountCount = 0;
+    uint64_t m_nextSequence = 0;
+    std::string m_lastError;
+
+    static uint64_t MakeKey(uint32_t packId, uint32_t fileId) { return (uint64_t(packId) << 32) | fileId; }
+    uint32_t HomeSlot(uint64_t key) const { return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> (32 + m_shift)); }
+
+    bool Outranks(uint32_t a, uint32_t b) const;
+    void UpdateSchemes();
+    const Slot* FindSlot(uint64_t key) const;
+    void Insert(uint64_t key, uint64_t offset, uint32_t size, uint32_t mount);
+    void EraseSlot(size_t slot);
+    void Grow();
+};
@@ -0,0 +1,314 @@
+#include "C3AsyncLoader.h"
+#include "C3DedupStore.h"
+#include "C3Model.h"
+#include "C3VirtualFileSystem.h"
+#include <algorithm>
+
+C3AsyncLoader::Handle& C3AsyncLoader::Handle::operator=(Handle&& other) noexcept {
+    if (this != &other) {
+        Release();
+        m_loader = other.m_loader;
+        m_request = std::move(other.m_request);
+        other.m_loader = nullptr;
+    }
+    return *this;
+}
+
+void C3AsyncLoader::Handle::Release() {
+    if (!m_request) return;
+    {
+        std::lock_guard<std::mutex> lock(m_loader->m_mutex);
+        m_request->interest--;
+    }
+    m_request.reset();
+    m_loader = nullptr;
+}
+
+bool C3AsyncLoader::Handle::IsReady() const {
+    if (!m_request) return false;
+    State state = m_request->state.load(std::memory_order_acquire);
+    return state != State::Queued && state != State::Running;
+}
+
+bool C3AsyncLoader::Handle::IsCancelled() const {
+    return m_request && m_request->state.load(std::memory_order_acquire) == State::Cancelled;
+}
+
+bool C3AsyncLoader::Handle::Wait() {
+    if (!m_request) return false;
+    Request& request = *m_request;
+    std::unique_lock<std::mutex> lock(m_loader->m_mutex);
+    if (request.state.load(std::memory_order_relaxed) == State::Queued) {
+        // Nobody has started it, so rather than wait for a worker to reach
+        // it, load it here; its queue entries go stale
+        if (request.priority != Priority::Immediate) m_loader->m_stats.promoted++;
+        request.priority = Priority::Immediate;
+        request.state.store(State::Running, std::memory_order_relaxed);
+        m_loader->m_queued--;
+        m_loader->m_running++;
+        m_loader->m_stats.inlineLoads++;
+        lock.unlock();
+        m_loader->Run(request);
+        return request.state.load(std::memory_order_acquire) == State::Done;
+    }
+    m_loader->m_finished.wait(lock, [this] { return IsReady(); });
+    return request.state.load(std::memory_order_acquire) == State::Done;
+}
+
+void C3AsyncLoader::Handle::Promote(Priority priority) {
+    if (!m_request) return;
+    std::lock_guard<std::mutex> lock(m_loader->m_mutex);
+    m_loader->PromoteLocked(*m_request, priority);
+}
+
+void C3AsyncLoader::Handle::Cancel() {
+    if (!m_request) return;
+    {
+        std::lock_guard<std::mutex> lock(m_loader->m_mutex);
+        if (--m_request->interest == 0) m_loader->CancelLocked(*m_request);
+    }
+    m_loader->m_finished.notify_all();
+    m_request.reset();
+    m_loader = nullptr;
+}
+
+std::shared_ptr<const C3Model> C3AsyncLoader::Handle::GetModel() const {
+    if (!m_request || m_request->kind == Kind::Texture ||
+        m_request->state.load(std::memory_order_acquire) != State::Done) return nullptr;
+    return std::static_pointer_cast<const C3Model>(m_request->value);
+}
+
+std::shared_ptr<const C3AssetCache::Blob> C3AsyncLoader::Handle::GetTexture() const {
+    if (!m_request || m_request->kind != Kind::Texture ||
+        m_request->state.load(std::memory_order_acquire) != State::Done) return nullptr;
+    return std::static_pointer_cast<const C3AssetCache::Blob>(m_request->value);
+}
+
+const std::string& C3AsyncLoader::Handle::GetError() const {
+    static const std::string empty;
+    return IsReady() ? m_request->error : empty;
+}
+
+const std::string& C3AsyncLoader::Handle::GetPath() const {
+    static const std::string empty;
+    return m_request ? m_request->path : empty;
+}
+
+C3AsyncLoader::C3AsyncLoader(C3VirtualFileSystem& vfs, C3AssetCache* cache, unsigned workers)
+    : m_vfs(vfs), m_cache(cache) {
+    if (workers == 0) workers = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < workers; i++) {
+        m_workers.emplace_back(&C3AsyncLoader::WorkerLoop, this);
+    }
+}
+
+C3AsyncLoader::~C3AsyncLoader() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    CancelAll();
+    m_wake.notify_all();
+    for (auto& worker : m_workers) worker.join();
+    // Loads running inline on waiting threads still report here
+    WaitIdle();
+}
+
+C3AsyncLoader::Handle C3AsyncLoader::LoadModel(const std::string& path, Priority priority, Kind kind) {
+    return Submit(path, kind == Kind::Texture ? Kind::Model : kind, priority);
+}
+
+C3AsyncLoader::Handle C3AsyncLoader::LoadTexture(const std::string& path, Priority priority) {
+    return Submit(path, Kind::Texture, priority);
+}
+
+C3AsyncLoader::Handle C3AsyncLoader::Submit(const std::string& path, Kind kind, Priority priority) {
+    const C3AssetCache::Key key = C3AssetCache::KeyForPath(path);
+
+    std::shared_ptr<const void> cached;
+    if (m_cache) {
+        if (kind == Kind::Texture) cached = m_cache->GetTexture(key);
+        else cached = m_cache->GetModel(key, kind);
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stats.requested++;
+
+    if (cached) {
+        auto request = std::make_shared<Request>();
+        request->key = key;
+        request->path = path;
+        request->kind = kind;
+        request->value = std::move(cached);
+        request->interest = 1;
+        request->state.store(State::Done, std::memory_order_relaxed);
+        m_stats.cacheHits++;
+        return Handle(this, std::move(request));
+    }
+
+    auto found = m_inFlight.find(key);
+    if (found != m_inFlight.end() && found->second->kind == kind) {
+        Request& request = *found->second;
+        request.interest++;
+        PromoteLocked(request, priority);
+        m_stats.merged++;
+        return Handle(this, found->second);
+    }
+
+    auto request = std::make_shared<Request>();
+    request->key = key;
+    request->path = path;
+    request->kind = kind;
+    request->priority = priority;
+    request->interest = 1;
+    if (m_stopping) {
+        request->error = "Loader is shutting down";
+        request->state.store(State::Cancelled, std::memory_order_relaxed);
+        m_stats.cancelled++;
+        return Handle(this, std::move(request));
+    }
+
+    // A request of another kind for the same path loads separately and is
+    // not merged into
+    if (found == m_inFlight.end()) m_inFlight.emplace(key, request);
+    m_queues[size_t(priority)].push_back({ request, priority });
+    m_queued++;
+    lock.unlock();
+    m_wake.notify_one();
+    return Handle(this, std::move(request));
+}
+
+void C3AsyncLoader::PromoteLocked(Request& request, Priority priority) {
+    if (request.state.load(std::memory_order_relaxed) != State::Queued || priority >= request.priority) return;
+    // The old entry stays behind and is skipped when popped
+    request.priority = priority;
+    m_queues[size_t(priority)].push_back({ request.shared_from_this(), priority });
+    m_stats.promoted++;
+}
+
+void C3AsyncLoader::CancelLocked(Request& request) {
+    if (request.state.load(std::memory_order_relaxed) != State::Queued) return;
+    request.error = "Cancelled";
+    request.state.store(State::Cancelled, std::memory_order_release);
+    m_queued--;
+    m_stats.cancelled++;
+    auto it = m_inFlight.find(request.key);
+    if (it != m_inFlight.end() && it->second.get() == &request) m_inFlight.erase(it);
+}
+
+std::shared_ptr<C3AsyncLoader::Request> C3AsyncLoader::PopLocked() {
+    for (auto& queue : m_queues) {
+        while (!queue.empty()) {
+            QueueEntry entry = std::move(queue.front());
+            queue.pop_front();
+            if (entry.request->state.load(std::memory_order_relaxed) == State::Queued &&
+                entry.request->priority == entry.priority) {
+                return std::move(entry.request);
+            }
+        }
+    }
+    return nullptr;
+}
+
+void C3AsyncLoader::Run(Request& request) {
+    C3DedupStore* dedup = m_dedup.load(std::memory_order_acquire);
+    std::shared_ptr<const void> value;
+    std::string error;
+    if (request.kind == Kind::Texture) {
+        C3AssetCache::Blob bytes;
+        if (m_vfs.ReadFile(request.path, bytes, &error)) {
+            std::shared_ptr<const C3AssetCache::Blob> blob;
+            if (dedup) {
+                blob = dedup->InternBlob(std::move(bytes));
+            }
+            else {
+                bytes.shrink_to_fit();
+                blob = std::make_shared<const C3AssetCache::Blob>(std::move(bytes));
+            }
+            if (m_cache) m_cache->PutTexture(request.key, blob);
+            value = std::move(blob);
+        }
+    }
+    else {
+        C3VirtualFileSystem::FileData file;
+        if (m_vfs.Open(request.path, file, &error)) {
+            std::shared_ptr<const C3Model> model;
+            if (dedup) {
+                model = dedup->InternModel({ file.Data(), file.Size() }, &error);
+            }
+            else {
+                auto parsed = std::make_shared<C3Model>();
+                if (parsed->LoadFromMemory(file.Data(), file.Size())) model = std::move(parsed);
+                else error = parsed->GetError();
+            }
+            if (model && m_cache) m_cache->PutModel(request.key, model, request.kind);
+            value = std::move(model);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        request.value = std::move(value);
+        request.error = std::move(error);
+        Finish(request, request.value ? State::Done : State::Failed);
+    }
+    m_finished.notify_all();
+}
+
+void C3AsyncLoader::Finish(Request& request, State state) {
+    if (state == State::Done) m_stats.loaded++;
+    else m_stats.failed++;
+    m_running--;
+    auto it = m_inFlight.find(request.key);
+    if (it != m_inFlight.end() && it->second.get() == &request) m_inFlight.erase(it);
+    request.state.store(state, std::memory_order_release);
+}
+
+void C3AsyncLoader::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this] { return m_stopping || m_queued > 0; });
+        if (m_stopping) return;
+
+        std::shared_ptr<Request> request = PopLocked();
+        if (!request) continue;
+        request->state.store(State::Running, std::memory_order_relaxed);
+        m_queued--;
+        m_running++;
+
+        lock.unlock();
+        Run(*request);
+        lock.lock();
+    }
+}
+
+void C3AsyncLoader::CancelAll() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& queue : m_queues) {
+            for (auto& entry : queue) CancelLocked(*entry.request);
+            queue.clear();
+        }
+    }
+    m_finished.notify_all();
+}
+
+void C3AsyncLoader::WaitIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finished.wait(lock, [this] { return m_queued == 0 && m_running == 0; });
+}
+
+size_t C3AsyncLoader::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queued + m_running;
+}
+
+C3AsyncLoader::Stats C3AsyncLoader::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void C3AsyncLoader::ResetStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats = {};
+}
@@ -0,0 +1,165 @@
+#pragma once
+#include "C3AssetCache.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class C3DedupStore;
+class C3Model;
+class C3VirtualFileSystem;
+
+// Loads models and textures on worker threads, highest priority first.
+// Every request returns a Handle the caller can poll or block on. Blocking
+// on a request that no worker has started yet promotes it to Immediate
+// and loads it on the calling thread, so a wait never sits behind
+// background work. Requests for a path already in flight are merged into
+// the same load, and with a cache attached, finished assets are inserted
+// there and later requests for them complete at once.
+//
+// Replaces the synchronous EXIGENCE_IMMEDIATE / background split of
+// CGameDataSet::GetDataAni. Handles must not be used after the loader is
+// destroyed, and the loader must be destroyed before the file system
+// it reads from.
+class C3AsyncLoader {
+public:
+    enum class Priority : uint8_t {
+        Immediate,  // Someone is about to block on it
+        High,
+        Normal,
+        Background, // Preloading
+    };
+    static constexpr size_t kPriorityCount = 4;
+
+    using Kind = C3AssetCache::Kind;
+
+    struct Stats {
+        uint64_t requested = 0;
+        uint64_t merged = 0;      // Joined a load already in flight
+        uint64_t cacheHits = 0;   // Completed from the cache without loading
+        uint64_t loaded = 0;
+        uint64_t failed = 0;
+        uint64_t cancelled = 0;
+        uint64_t promoted = 0;    // Moved to a higher priority while queued
+        uint64_t inlineLoads = 0; // Loaded on a waiting thread instead of a worker
+    };
+
+private:
+    enum class State : uint8_t { Queued, Running, Done, Failed, Cancelled };
+
+    struct Request : std::enable_shared_from_this<Request> {
+        C3AssetCache::Key key = 0;
+        std::string path;
+        Kind kind = Kind::Model;
+        Priority priority = Priority::Normal;
+        std::atomic<State> state{ State::Queued };
+        unsigned interest = 0; // Live handles that have not cancelled
+        std::shared_ptr<const void> value;
+        std::string error;
+    };
+
+public:
+    // Move-only; dropping a handle leaves the load running. Results are
+    // immutable once IsReady() returns true.
+    class Handle {
+    public:
+        Handle() = default;
+        Handle(Handle&& other) noexcept { *this = std::move(other); }
+        Handle& operator=(Handle&& other) noexcept;
+        ~Handle() { Release(); }
+
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+
+        bool IsValid() const { return m_request != nullptr; }
+        // Finished, failed or cancelled
+        bool IsReady() const;
+        bool IsCancelled() const;
+
+        // Blocks until the request finishes, loading it here if no worker
+        // has picked it up yet. True if the asset loaded.
+        bool Wait();
+        // Raises the priority of a queued request; never lowers it
+        void Promote(Priority priority);
+        // Gives up this handle's interest and empties it. The load is
+        // cancelled if it has not started and no other handle wants it.
+        void Cancel();
+
+        // Null until ready, on failure, or when the request was for the other type
+        std::shared_ptr<const C3Model> GetModel() const;
+        std::shared_ptr<const C3AssetCache::Blob> GetTexture() const;
+        // Empty unless the request failed or was cancelled
+        const std::string& GetError() const;
+        const std::string& GetPath() const;
+
+    private:
+        friend class C3AsyncLoader;
+        Handle(C3AsyncLoader* loader, std::shared_ptr<Request> request)
+            : m_loader(loader), m_request(std::move(request)) {}
+        void Release();
+
+        C3AsyncLoader* m_loader = nullptr;
+        std::shared_ptr<Request> m_request;
+    };
+
+    // 'cache' may be null; 0 workers means one per hardware thread
+    explicit C3AsyncLoader(C3VirtualFileSystem& vfs, C3AssetCache* cache = nullptr, unsigned workers = 0);
+    // Cancels queued requests and waits for running ones
+    ~C3AsyncLoader();
+
+    C3AsyncLoader(const C3AsyncLoader&) = delete;
+    C3AsyncLoader& operator=(const C3AsyncLoader&) = delete;
+
+    Handle LoadModel(const std::string& path, Priority priority = Priority::Normal, Kind kind = Kind::Model);
+    Handle LoadTexture(const std::string& path, Priority priority = Priority::Normal);
+
+    // Loads from then on are interned by content, so files with identical
+    // bytes share one object and repeats skip parsing; null turns it off
+    void SetDedupStore(C3DedupStore* store) { m_dedup.store(store, std::memory_order_release); }
+
+    // Cancels every request not yet started; running loads finish
+    void CancelAll();
+    // Blocks until nothing is queued or running
+    void WaitIdle();
+
+    size_t GetPendingCount() const;
+    unsigned GetWorkerCount() const { return static_cast<unsigned>(m_workers.size()); }
+    Stats GetStats() const;
+    void ResetStats();
+
+private:
+    struct QueueEntry {
+        std::shared_ptr<Request> request;
+        Priority priority; // Stale once the request is promoted past it
+    };
+
+    C3VirtualFileSystem& m_vfs;
+    C3AssetCache* m_cache;
+    std::atomic<C3DedupStore*> m_dedup{ nullptr };
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;     // Work queued or stopping
+    std::condition_variable m_finished; // A request reached a final state
+    std::deque<QueueEntry> m_queues[kPriorityCount];
+    std::unordered_map<C3AssetCache::Key, std::shared_ptr<Request>> m_inFlight;
+    size_t m_queued = 0;
+    size_t m_running = 0;
+    bool m_stopping = false;
+    Stats m_stats;
+    std::vector<std::thread> m_workers;
+
+    Handle Submit(const std::string& path, Kind kind, Priority priority);
+    // Takes the highest-priority live request; the caller holds the lock
+    std::shared_ptr<Request> PopLocked();
+    void PromoteLocked(Request& request, Priority priority);
+    void CancelLocked(Request& request);
+    // Loads without the lock held, then publishes the result
+    void Run(Request& request);
+    void Finish(Request& request, State state);
+    void WorkerLoop();
+};
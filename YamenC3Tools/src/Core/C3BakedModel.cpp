@@ -0,0 +1,322 @@
+#include "C3BakedModel.h"
+#include "C3ArchiveVerifier.h"
+#include "C3Model.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Accumulates the string table and the data blocks while records are filled in
+class Builder {
+public:
+    C3BakedModel::StringRef AddString(const std::string& s) {
+        C3BakedModel::StringRef ref{ static_cast<uint32_t>(m_strings.size()), static_cast<uint32_t>(s.size()) };
+        m_strings.insert(m_strings.end(), s.begin(), s.end());
+        return ref;
+    }
+
+    template <typename T>
+    C3BakedModel::BlockRef AddBlock(const T* items, size_t count) {
+        C3BakedModel::BlockRef ref{};
+        ref.count = static_cast<uint32_t>(count);
+        if (count == 0) return ref;
+        m_data.resize(AlignUp(m_data.size(), C3BakedModel::kAlignment));
+        ref.offset = m_data.size();
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(items);
+        m_data.insert(m_data.end(), bytes, bytes + count * sizeof(T));
+        return ref;
+    }
+
+    // One field of every vertex, gathered into its own stream
+    template <typename T, typename Get>
+    C3BakedModel::BlockRef AddStream(const std::vector<PhyVertex>& vertices, Get get) {
+        std::vector<T> stream(vertices.size());
+        for (size_t i = 0; i < vertices.size(); i++) stream[i] = get(vertices[i]);
+        return AddBlock(stream.data(), stream.size());
+    }
+
+    void AddMesh(const C3Model::MeshPart& mesh, int32_t parent) {
+        C3BakedModel::MeshRecord record{};
+        record.name = AddString(mesh.name);
+        record.texture = AddString(mesh.textureName);
+        record.parent = parent;
+        record.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+        record.textureRow = mesh.textureRow;
+        record.blendCount = mesh.blendCount;
+        record.bboxMin = mesh.bboxMin;
+        record.bboxMax = mesh.bboxMax;
+        record.initialMatrix = mesh.initialMatrix;
+
+        const auto& v = mesh.vertices;
+        for (int k = 0; k < 4; k++) {
+            record.positions[k] = AddStream<XMFLOAT3>(v, [k](const PhyVertex& p) { return p.positions[k]; });
+        }
+        record.uvs = AddStream<XMFLOAT2>(v, [](const PhyVertex& p) { return XMFLOAT2(p.u, p.v); });
+        record.colors = AddStream<uint32_t>(v, [](const PhyVertex& p) { return p.color; });
+        record.boneIndices = AddStream<XMUINT2>(v, [](const PhyVertex& p) { return XMUINT2(p.boneIndices[0], p.boneIndices[1]); });
+        record.boneWeights = AddStream<XMFLOAT2>(v, [](const PhyVertex& p) { return XMFLOAT2(p.boneWeights[0], p.boneWeights[1]); });
+        record.normalIndices = AddBlock(mesh.normalIndices.data(), mesh.normalIndices.size());
+        record.alphaIndices = AddBlock(mesh.alphaIndices.data(), mesh.alphaIndices.size());
+        record.alphaKeys = AddBlock(mesh.alphaKeyframes.data(), mesh.alphaKeyframes.size());
+        record.drawKeys = AddBlock(mesh.drawKeyframes.data(), mesh.drawKeyframes.size());
+
+        const int32_t index = static_cast<int32_t>(meshes.size());
+        meshes.push_back(record);
+        for (const auto& lod : mesh.lods) AddMesh(lod, index);
+    }
+
+    std::vector<C3BakedModel::MeshRecord> meshes;
+    std::vector<C3BakedModel::ShapeRecord> shapes;
+    std::vector<C3BakedModel::LineRecord> lines;
+    std::vector<C3BakedModel::ParticleRecord> particles;
+    std::vector<C3BakedModel::BoneRecord> bones;
+    std::vector<C3BakedModel::AnimationRecord> animations;
+    std::vector<C3BakedModel::KeyFrameRecord> keyFrames;
+
+    const std::vector<char>& GetStrings() const { return m_strings; }
+    const std::vector<uint8_t>& GetData() const { return m_data; }
+
+private:
+    std::vector<char> m_strings;
+    std::vector<uint8_t> m_data;
+};
+
+bool InRange(uint64_t offset, uint64_t size, uint64_t limit) {
+    return offset <= limit && size <= limit - offset;
+}
+
+} // namespace
+
+uint64_t C3BakedModel::SourceChecksum(const uint8_t* data, size_t size) {
+    return C3ArchiveVerifier::Checksum(data, size);
+}
+
+bool C3BakedModel::Write(const C3Model& model, const std::string& path, uint64_t sourceChecksum, std::string* error) {
+    Builder builder;
+    for (const auto& mesh : model.GetMeshes()) builder.AddMesh(mesh, -1);
+
+    for (const auto& shape : model.GetShapes()) {
+        ShapeRecord record{};
+        record.name = builder.AddString(shape.name);
+        record.texture = builder.AddString(shape.textureName);
+        record.segmentCount = shape.segmentCount;
+        record.firstLine = static_cast<uint32_t>(builder.lines.size());
+        record.lineCount = static_cast<uint32_t>(shape.lines.size());
+        for (const auto& line : shape.lines) builder.lines.push_back({ builder.AddBlock(line.points.data(), line.points.size()) });
+        builder.shapes.push_back(record);
+    }
+
+    for (const auto& particle : model.GetParticles()) {
+        ParticleRecord record{};
+        record.name = builder.AddString(particle.name);
+        record.texture = builder.AddString(particle.textureName);
+        record.emitterPos = particle.emitterPos;
+        record.emitRate = particle.emitRate;
+        record.lifetime = particle.lifetime;
+        record.speed = particle.speed;
+        record.size = particle.size;
+        record.startColor = particle.startColor;
+        record.endColor = particle.endColor;
+        record.maxParticles = particle.maxParticles;
+        builder.particles.push_back(record);
+    }
+
+    for (const auto& bone : model.GetBones()) {
+        BoneRecord record{};
+        record.bindMatrix = bone.bindMatrix;
+        record.invBindMatrix = bone.invBindMatrix;
+        record.name = builder.AddString(bone.name);
+        record.parentIndex = bone.parentIndex;
+        builder.bones.push_back(record);
+    }
+
+    for (const auto& animation : model.GetAnimations()) {
+        AnimationRecord record{};
+        record.name = builder.AddString(animation.name);
+        record.boneCount = animation.boneCount;
+        record.frameCount = animation.frameCount;
+        record.keyFrameCount = animation.keyFrameCount;
+        record.morphCount = animation.morphCount;
+        record.firstKeyFrame = static_cast<uint32_t>(builder.keyFrames.size());
+        record.keyFrameRecords = static_cast<uint32_t>(animation.keyFrames.size());
+        record.morphWeights = builder.AddBlock(animation.morphWeights.data(), animation.morphWeights.size());
+        for (const auto& keyFrame : animation.keyFrames) {
+            KeyFrameRecord key{};
+            key.frame = keyFrame.frame;
+            key.boneMatrices = builder.AddBlock(keyFrame.boneMatrices.data(), keyFrame.boneMatrices.size());
+            builder.keyFrames.push_back(key);
+        }
+        builder.animations.push_back(record);
+    }
+
+    FileHeader header{};
+    memcpy(header.magic, "C3BK", 4);
+    header.version = kVersion;
+    header.modelType = static_cast<uint32_t>(model.GetType());
+    header.sectionCount = kSectionCount;
+    header.sourceChecksum = sourceChecksum;
+    header.boundsMin = model.GetBoundsMin();
+    header.boundsMax = model.GetBoundsMax();
+    header.center = model.GetCenter();
+    header.radius = model.GetRadius();
+
+    // Lay the sections out in order, each on its own aligned boundary
+    struct Payload {
+        const void* data;
+        size_t count;
+        size_t stride;
+    };
+    const Payload payloads[kSectionCount] = {
+        { builder.meshes.data(), builder.meshes.size(), sizeof(MeshRecord) },
+        { builder.shapes.data(), builder.shapes.size(), sizeof(ShapeRecord) },
+        { builder.lines.data(), builder.lines.size(), sizeof(LineRecord) },
+        { builder.particles.data(), builder.particles.size(), sizeof(ParticleRecord) },
+        { builder.bones.data(), builder.bones.size(), sizeof(BoneRecord) },
+        { builder.animations.data(), builder.animations.size(), sizeof(AnimationRecord) },
+        { builder.keyFrames.data(), builder.keyFrames.size(), sizeof(KeyFrameRecord) },
+        { builder.GetStrings().data(), builder.GetStrings().size(), 1 },
+        { builder.GetData().data(), builder.GetData().size(), 1 },
+    };
+    uint64_t offset = sizeof(FileHeader);
+    for (uint32_t s = 0; s < kSectionCount; s++) {
+        if (payloads[s].count > UINT32_MAX) {
+            if (error) *error = "Model too large to bake";
+            return false;
+        }
+        offset = AlignUp(offset, kAlignment);
+        header.sections[s] = { offset, payloads[s].count * payloads[s].stride,
+            static_cast<uint32_t>(payloads[s].count), static_cast<uint32_t>(payloads[s].stride) };
+        offset += header.sections[s].size;
+    }
+    header.fileSize = offset;
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        if (error) *error = "Failed to create baked model: " + path;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t written = sizeof(header);
+    static const char zeros[kAlignment] = {};
+    for (uint32_t s = 0; s < kSectionCount; s++) {
+        file.write(zeros, static_cast<std::streamsize>(header.sections[s].offset - written));
+        file.write(static_cast<const char*>(payloads[s].data), static_cast<std::streamsize>(header.sections[s].size));
+        written = header.sections[s].offset + header.sections[s].size;
+    }
+    if (!file) {
+        if (error) *error = "Failed to write baked model: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool C3BakedModel::Open(const std::string& path) {
+    Close();
+    if (!m_file.Open(path)) {
+        m_lastError = m_file.GetLastError();
+        return false;
+    }
+    if (!Validate()) {
+        m_lastError += ": " + path;
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void C3BakedModel::Close() {
+    m_file.Close();
+    m_header = nullptr;
+    m_data = nullptr;
+    m_strings = nullptr;
+}
+
+bool C3BakedModel::Validate() {
+    const uint8_t* base = m_file.Data();
+    const uint64_t size = m_file.Size();
+    if (size < sizeof(FileHeader) || memcmp(base, "C3BK", 4) != 0) {
+        m_lastError = "Not a baked model";
+        return false;
+    }
+    const FileHeader& header = *reinterpret_cast<const FileHeader*>(base);
+    if (header.version != kVersion || header.sectionCount != kSectionCount) {
+        m_lastError = "Unsupported baked model version " + std::to_string(header.version);
+        return false;
+    }
+    if (header.fileSize != size) {
+        m_lastError = "Truncated baked model";
+        return false;
+    }
+
+    static constexpr uint32_t kStrides[kSectionCount] = {
+        sizeof(MeshRecord), sizeof(ShapeRecord), sizeof(LineRecord), sizeof(ParticleRecord),
+        sizeof(BoneRecord), sizeof(AnimationRecord), sizeof(KeyFrameRecord), 1, 1,
+    };
+    for (uint32_t s = 0; s < kSectionCount; s++) {
+        const Section& section = header.sections[s];
+        if (section.stride != kStrides[s] || section.size != uint64_t(section.count) * section.stride ||
+            section.offset % kAlignment != 0 || !InRange(section.offset, section.size, size)) {
+            m_lastError = "Corrupt baked model section table";
+            return false;
+        }
+    }
+
+    const uint64_t stringBytes = header.sections[Strings].size;
+    const uint64_t dataBytes = header.sections[Data].size;
+    auto stringOk = [&](const StringRef& ref) { return InRange(ref.offset, ref.length, stringBytes); };
+    auto blockOk = [&](const BlockRef& block, size_t elementSize) {
+        return block.count == 0 || (block.offset % alignof(float) == 0 &&
+            InRange(block.offset, uint64_t(block.count) * elementSize, dataBytes));
+    };
+    auto fail = [&] {
+        m_lastError = "Corrupt baked model records";
+        return false;
+    };
+
+    m_header = &header;
+    m_data = base + header.sections[Data].offset;
+    m_strings = reinterpret_cast<const char*>(base + header.sections[Strings].offset);
+
+    // Records are few; the blocks they point at are checked by range, not walked
+    auto meshes = GetMeshes();
+    for (size_t i = 0; i < meshes.size(); i++) {
+        const MeshRecord& mesh = meshes[i];
+        const uint32_t n = mesh.vertexCount;
+        bool ok = stringOk(mesh.name) && stringOk(mesh.texture) && mesh.parent < int32_t(i) && mesh.parent >= -1;
+        for (const BlockRef& positions : mesh.positions) ok = ok && positions.count == n && blockOk(positions, sizeof(XMFLOAT3));
+        ok = ok && mesh.uvs.count == n && blockOk(mesh.uvs, sizeof(XMFLOAT2)) &&
+            mesh.colors.count == n && blockOk(mesh.colors, sizeof(uint32_t)) &&
+            mesh.boneIndices.count == n && blockOk(mesh.boneIndices, sizeof(XMUINT2)) &&
+            mesh.boneWeights.count == n && blockOk(mesh.boneWeights, sizeof(XMFLOAT2)) &&
+            blockOk(mesh.normalIndices, sizeof(uint16_t)) && blockOk(mesh.alphaIndices, sizeof(uint16_t)) &&
+            blockOk(mesh.alphaKeys, sizeof(C3KeyFrame)) && blockOk(mesh.drawKeys, sizeof(C3KeyFrame));
+        if (!ok) return fail();
+    }
+    const uint32_t lineCount = header.sections[Lines].count;
+    for (const ShapeRecord& shape : GetShapes()) {
+        if (!stringOk(shape.name) || !stringOk(shape.texture) || !InRange(shape.firstLine, shape.lineCount, lineCount)) return fail();
+    }
+    for (const LineRecord& line : GetLines()) {
+        if (!blockOk(line.points, sizeof(XMFLOAT3))) return fail();
+    }
+    for (const ParticleRecord& particle : GetParticles()) {
+        if (!stringOk(particle.name) || !stringOk(particle.texture)) return fail();
+    }
+    for (const BoneRecord& bone : GetBones()) {
+        if (!stringOk(bone.name)) return fail();
+    }
+    const uint32_t keyFrameCount = header.sections[KeyFrames].count;
+    for (const AnimationRecord& animation : GetAnimations()) {
+        if (!stringOk(animation.name) || !InRange(animation.firstKeyFrame, animation.keyFrameRecords, keyFrameCount) ||
+            !blockOk(animation.morphWeights, sizeof(float))) return fail();
+    }
+    for (const KeyFrameRecord& keyFrame : GetKeyFrames()) {
+        if (!blockOk(keyFrame.boneMatrices, sizeof(XMFLOAT4X4))) return fail();
+    }
+    return true;
+}
@@ -0,0 +1,199 @@
+#pragma once
+#include "C3MappedFile.h"
+#include "C3Types.h"
+#include <span>
+#include <string>
+#include <string_view>
+
+class C3Model;
+
+// Baked, memory-mappable form of a C3Model ("<file>.c3bk"). Everything a
+// model holds is laid out as fixed-size records plus 64-byte aligned data
+// blocks: vertex attributes as separate streams (SoA), index and keyframe
+// arrays, bone matrices. Records refer to blocks and strings by offsets
+// relative to their section, and sections are listed in an offset table in
+// the header, so the file can be mapped anywhere. Open() maps the file and
+// checks every record's ranges once; after that, streams are spans straight
+// into the mapping with no per-field decoding.
+//
+// C3Model::SaveBaked() writes one and C3Model::LoadBaked() copies one back
+// into a regular model. Renderers that only upload vertex data can read
+// the streams here directly.
+class C3BakedModel {
+public:
+    enum SectionId : uint32_t {
+        Meshes,     // MeshRecord[], LODs follow their parent
+        Shapes,     // ShapeRecord[]
+        Lines,      // LineRecord[]
+        Particles,  // ParticleRecord[]
+        Bones,      // BoneRecord[]
+        Animations, // AnimationRecord[]
+        KeyFrames,  // KeyFrameRecord[]
+        Strings,    // char[], not terminated
+        Data,       // Aligned blocks
+        kSectionCount
+    };
+
+#pragma pack(push, 1)
+    struct Section {
+        uint64_t offset; // From the start of the file
+        uint64_t size;   // Bytes
+        uint32_t count;  // Records; bytes for Strings and Data
+        uint32_t stride; // Record size, 1 for Strings and Data
+    };
+
+    struct FileHeader {
+        char magic[4]; // "C3BK"
+        uint32_t version;
+        uint32_t modelType; // C3ChunkType
+        uint32_t sectionCount;
+        uint64_t fileSize;
+        uint64_t sourceChecksum; // Of the .c3 bytes it was baked from; 0 if unknown
+        XMFLOAT3 boundsMin;
+        XMFLOAT3 boundsMax;
+        XMFLOAT3 center;
+        float radius;
+        Section sections[kSectionCount];
+    };
+
+    struct StringRef {
+        uint32_t offset; // Into Strings
+        uint32_t length;
+    };
+
+    struct BlockRef {
+        uint64_t offset; // Into Data, kAlignment aligned
+        uint32_t count;  // Elements
+        uint32_t reserved;
+    };
+
+    struct MeshRecord {
+        StringRef name;
+        StringRef texture;
+        int32_t parent; // Mesh this is a LOD of, always earlier; -1 at top level
+        uint32_t vertexCount;
+        uint32_t textureRow;
+        uint32_t blendCount;
+        XMFLOAT3 bboxMin;
+        XMFLOAT3 bboxMax;
+        XMFLOAT4X4 initialMatrix;
+        BlockRef positions[4]; // XMFLOAT3 per vertex, one stream per morph target
+        BlockRef uvs;          // XMFLOAT2
+        BlockRef colors;       // uint32_t
+        BlockRef boneIndices;  // uint32_t[2]
+        BlockRef boneWeights;  // float[2]
+        BlockRef normalIndices; // uint16_t
+        BlockRef alphaIndices;  // uint16_t
+        BlockRef alphaKeys;     // C3KeyFrame
+        BlockRef drawKeys;      // C3KeyFrame
+    };
+
+    struct ShapeRecord {
+        StringRef name;
+        StringRef texture;
+        uint32_t segmentCount;
+        uint32_t firstLine;
+        uint32_t lineCount;
+    };
+
+    struct LineRecord {
+        BlockRef points; // XMFLOAT3
+    };
+
+    struct ParticleRecord {
+        StringRef name;
+        StringRef texture;
+        XMFLOAT3 emitterPos;
+        float emitRate;
+        float lifetime;
+        float speed;
+        XMFLOAT3 size;
+        XMFLOAT4 startColor;
+        XMFLOAT4 endColor;
+        uint32_t maxParticles;
+    };
+
+    struct BoneRecord {
+        XMFLOAT4X4 bindMatrix;
+        XMFLOAT4X4 invBindMatrix;
+        StringRef name;
+        int32_t parentIndex;
+    };
+
+    struct AnimationRecord {
+        StringRef name;
+        uint32_t boneCount;
+        uint32_t frameCount;
+        uint32_t keyFrameCount;
+        uint32_t morphCount;
+        uint32_t firstKeyFrame; // Into KeyFrames
+        uint32_t keyFrameRecords;
+        BlockRef morphWeights;  // float
+    };
+
+    struct KeyFrameRecord {
+        uint32_t frame;
+        uint32_t reserved;
+        BlockRef boneMatrices; // XMFLOAT4X4
+    };
+#pragma pack(pop)
+
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kAlignment = 64;
+
+    C3BakedModel() = default;
+    C3BakedModel(const C3BakedModel&) = delete;
+    C3BakedModel& operator=(const C3BakedModel&) = delete;
+
+    static std::string GetBakedPath(const std::string& c3Path) { return c3Path + ".c3bk"; }
+    // Checksum to store as the source, so stale bakes can be detected
+    static uint64_t SourceChecksum(const uint8_t* data, size_t size);
+
+    static bool Write(const C3Model& model, const std::string& path, uint64_t sourceChecksum = 0,
+        std::string* error = nullptr);
+
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return m_header != nullptr; }
+
+    C3ChunkType GetType() const { return static_cast<C3ChunkType>(m_header->modelType); }
+    const FileHeader& GetHeader() const { return *m_header; }
+    uint64_t GetSourceChecksum() const { return m_header ? m_header->sourceChecksum : 0; }
+
+    std::span<const MeshRecord> GetMeshes() const { return Records<MeshRecord>(Meshes); }
+    std::span<const ShapeRecord> GetShapes() const { return Records<ShapeRecord>(Shapes); }
+    std::span<const LineRecord> GetLines() const { return Records<LineRecord>(Lines); }
+    std::span<const ParticleRecord> GetParticles() const { return Records<ParticleRecord>(Particles); }
+    std::span<const BoneRecord> GetBones() const { return Records<BoneRecord>(Bones); }
+    std::span<const AnimationRecord> GetAnimations() const { return Records<AnimationRecord>(Animations); }
+    std::span<const KeyFrameRecord> GetKeyFrames() const { return Records<KeyFrameRecord>(KeyFrames); }
+
+    // Element type must match the block's documented type; ranges were checked by Open()
+    template <typename T>
+    std::span<const T> GetBlock(const BlockRef& block) const {
+        return { reinterpret_cast<const T*>(m_data + block.offset), block.count };
+    }
+    std::string_view GetString(const StringRef& ref) const {
+        return { m_strings + ref.offset, ref.length };
+    }
+
+    size_t GetFileSize() const { return m_file.Size(); }
+    const std::string& GetLastError() const { return m_lastError; }
+
+private:
+    template <typename T>
+    std::span<const T> Records(SectionId id) const {
+        if (!m_header) return {};
+        const Section& section = m_header->sections[id];
+        return { reinterpret_cast<const T*>(m_file.Data() + section.offset), section.count };
+    }
+
+    // Checks the header, the offset table and every reference in the records
+    bool Validate();
+
+    C3MappedFile m_file;
+    const FileHeader* m_header = nullptr;
+    const uint8_t* m_data = nullptr;
+    const char* m_strings = nullptr;
+    std::string m_lastError;
+};
@@ -0,0 +1,483 @@
+#include "C3BatchReader.h"
+#include "C3Model.h"
+#include "C3VirtualFileSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+
+// Minimal io_uring wrapper over the raw syscalls, so no liburing is needed
+struct C3BatchReader::Ring {
+    int fd = -1;
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    io_uring_sqe* sqes = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    void* sqMap = MAP_FAILED;
+    size_t sqMapSize = 0;
+    void* cqMap = MAP_FAILED;
+    size_t cqMapSize = 0;
+    size_t sqeMapSize = 0;
+    unsigned unpublished = 0; // SQEs written but not yet past the SQ tail
+    unsigned unsubmitted = 0; // Past the tail but not yet consumed by io_uring_enter
+
+    ~Ring() {
+        if (sqes) munmap(sqes, sqeMapSize);
+        if (cqMap != MAP_FAILED && cqMap != sqMap) munmap(cqMap, cqMapSize);
+        if (sqMap != MAP_FAILED) munmap(sqMap, sqMapSize);
+        if (fd >= 0) ::close(fd);
+    }
+
+    bool Init(unsigned entries, std::string& error) {
+        io_uring_params params{};
+        fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0) {
+            error = std::string("io_uring_setup failed: ") + strerror(errno);
+            return false;
+        }
+
+        sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) sqMapSize = cqMapSize = std::max(sqMapSize, cqMapSize);
+
+        sqMap = mmap(nullptr, sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sqMap == MAP_FAILED) {
+            error = "Failed to map the io_uring submission queue";
+            return false;
+        }
+        cqMap = single ? sqMap : mmap(nullptr, cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cqMap == MAP_FAILED) {
+            error = "Failed to map the io_uring completion queue";
+            return false;
+        }
+        sqeMapSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqeMap = mmap(nullptr, sqeMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqeMap == MAP_FAILED) {
+            error = "Failed to map the io_uring submission entries";
+            return false;
+        }
+        sqes = static_cast<io_uring_sqe*>(sqeMap);
+
+        uint8_t* sq = static_cast<uint8_t*>(sqMap);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqEntries = params.sq_entries;
+
+        uint8_t* cq = static_cast<uint8_t*>(cqMap);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        // OPENAT and STATX need 5.6; containers often block io_uring outright
+        constexpr unsigned kProbeOps = 64;
+        std::vector<uint8_t> probeBuffer(sizeof(io_uring_probe) + kProbeOps * sizeof(io_uring_probe_op));
+        auto* probe = reinterpret_cast<io_uring_probe*>(probeBuffer.data());
+        if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, kProbeOps) < 0) {
+            error = "io_uring probe is not supported by this kernel";
+            return false;
+        }
+        for (unsigned op : { IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ }) {
+            if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+                error = "io_uring lacks OPENAT/STATX/READ support";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Only the submitting thread touches the SQ tail, so no contention here
+    io_uring_sqe* NextSqe(uint64_t userData) {
+        unsigned tail = *sqTail + unpublished;
+        unsigned head = std::atomic_ref<unsigned>(*sqHead).load(std::memory_order_acquire);
+        if (tail - head >= sqEntries) return nullptr;
+        unsigned index = tail & sqMask;
+        io_uring_sqe* sqe = &sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->user_data = userData;
+        sqArray[index] = index;
+        unpublished++;
+        return sqe;
+    }
+
+    // Publishes written SQEs and optionally blocks until one completion is ready
+    bool Submit(bool wait, std::string& error) {
+        if (unpublished == 0 && unsubmitted == 0 && !wait) return true;
+        if (unpublished) {
+            std::atomic_ref<unsigned>(*sqTail).store(*sqTail + unpublished, std::memory_order_release);
+            unsubmitted += unpublished;
+            unpublished = 0;
+        }
+        while (true) {
+            long result = syscall(__NR_io_uring_enter, fd, unsubmitted, wait ? 1u : 0u,
+                wait ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+            if (result >= 0) {
+                unsubmitted -= std::min(unsubmitted, static_cast<unsigned>(result));
+                // Nothing taken: the rest stays published for the next call
+                if (unsubmitted == 0 || result == 0) return true;
+                wait = false;
+                continue;
+            }
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EBUSY) {
+                return true; // Completions must be reaped before the kernel takes more
+            }
+            error = std::string("io_uring_enter failed: ") + strerror(errno);
+            return false;
+        }
+    }
+
+    // Takes back every SQE the kernel has not consumed, passing each one's
+    // user data to fn. Without SQPOLL only io_uring_enter on this thread
+    // reads the tail, so moving it back is safe.
+    template <typename Fn>
+    void Unqueue(Fn&& fn) {
+        unsigned head = std::atomic_ref<unsigned>(*sqHead).load(std::memory_order_acquire);
+        unsigned end = *sqTail + unpublished;
+        for (unsigned i = head; i != end; i++) fn(sqes[i & sqMask].user_data);
+        std::atomic_ref<unsigned>(*sqTail).store(head, std::memory_order_release);
+        unpublished = 0;
+        unsubmitted = 0;
+    }
+
+    template <typename Fn>
+    void Reap(Fn&& fn) {
+        unsigned head = *cqHead;
+        unsigned tail = std::atomic_ref<unsigned>(*cqTail).load(std::memory_order_acquire);
+        for (; head != tail; head++) {
+            const io_uring_cqe& cqe = cqes[head & cqMask];
+            fn(cqe.user_data, cqe.res);
+        }
+        std::atomic_ref<unsigned>(*cqHead).store(head, std::memory_order_release);
+    }
+};
+
+#else
+
+struct C3BatchReader::Ring {};
+
+#endif
+
+C3BatchReader::C3BatchReader(const Options& options) : m_options(options) {
+    m_options.queueDepth = std::clamp(m_options.queueDepth, 1u, 2048u);
+#if defined(__linux__)
+    if (m_options.allowIoUring) {
+        // Each file has at most two operations in flight (open + statx)
+        auto ring = std::make_unique<Ring>();
+        if (ring->Init(m_options.queueDepth * 2, m_lastError)) {
+            m_ring = std::move(ring);
+        }
+    }
+#endif
+}
+
+C3BatchReader::~C3BatchReader() = default;
+
+const char* C3BatchReader::GetBackendName(Backend backend) {
+    return backend == Backend::IoUring ? "io_uring" : "thread pool";
+}
+
+bool C3BatchReader::ReadAll(const std::vector<std::string>& paths, const Completion& onComplete) {
+    m_stats = {};
+    m_stats.fileCount = paths.size();
+    if (paths.empty()) return true;
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = m_ring ? ReadWithRing(paths, onComplete) : ReadWithPool(paths, onComplete);
+    m_stats.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return ok;
+}
+
+size_t C3BatchReader::LoadModels(const std::vector<std::string>& paths, std::vector<C3Model>& models,
+    std::vector<std::string>* errors) {
+    models.clear();
+    models.resize(paths.size());
+    if (errors) errors->assign(paths.size(), std::string());
+
+    std::atomic<size_t> loaded{ 0 };
+    std::vector<uint8_t> reached(paths.size(), 0);
+    const bool ok = ReadAll(paths, [&](size_t index, std::vector<uint8_t>& data, const std::string& error) {
+        reached[index] = 1;
+        if (!error.empty()) {
+            if (errors) (*errors)[index] = error;
+            return;
+        }
+        if (models[index].LoadFromMemory(data.data(), data.size())) {
+            loaded++;
+        }
+        else if (errors) {
+            (*errors)[index] = "Failed to parse C3 file: " + paths[index];
+        }
+    });
+    if (!ok && errors) {
+        for (size_t i = 0; i < paths.size(); i++) {
+            if (!reached[i]) (*errors)[i] = m_lastError;
+        }
+    }
+    return loaded;
+}
+
+bool C3BatchReader::ReadWithPool(const std::vector<std::string>& paths, const Completion& onComplete) {
+    unsigned threads = m_options.threads ? m_options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, paths.size()));
+
+    std::atomic<size_t> next{ 0 };
+    std::atomic<size_t> failed{ 0 };
+    std::atomic<uint64_t> bytes{ 0 };
+    auto worker = [&] {
+        std::vector<uint8_t> data;
+        std::string error;
+        for (size_t i = next++; i < paths.size(); i = next++) {
+            data.clear();
+            error.clear();
+            if (C3VirtualFileSystem::ReadDiskFile(paths[i], data, &error)) bytes += data.size();
+            else failed++;
+            onComplete(i, data, error);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool) thread.join();
+
+    // Added to, since this may finish a batch that io_uring started
+    m_stats.failedCount += failed;
+    m_stats.bytesRead += bytes;
+    m_stats.peakInFlight = std::max(m_stats.peakInFlight, threads);
+    return true;
+}
+
+#if defined(__linux__)
+
+bool C3BatchReader::ReadWithRing(const std::vector<std::string>& paths, const Completion& onComplete) {
+    enum Op : uint64_t { kOpen = 0, kStat = 1, kRead = 2, kCancel = 3 };
+    constexpr uint64_t kMaxRead = 1u << 30;
+
+    struct Slot {
+        size_t index = 0;
+        bool busy = false;
+        int fd = -1;
+        int pending = 0;    // Operations in flight
+        uint8_t ops = 0;    // Which of them, one bit per Op
+        uint64_t size = 0;
+        uint64_t done = 0;
+        std::string error;
+        struct statx stx {};
+        std::vector<uint8_t> data;
+    };
+    struct Finished {
+        size_t index;
+        std::vector<uint8_t> data;
+        std::string error;
+    };
+
+    Ring& ring = *m_ring;
+    // The kernel writes into the slots, so they are only freed once nothing is in flight
+    auto slotStorage = std::make_unique<std::vector<Slot>>(std::min<size_t>(m_options.queueDepth, paths.size()));
+    std::vector<Slot>& slots = *slotStorage;
+    std::vector<uint32_t> freeSlots;
+    for (size_t s = slots.size(); s-- > 0;) freeSlots.push_back(static_cast<uint32_t>(s));
+    std::vector<Finished> finished;
+    size_t nextPath = 0;
+    size_t completed = 0;
+    unsigned inFlight = 0; // Operations submitted or queued
+
+    auto queueRead = [&](uint32_t s) {
+        Slot& slot = slots[s];
+        io_uring_sqe* sqe = ring.NextSqe((uint64_t(s) << 2) | kRead);
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = slot.fd;
+        sqe->addr = reinterpret_cast<uint64_t>(slot.data.data() + slot.done);
+        sqe->len = static_cast<uint32_t>(std::min(slot.size - slot.done, kMaxRead));
+        sqe->off = slot.done;
+        slot.pending = 1;
+        slot.ops |= 1u << kRead;
+        inFlight++;
+    };
+
+    auto finish = [&](uint32_t s) {
+        Slot& slot = slots[s];
+        if (slot.fd >= 0) ::close(slot.fd);
+        if (slot.error.empty()) m_stats.bytesRead += slot.size;
+        else m_stats.failedCount++;
+        finished.push_back({ slot.index, std::move(slot.data), std::move(slot.error) });
+        slot = Slot{};
+        freeSlots.push_back(s);
+    };
+
+    while (completed < paths.size()) {
+        // Open and size each new file in parallel; the read follows both
+        while (nextPath < paths.size() && !freeSlots.empty()) {
+            uint32_t s = freeSlots.back();
+            freeSlots.pop_back();
+            Slot& slot = slots[s];
+            slot.index = nextPath;
+            slot.busy = true;
+            const char* path = paths[nextPath++].c_str();
+
+            io_uring_sqe* open = ring.NextSqe((uint64_t(s) << 2) | kOpen);
+            open->opcode = IORING_OP_OPENAT;
+            open->fd = AT_FDCWD;
+            open->addr = reinterpret_cast<uint64_t>(path);
+            open->open_flags = O_RDONLY | O_CLOEXEC;
+
+            io_uring_sqe* stat = ring.NextSqe((uint64_t(s) << 2) | kStat);
+            stat->opcode = IORING_OP_STATX;
+            stat->fd = AT_FDCWD;
+            stat->addr = reinterpret_cast<uint64_t>(path);
+            stat->len = STATX_SIZE;
+            stat->off = reinterpret_cast<uint64_t>(&slot.stx);
+
+            slot.pending = 2;
+            slot.ops = (1u << kOpen) | (1u << kStat);
+            inFlight += 2;
+        }
+        m_stats.peakInFlight = std::max(m_stats.peakInFlight, static_cast<unsigned>(slots.size() - freeSlots.size()));
+
+        // Only block when there is nothing ready to hand to the caller
+        if (!ring.Submit(finished.empty() && inFlight > 0, m_lastError)) break;
+
+        ring.Reap([&](uint64_t userData, int result) {
+            uint32_t s = static_cast<uint32_t>(userData >> 2);
+            Slot& slot = slots[s];
+            inFlight--;
+            slot.pending--;
+            slot.ops &= ~(1u << (userData & 3));
+
+            switch (userData & 3) {
+            case kOpen:
+                if (result >= 0) slot.fd = result;
+                else if (slot.error.empty()) slot.error = "Failed to open file: " + paths[slot.index];
+                break;
+            case kStat:
+                if (result >= 0) slot.size = slot.stx.stx_size;
+                else if (slot.error.empty()) slot.error = "Failed to query file size: " + paths[slot.index];
+                break;
+            case kRead:
+                if (result == -EINTR || result == -EAGAIN) {
+                    queueRead(s);
+                    return;
+                }
+                if (result <= 0) {
+                    slot.error = "Failed to read file: " + paths[slot.index];
+                }
+                else {
+                    slot.done += static_cast<uint64_t>(result);
+                    if (slot.done < slot.size) {
+                        queueRead(s);
+                        return;
+                    }
+                }
+                finish(s);
+                return;
+            }
+
+            if (slot.pending > 0) return;
+            if (!slot.error.empty() || slot.size == 0) {
+                finish(s);
+                return;
+            }
+            slot.data.resize(static_cast<size_t>(slot.size));
+            queueRead(s);
+        });
+
+        // Parse while the kernel works through the reads queued above
+        for (auto& item : finished) {
+            onComplete(item.index, item.data, item.error);
+        }
+        completed += finished.size();
+        finished.clear();
+    }
+    if (completed == paths.size()) return true;
+
+    // io_uring_enter failed. Nothing the kernel has not taken yet will run;
+    // cancel what it has and wait for every completion, so no read lands
+    // in a freed buffer, then read whatever is left on the thread pool.
+    ring.Unqueue([&](uint64_t userData) {
+        Slot& slot = slots[userData >> 2];
+        slot.pending--;
+        slot.ops &= ~(1u << (userData & 3));
+        inFlight--;
+    });
+    unsigned cancels = 0;
+    for (uint32_t s = 0; s < slots.size(); s++) {
+        for (uint64_t op : { kOpen, kStat, kRead }) {
+            if (!(slots[s].ops & (1u << op))) continue;
+            io_uring_sqe* cancel = ring.NextSqe((uint64_t(s) << 2) | kCancel);
+            cancel->opcode = IORING_OP_ASYNC_CANCEL;
+            cancel->fd = -1;
+            cancel->addr = (uint64_t(s) << 2) | op;
+            cancels++;
+        }
+    }
+    std::string drainError;
+    while (inFlight > 0 || cancels > 0) {
+        if (!ring.Submit(true, drainError)) {
+            // Completions may still arrive; leaking the buffers beats a use-after-free
+            slotStorage.release();
+            break;
+        }
+        ring.Reap([&](uint64_t userData, int result) {
+            if ((userData & 3) == kCancel) {
+                cancels--;
+                return;
+            }
+            Slot& slot = slots[userData >> 2];
+            inFlight--;
+            slot.pending--;
+            slot.ops &= ~(1u << (userData & 3));
+            if ((userData & 3) == kOpen && result >= 0) slot.fd = result;
+        });
+    }
+
+    std::vector<size_t> rest;
+    for (auto& slot : slots) {
+        if (!slot.busy) continue;
+        if (slot.fd >= 0) ::close(slot.fd);
+        slot.fd = -1;
+        rest.push_back(slot.index);
+    }
+    for (; nextPath < paths.size(); nextPath++) rest.push_back(nextPath);
+    std::sort(rest.begin(), rest.end());
+
+    std::vector<std::string> restPaths;
+    restPaths.reserve(rest.size());
+    for (size_t index : rest) restPaths.push_back(paths[index]);
+    ReadWithPool(restPaths, [&](size_t i, std::vector<uint8_t>& data, const std::string& error) {
+        onComplete(rest[i], data, error);
+    });
+    m_ring.reset(); // Later batches use the thread pool
+    return false;
+}
+
+#else
+
+bool C3BatchReader::ReadWithRing(const std::vector<std::string>& paths, const Completion& onComplete) {
+    return ReadWithPool(paths, onComplete);
+}
+
+#endif
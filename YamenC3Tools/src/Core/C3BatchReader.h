@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class C3Model;
+
+// Bulk loader for many small files. On Linux the open, size query and read
+// of each file are submitted to io_uring in batches, so the device always
+// has a full queue; elsewhere, or when the kernel refuses io_uring, a
+// thread pool issues blocking reads instead. Every file is read straight
+// into a buffer sized for it, which the completion callback may keep.
+class C3BatchReader {
+public:
+    enum class Backend { IoUring, ThreadPool };
+
+    struct Options {
+        unsigned queueDepth = 128; // Files in flight with io_uring
+        unsigned threads = 0;      // Thread pool size; 0 = hardware concurrency
+        bool allowIoUring = true;
+    };
+
+    struct Stats {
+        size_t fileCount = 0;
+        size_t failedCount = 0;
+        uint64_t bytesRead = 0;
+        unsigned peakInFlight = 0; // Most files open at once
+        double elapsedMs = 0.0;
+    };
+
+    // Called once per path in completion order, with an empty error on
+    // success. 'data' may be moved from. Pool completions run concurrently
+    // on worker threads; io_uring completions run on the calling thread.
+    using Completion = std::function<void(size_t index, std::vector<uint8_t>& data, const std::string& error)>;
+
+    C3BatchReader() : C3BatchReader(Options{}) {}
+    explicit C3BatchReader(const Options& options);
+    ~C3BatchReader();
+
+    C3BatchReader(const C3BatchReader&) = delete;
+    C3BatchReader& operator=(const C3BatchReader&) = delete;
+
+    // Per-file errors go to the callback. Returns false if io_uring itself
+    // failed: the files it had not finished are then read on the thread
+    // pool, so every path still gets its callback, and GetLastError() says
+    // what went wrong.
+    bool ReadAll(const std::vector<std::string>& paths, const Completion& onComplete);
+
+    // Reads every path and parses each one with C3Model::LoadFromMemory as
+    // soon as its bytes arrive, while the remaining reads stay in flight.
+    // Returns the number of models loaded; 'errors' gets one entry per path.
+    // If the backend failed, GetLastError() says why and any path that never
+    // got a callback carries that error.
+    size_t LoadModels(const std::vector<std::string>& paths, std::vector<C3Model>& models,
+        std::vector<std::string>* errors = nullptr);
+
+    Backend GetBackend() const { return m_ring ? Backend::IoUring : Backend::ThreadPool; }
+    static const char* GetBackendName(Backend backend);
+    const Stats& GetStats() const { return m_stats; }
+    const std::string& GetLastError() const { return m_lastError; }
+
+private:
+    struct Ring;
+
+    Options m_options;
+    std::unique_ptr<Ring> m_ring; // Null when falling back to the thread pool
+    Stats m_stats;
+    std::string m_lastError;
+
+    bool ReadWithRing(const std::vector<std::string>& paths, const Completion& onComplete);
+    bool ReadWithPool(const std::vector<std::string>& paths, const Completion& onComplete);
+};
@@ -0,0 +1,161 @@
+#include "C3DedupStore.h"
+#include "C3ArchiveVerifier.h"
+#include "C3Model.h"
+#include <algorithm>
+
+namespace {
+
+// Second seed for the high digest word; any constant unrelated to the first works
+constexpr uint64_t kHighSeed = 0x9E3779B97F4A7C15ULL;
+
+void CollectParts(C3Model::MeshPart& mesh, std::vector<C3Model::MeshPart*>& out) {
+    out.push_back(&mesh);
+    for (auto& lod : mesh.lods) CollectParts(lod, out);
+}
+
+template <typename T>
+C3DedupStore::Digest BufferDigest(const C3SharedBuffer<T>& buffer) {
+    return C3DedupStore::Digest::Of(buffer.data(), buffer.size() * sizeof(T));
+}
+
+} // namespace
+
+C3DedupStore::Digest C3DedupStore::Digest::Of(const void* data, size_t size) {
+    return { C3ArchiveVerifier::Checksum(data, size), C3ArchiveVerifier::Checksum(data, size, kHighSeed) };
+}
+
+std::shared_ptr<const C3Model> C3DedupStore::InternModel(std::span<const uint8_t> data, std::string* error) {
+    const Digest digest = Digest::Of(data.data(), data.size());
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto found = FindLocked(m_models, digest, data.size())) {
+            return std::static_pointer_cast<const C3Model>(found);
+        }
+    }
+
+    auto model = std::make_shared<C3Model>();
+    if (!model->LoadFromMemory(data.data(), data.size())) {
+        if (error) *error = model->GetError();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.failed++;
+        return nullptr;
+    }
+
+    // Digested before taking the lock; LODs are buffers like any other
+    std::vector<C3Model::MeshPart*> parts;
+    for (auto& mesh : model->GetMeshes()) CollectParts(mesh, parts);
+    model->RecalculateBounds(); // Sharing leaves the geometry as it was; clears the stale mark
+    std::vector<Digest> digests;
+    digests.reserve(parts.size() * 3);
+    for (const C3Model::MeshPart* part : parts) {
+        digests.push_back(BufferDigest(part->vertices));
+        digests.push_back(BufferDigest(part->normalIndices));
+        digests.push_back(BufferDigest(part->alphaIndices));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<const void> inserted = InsertLocked(m_models, digest, model);
+    if (inserted != model) return std::static_pointer_cast<const C3Model>(inserted);
+    // Nobody else sees the model until this returns, so its buffers can still be swapped
+    const Digest* next = digests.data();
+    for (C3Model::MeshPart* part : parts) {
+        ShareLocked(m_vertexBuffers, part->vertices, *next++);
+        ShareLocked(m_indexBuffers, part->normalIndices, *next++);
+        ShareLocked(m_indexBuffers, part->alphaIndices, *next++);
+    }
+    return model;
+}
+
+std::shared_ptr<const C3DedupStore::Blob> C3DedupStore::InternBlob(Blob bytes) {
+    const Digest digest = Digest::Of(bytes.data(), bytes.size());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto found = FindLocked(m_blobs, digest, bytes.size())) {
+        return std::static_pointer_cast<const Blob>(found);
+    }
+    bytes.shrink_to_fit();
+    return std::static_pointer_cast<const Blob>(InsertLocked(m_blobs, digest, std::make_shared<Blob>(std::move(bytes))));
+}
+
+std::shared_ptr<const void> C3DedupStore::FindLocked(Table& table, const Digest& digest, size_t bytes) {
+    m_stats.lookups++;
+    auto it = table.find(digest);
+    if (it == table.end()) return nullptr;
+    std::shared_ptr<const void> value = it->second.lock();
+    if (value) {
+        m_stats.shared++;
+        m_stats.sharedBytes += bytes;
+    }
+    return value;
+}
+
+std::shared_ptr<const void> C3DedupStore::InsertLocked(Table& table, const Digest& digest, std::shared_ptr<const void> value) {
+    auto [it, added] = table.try_emplace(digest, value);
+    if (!added) {
+        // Another thread parsed the same content first; keep its copy
+        if (auto existing = it->second.lock()) return existing;
+        it->second = value;
+    }
+    m_stats.inserted++;
+    if (EntryCountLocked() >= m_purgeAt) {
+        PurgeLocked();
+        m_purgeAt = std::max<size_t>(1024, EntryCountLocked() * 2);
+    }
+    return value;
+}
+
+template <typename T>
+void C3DedupStore::ShareLocked(Table& table, C3SharedBuffer<T>& buffer, const Digest& digest) {
+    if (buffer.empty()) return;
+    auto [it, added] = table.try_emplace(digest);
+    if (!added) {
+        auto held = std::static_pointer_cast<const std::vector<T>>(it->second.lock());
+        if (held && held->size() == buffer.size()) {
+            m_stats.sharedBuffers++;
+            m_stats.sharedBufferBytes += buffer.size() * sizeof(T);
+            buffer.Share(std::move(held));
+            return;
+        }
+    }
+    it->second = buffer.GetStorage();
+}
+
+size_t C3DedupStore::EntryCountLocked() const {
+    return m_models.size() + m_blobs.size() + m_vertexBuffers.size() + m_indexBuffers.size();
+}
+
+size_t C3DedupStore::PurgeLocked() {
+    size_t removed = 0;
+    for (Table* table : { &m_models, &m_blobs, &m_vertexBuffers, &m_indexBuffers }) {
+        removed += std::erase_if(*table, [](const auto& entry) { return entry.second.expired(); });
+    }
+    return removed;
+}
+
+size_t C3DedupStore::Purge() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return PurgeLocked();
+}
+
+void C3DedupStore::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_models.clear();
+    m_blobs.clear();
+    m_vertexBuffers.clear();
+    m_indexBuffers.clear();
+    m_purgeAt = 1024;
+}
+
+C3DedupStore::Stats C3DedupStore::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats = m_stats;
+    stats.liveEntries = 0;
+    for (const Table* table : { &m_models, &m_blobs, &m_vertexBuffers, &m_indexBuffers }) {
+        for (const auto& entry : *table) stats.liveEntries += !entry.second.expired();
+    }
+    return stats;
+}
+
+void C3DedupStore::ResetCounters() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats = {};
+}
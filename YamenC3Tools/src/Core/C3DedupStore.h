@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class C3Model;
+template <typename T>
+class C3SharedBuffer;
+
+// Content-addressed pool of parsed assets. The same mesh, motion or texture
+// often ships under many file ids (a recolored armor reusing its geometry,
+// an effect copied between folders); interning by the hash of the decoded
+// bytes parses such content once and hands every caller the same immutable
+// object. Files that differ, say only in a texture name, are parsed apart,
+// but each vertex and index buffer is interned by its own digest, so their
+// geometry is still held once. The store only keeps weak references, so
+// content is freed as soon as its last user lets go.
+//
+// Safe to call from any number of threads. Two threads interning the same
+// new content at once may both parse it; both get the object inserted first.
+class C3DedupStore {
+public:
+    // 128-bit digest: xxHash64 of the bytes under two seeds
+    struct Digest {
+        uint64_t lo = 0;
+        uint64_t hi = 0;
+
+        static Digest Of(const void* data, size_t size);
+        bool operator==(const Digest&) const = default;
+        bool operator<(const Digest& other) const { return lo != other.lo ? lo < other.lo : hi < other.hi; }
+        struct Hasher {
+            size_t operator()(const Digest& d) const { return static_cast<size_t>(d.lo ^ d.hi); }
+        };
+    };
+
+    using Blob = std::vector<uint8_t>;
+
+    struct Stats {
+        uint64_t lookups = 0;
+        uint64_t shared = 0;      // Resolved to content already held
+        uint64_t sharedBytes = 0; // Input bytes of those, not parsed or stored again
+        uint64_t inserted = 0;
+        uint64_t failed = 0;      // Models that did not parse
+        uint64_t sharedBuffers = 0;     // Vertex or index buffers of new models resolved to ones already held
+        uint64_t sharedBufferBytes = 0; // Bytes of those, freed right after parsing
+        size_t liveEntries = 0;   // Content still referenced by someone
+    };
+
+    C3DedupStore() = default;
+    C3DedupStore(const C3DedupStore&) = delete;
+    C3DedupStore& operator=(const C3DedupStore&) = delete;
+
+    // The model parsed from these file bytes, shared with every earlier
+    // caller that passed identical bytes; null if they do not parse. A new
+    // model's vertex and index buffers are shared with any already held.
+    std::shared_ptr<const C3Model> InternModel(std::span<const uint8_t> data, std::string* error = nullptr);
+    // Raw content such as texture files
+    std::shared_ptr<const Blob> InternBlob(Blob bytes);
+
+    // Drops entries nobody references any more; returns how many
+    size_t Purge();
+    void Clear();
+
+    Stats GetStats() const;
+    void ResetCounters();
+
+private:
+    using Table = std::unordered_map<Digest, std::weak_ptr<const void>, Digest::Hasher>;
+
+    mutable std::mutex m_mutex;
+    Table m_models;
+    Table m_blobs;
+    Table m_vertexBuffers;
+    Table m_indexBuffers;
+    size_t m_purgeAt = 1024; // Purge expired entries when the tables grow past this
+    Stats m_stats;
+
+    // Live content for the digest, counting the lookup; the caller holds the lock
+    std::shared_ptr<const void> FindLocked(Table& table, const Digest& digest, size_t bytes);
+    std::shared_ptr<const void> InsertLocked(Table& table, const Digest& digest, std::shared_ptr<const void> value);
+    // Points the buffer at held storage with the same digest, or registers its own
+    template <typename T>
+    void ShareLocked(Table& table, C3SharedBuffer<T>& buffer, const Digest& digest);
+    size_t EntryCountLocked() const;
+    size_t PurgeLocked();
+};
@@ -0,0 +1,152 @@
+#include "C3DnpArchive.h"
+#include "C3HashSystem.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+bool C3DnpArchive::Open(const std::string& path) {
+    Close();
+
+    if (!m_file.Open(path)) {
+        m_lastError = m_file.GetLastError();
+        return false;
+    }
+
+    Header header{};
+    if (m_file.Size() < sizeof(Header)) {
+        Close();
+        m_lastError = "File too small for DNP header";
+        return false;
+    }
+    memcpy(&header, m_file.Data(), sizeof(Header));
+
+    if (strncmp(header.tag, kTag, sizeof(header.tag)) != 0) {
+        Close();
+        m_lastError = "Not a DawnPack archive";
+        return false;
+    }
+    if (header.version != kVersion) {
+        Close();
+        m_lastError = "Unsupported DNP version: " + std::to_string(header.version);
+        return false;
+    }
+
+    if (header.count > (1u << 30)) {
+        Close();
+        m_lastError = "Invalid DNP entry count";
+        return false;
+    }
+
+    std::span<const uint8_t> indexData =
+        m_file.View(sizeof(Header), static_cast<uint64_t>(header.count) * sizeof(IndexEntry));
+    if (header.count > 0 && indexData.empty()) {
+        Close();
+        m_lastError = "DNP index extends past end of file";
+        return false;
+    }
+    m_entries = { reinterpret_cast<const IndexEntry*>(indexData.data()), header.count };
+
+    // Power-of-two table at most half full
+    uint32_t bits = 4;
+    while ((size_t(1) << bits) < size_t(header.count) * 2) bits++;
+    m_shift = 32 - bits;
+    m_table.assign(size_t(1) << bits, Slot{});
+    const uint32_t mask = (1u << bits) - 1;
+
+    for (uint32_t i = 0; i < m_entries.size(); i++) {
+        const IndexEntry& entry = m_entries[i];
+        if (m_file.View(entry.offset, entry.size).size() != entry.size) {
+            Close();
+            m_lastError = "DNP entry extends past end of file";
+            return false;
+        }
+
+        // Later duplicates replace earlier ones, as std::map assignment did
+        uint32_t slot = HomeSlot(entry.id);
+        while (m_table[slot].used && m_table[slot].id != entry.id) {
+            slot = (slot + 1) & mask;
+        }
+        if (m_table[slot].used) m_shadowed++;
+        m_table[slot] = { entry.id, entry.size, entry.offset, i + 1 };
+    }
+
+    // Enumeration agrees with Find: keep only the entry each id resolves to
+    if (m_shadowed > 0) {
+        m_ownedEntries.reserve(m_entries.size() - m_shadowed);
+        for (uint32_t i = 0; i < m_entries.size(); i++) {
+            uint32_t slot = HomeSlot(m_entries[i].id);
+            while (m_table[slot].id != m_entries[i].id) slot = (slot + 1) & mask;
+            if (m_table[slot].used == i + 1) m_ownedEntries.push_back(m_entries[i]);
+        }
+        m_entries = m_ownedEntries;
+    }
+
+    // The client keys packs by the lowercase archive name without ".dnp"
+    size_t slash = path.find_last_of("/\\");
+    std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+    std::transform(name.begin(), name.end(), name.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (name.size() > 4 && name.compare(name.size() - 4, 4, ".dnp") == 0) {
+        name.resize(name.size() - 4);
+    }
+    m_packId = C3HashSystem::StringToID(name.c_str());
+    return true;
+}
+
+void C3DnpArchive::Close() {
+    C3Archive::Close();
+    m_entries = {};
+    m_ownedEntries.clear();
+    m_shadowed = 0;
+    m_table.clear();
+    m_shift = 32;
+}
+
+uint32_t C3DnpArchive::PackIdFromPath(const char* path) const {
+    return C3HashSystem::DnpPackName(path);
+}
+
+uint32_t C3DnpArchive::FileIdFromPath(const char* path) const {
+    return C3HashSystem::DnpRealName(path);
+}
+
+C3Archive::Entry C3DnpArchive::GetEntry(size_t index) const {
+    if (index >= m_entries.size()) return {};
+    const IndexEntry& e = m_entries[index];
+    return { e.id, e.offset, e.size };
+}
+
+bool C3DnpArchive::Find(uint32_t fileId, Entry& out) const {
+    if (m_table.empty()) return false;
+
+    const uint32_t mask = static_cast<uint32_t>(m_table.size() - 1);
+    for (uint32_t slot = HomeSlot(fileId);; slot = (slot + 1) & mask) {
+        const Slot& s = m_table[slot];
+        if (!s.used) return false;
+        if (s.id == fileId) {
+            out = { s.id, s.offset, s.size };
+            return true;
+        }
+    }
+}
+
+C3DnpArchive::LookupStats C3DnpArchive::GetLookupStats() const {
+    LookupStats stats;
+    stats.capacity = m_table.size();
+    stats.shadowed = m_shadowed;
+    if (m_table.empty()) return stats;
+
+    const uint32_t mask = static_cast<uint32_t>(m_table.size() - 1);
+    uint64_t totalProbes = 0;
+    for (uint32_t i = 0; i < m_table.size(); i++) {
+        if (!m_table[i].used) continue;
+        uint32_t probes = ((i - HomeSlot(m_table[i].id)) & mask) + 1;
+        totalProbes += probes;
+        stats.maxProbes = std::max(stats.maxProbes, probes);
+        stats.entries++;
+    }
+
+    stats.loadFactor = double(stats.entries) / double(stats.capacity);
+    stats.averageProbes = stats.entries ? double(totalProbes) / double(stats.entries) : 0.0;
+    return stats;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "C3Archive.h"
+
+// DawnPack archive ("DawnPack.TqDigital", version 1000). The legacy
+// CDnFile kept a std::map per pack; here the index is used in place from
+// the mapping and hashed at open into a flat, linearly probed table of
+// 16-byte slots. The client's format stores only the entry list, so the
+// table is built in one pass over it rather than read from the file.
+//
+// An id listed more than once resolves to its last entry, as std::map
+// assignment did in CDnFile. GetEntry() then lists only those winning
+// entries; C3ArchivePacker never writes such archives.
+class C3DnpArchive : public C3Archive {
+public:
+#pragma pack(push, 1)
+    struct Header {
+        char tag[32];     // "DawnPack.TqDigital", null padded
+        uint32_t version; // 1000
+        uint32_t count;   // Entries following the header
+    };
+
+    struct IndexEntry {
+        uint32_t id;
+        uint32_t size;
+        uint32_t offset;
+    };
+#pragma pack(pop)
+
+    static constexpr const char* kTag = "DawnPack.TqDigital";
+    static constexpr uint32_t kVersion = 1000;
+
+    struct LookupStats {
+        size_t entries = 0;
+        size_t capacity = 0;
+        double loadFactor = 0.0;
+        double averageProbes = 0.0; // Slots touched by a successful lookup
+        uint32_t maxProbes = 0;
+        size_t shadowed = 0;        // Index entries hidden by a later one with the same id
+    };
+
+    bool Open(const std::string& path) override;
+    void Close() override;
+    const char* GetFormatName() const override { return "DNP"; }
+    const char* GetFileExtension() const override { return ".dnp"; }
+
+    uint32_t PackIdFromPath(const char* path) const override;
+    uint32_t FileIdFromPath(const char* path) const override;
+    const char* GetIdScheme() const override { return "DNP"; }
+
+    size_t GetEntryCount() const override { return m_entries.size(); }
+    Entry GetEntry(size_t index) const override;
+    bool Find(uint32_t fileId, Entry& out) const override;
+    using C3Archive::Find;
+
+    LookupStats GetLookupStats() const;
+
+private:
+    struct Slot {
+        uint32_t id;
+        uint32_t size;
+        uint32_t offset;
+        uint32_t used;   // Index of the winning entry + 1, 0 if empty
+    };
+    static_assert(sizeof(Slot) == 16, "DNP slot must be 16 bytes");
+
+    std::span<const IndexEntry> m_entries; // File order, points into the mapping or m_ownedEntries
+    std::vector<IndexEntry> m_ownedEntries; // Winning entries only, when some id repeats
+    size_t m_shadowed = 0;
+    std::vector<Slot> m_table;
+    uint32_t m_shift = 32;
+
+    uint32_t HomeSlot(uint32_t id) const { return (id * 0x9E3779B1u) >> m_shift; }
+};
@@ -0,0 +1,229 @@
+#include "C3DuplicateScanner.h"
+#include "C3Archive.h"
+#include "C3NameDictionary.h"
+#include "C3Types.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+struct ChunkDigest {
+    char id[4];
+    uint32_t size;
+    C3DedupStore::Digest digest;
+};
+
+struct EntryDigest {
+    uint32_t id = 0;
+    uint32_t size = 0;
+    bool readable = false;
+    C3DedupStore::Digest digest;
+    std::vector<ChunkDigest> chunks;
+};
+
+uint32_t Read32(const uint8_t* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+
+bool LooksLikeChunkId(const uint8_t* p) {
+    for (int i = 0; i < 4; i++) {
+        if (!((p[i] >= 'A' && p[i] <= 'Z') || (p[i] >= '0' && p[i] <= '9') || p[i] == ' ')) return false;
+    }
+    return true;
+}
+
+// Digests each chunk payload; the layout is the one CheckC3Structure walks
+void DigestChunks(const uint8_t* data, size_t size, std::vector<ChunkDigest>& out) {
+    if (size < sizeof(C3FileHeader) + 4 || memcmp(data, "MAXFILE C3", 10) != 0) return;
+
+    const uint8_t* id = data + offsetof(C3FileHeader, physicsType);
+    size_t offset = sizeof(C3FileHeader);
+    while (LooksLikeChunkId(id) && size - offset >= 4) {
+        uint32_t chunkSize = Read32(data + offset);
+        offset += 4;
+        if (chunkSize > size - offset) return;
+        ChunkDigest chunk;
+        memcpy(chunk.id, id, 4);
+        chunk.size = chunkSize;
+        chunk.digest = C3DedupStore::Digest::Of(data + offset, chunkSize);
+        out.push_back(chunk);
+        offset += chunkSize;
+
+        if (size - offset < 8) return;
+        id = data + offset;
+        offset += 4;
+    }
+}
+
+std::string FormatBytes(uint64_t bytes) {
+    char text[32];
+    if (bytes >= (1ull << 30)) snprintf(text, sizeof(text), "%.2f GB", bytes / double(1ull << 30));
+    else if (bytes >= (1ull << 20)) snprintf(text, sizeof(text), "%.2f MB", bytes / double(1ull << 20));
+    else if (bytes >= (1ull << 10)) snprintf(text, sizeof(text), "%.1f KB", bytes / double(1ull << 10));
+    else snprintf(text, sizeof(text), "%llu B", static_cast<unsigned long long>(bytes));
+    return text;
+}
+
+std::string Percent(uint64_t part, uint64_t whole) {
+    char text[16];
+    snprintf(text, sizeof(text), "%.1f%%", whole ? 100.0 * double(part) / double(whole) : 0.0);
+    return text;
+}
+
+std::vector<EntryDigest> DigestArchive(const C3Archive& archive, const C3DuplicateScanner::Options& options) {
+    const size_t count = archive.GetEntryCount();
+    std::vector<C3Archive::Entry> entries(count);
+    for (size_t i = 0; i < count; i++) entries[i] = archive.GetEntry(i);
+    // Storage order keeps the reads sequential
+    std::sort(entries.begin(), entries.end(), [](const C3Archive::Entry& a, const C3Archive::Entry& b) {
+        return a.offset < b.offset;
+    });
+
+    std::vector<EntryDigest> digests(count);
+    constexpr size_t kBatch = 64;
+    const bool zeroCopy = archive.SupportsZeroCopy();
+    std::atomic<size_t> next{ 0 };
+    auto worker = [&] {
+        std::vector<uint8_t> buffer;
+        for (size_t begin = next.fetch_add(kBatch); begin < count; begin = next.fetch_add(kBatch)) {
+            for (size_t i = begin; i < std::min(count, begin + kBatch); i++) {
+                EntryDigest& out = digests[i];
+                out.id = entries[i].id;
+                std::span<const uint8_t> data;
+                if (zeroCopy) {
+                    data = archive.GetData(entries[i].id);
+                    out.readable = data.size() == entries[i].size;
+                }
+                else {
+                    out.readable = archive.ReadFile(entries[i].id, buffer);
+                    data = buffer;
+                }
+                if (!out.readable) continue;
+                out.size = static_cast<uint32_t>(data.size());
+                out.digest = C3DedupStore::Digest::Of(data.data(), data.size());
+                if (options.scanChunks) DigestChunks(data.data(), data.size(), out.chunks);
+            }
+        }
+    };
+
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(1, count / kBatch)));
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool) thread.join();
+    return digests;
+}
+
+} // namespace
+
+bool C3DuplicateScanner::Scan(const std::vector<const C3Archive*>& archives, const Options& options) {
+    auto start = std::chrono::steady_clock::now();
+    m_reports.clear();
+    for (const C3Archive* archive : archives) {
+        if (!archive || !archive->IsOpen()) {
+            m_lastError = "Archive is not open";
+            return false;
+        }
+    }
+
+    // Content of every archive scanned so far
+    std::unordered_set<Digest, Digest::Hasher> earlier;
+    for (const C3Archive* archive : archives) {
+        std::vector<EntryDigest> digests = DigestArchive(*archive, options);
+        ArchiveReport report;
+        report.path = archive->GetPath();
+        report.entryCount = digests.size();
+
+        // Ascending id order, so each group's first id is its smallest
+        std::sort(digests.begin(), digests.end(), [](const EntryDigest& a, const EntryDigest& b) { return a.id < b.id; });
+        std::unordered_map<Digest, size_t, Digest::Hasher> groupOf;
+        std::vector<Group> groups;
+        std::unordered_set<Digest, Digest::Hasher> chunksSeen;
+        std::map<std::string, ChunkTotals> chunkTotals;
+
+        for (const EntryDigest& entry : digests) {
+            if (!entry.readable) {
+                report.unreadableCount++;
+                continue;
+            }
+            report.bytes += entry.size;
+
+            auto [it, first] = groupOf.try_emplace(entry.digest, groups.size());
+            if (first) groups.push_back({ entry.digest, entry.size, {} });
+            groups[it->second].ids.push_back(entry.id);
+            if (!first) {
+                report.duplicateBytes += entry.size;
+                continue;
+            }
+            if (earlier.count(entry.digest)) report.crossArchiveBytes += entry.size;
+
+            for (const ChunkDigest& chunk : entry.chunks) {
+                ChunkTotals& totals = chunkTotals[std::string(chunk.id, 4)];
+                memcpy(totals.id, chunk.id, 4);
+                totals.count++;
+                totals.bytes += chunk.size;
+                if (!chunksSeen.insert(chunk.digest).second) {
+                    totals.duplicateBytes += chunk.size;
+                    report.chunkDuplicateBytes += chunk.size;
+                }
+            }
+        }
+
+        for (auto& group : groups) {
+            if (group.ids.size() > 1) report.groups.push_back(std::move(group));
+        }
+        std::sort(report.groups.begin(), report.groups.end(), [](const Group& a, const Group& b) {
+            return a.WastedBytes() != b.WastedBytes() ? a.WastedBytes() > b.WastedBytes() : a.ids.front() < b.ids.front();
+        });
+        for (auto& [id, totals] : chunkTotals) report.chunks.push_back(totals);
+        std::sort(report.chunks.begin(), report.chunks.end(), [](const ChunkTotals& a, const ChunkTotals& b) {
+            return a.bytes > b.bytes;
+        });
+
+        for (const auto& [digest, index] : groupOf) earlier.insert(digest);
+        m_reports.push_back(std::move(report));
+    }
+
+    m_elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+std::string C3DuplicateScanner::FormatReport(size_t maxGroups, const C3NameDictionary* names) const {
+    std::string text;
+    auto describe = [&](uint32_t id) {
+        if (names) return names->Describe(id);
+        char hex[16];
+        snprintf(hex, sizeof(hex), "0x%08X", id);
+        return std::string(hex);
+    };
+
+    for (const ArchiveReport& report : m_reports) {
+        text += report.path + ": " + std::to_string(report.entryCount) + " entries, " + FormatBytes(report.bytes) + "\n";
+        if (report.unreadableCount) text += "  unreadable entries: " + std::to_string(report.unreadableCount) + "\n";
+        text += "  duplicate files:        " + FormatBytes(report.duplicateBytes) + " (" +
+            Percent(report.duplicateBytes, report.bytes) + ") in " + std::to_string(report.groups.size()) + " groups\n";
+        text += "  in earlier archives:    " + FormatBytes(report.crossArchiveBytes) + " (" +
+            Percent(report.crossArchiveBytes, report.bytes) + ")\n";
+        text += "  repeated chunks:        " + FormatBytes(report.chunkDuplicateBytes) + " (" +
+            Percent(report.chunkDuplicateBytes, report.bytes) + ")\n";
+        for (const ChunkTotals& chunk : report.chunks) {
+            text += std::string("    ") + chunk.id + ": " + std::to_string(chunk.count) + " chunks, " +
+                FormatBytes(chunk.bytes) + ", " + FormatBytes(chunk.duplicateBytes) + " repeated\n";
+        }
+
+        for (size_t g = 0; g < std::min(maxGroups, report.groups.size()); g++) {
+            const Group& group = report.groups[g];
+            text += "  " + std::to_string(group.ids.size()) + " x " + FormatBytes(group.size) + ":";
+            for (size_t i = 0; i < std::min<size_t>(4, group.ids.size()); i++) text += " " + describe(group.ids[i]);
+            if (group.ids.size() > 4) text += " ...";
+            text += "\n";
+        }
+    }
+    return text;
+}
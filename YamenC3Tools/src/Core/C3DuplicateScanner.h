@@ -0,0 +1,71 @@
+#pragma once
+#include "C3DedupStore.h"
+#include <string>
+#include <vector>
+
+class C3Archive;
+class C3NameDictionary;
+
+// Measures how much archive content is stored more than once. Every entry
+// is decoded and digested whole, and C3 files also chunk by chunk, so the
+// report separates identical files (which a repack could store once) from
+// files that differ but repeat a PHY or motion chunk. Archives are scanned
+// in the order given; content already seen in an earlier archive is
+// counted apart from duplicates within the archive.
+class C3DuplicateScanner {
+public:
+    using Digest = C3DedupStore::Digest;
+
+    struct Options {
+        unsigned threads = 0;      // 0 = hardware concurrency
+        bool scanChunks = true;    // Digest the chunks of C3 files too
+    };
+
+    // Entries of one archive with identical contents
+    struct Group {
+        Digest digest;
+        uint32_t size = 0;
+        std::vector<uint32_t> ids; // Ascending
+
+        uint64_t WastedBytes() const { return uint64_t(size) * (ids.size() - 1); }
+    };
+
+    struct ChunkTotals {
+        char id[5] = {};           // e.g. "PHY "
+        size_t count = 0;
+        uint64_t bytes = 0;
+        uint64_t duplicateBytes = 0;
+    };
+
+    struct ArchiveReport {
+        std::string path;
+        size_t entryCount = 0;
+        size_t unreadableCount = 0;
+        uint64_t bytes = 0;               // Decoded bytes of every readable entry
+        uint64_t duplicateBytes = 0;      // Entries repeating another entry of this archive
+        uint64_t crossArchiveBytes = 0;   // Entries whose content an earlier archive already holds
+        uint64_t chunkDuplicateBytes = 0; // Chunks repeated within otherwise distinct C3 files
+        std::vector<Group> groups;        // Most wasted bytes first
+        std::vector<ChunkTotals> chunks;  // Per chunk id, most bytes first
+
+        // What storing each distinct content once would save in this archive
+        uint64_t RepackSavings() const { return duplicateBytes; }
+    };
+
+    bool Scan(const std::vector<const C3Archive*>& archives) { return Scan(archives, Options{}); }
+    bool Scan(const std::vector<const C3Archive*>& archives, const Options& options);
+
+    const std::vector<ArchiveReport>& GetReports() const { return m_reports; }
+    double GetElapsedMs() const { return m_elapsedMs; }
+
+    // Human-readable summary, listing the largest groups of each archive.
+    // With a name dictionary, ids are shown as paths where known.
+    std::string FormatReport(size_t maxGroups = 10, const C3NameDictionary* names = nullptr) const;
+
+    const std::string& GetLastError() const { return m_lastError; }
+
+private:
+    std::vector<ArchiveReport> m_reports;
+    double m_elapsedMs = 0.0;
+    std::string m_lastError;
+};
@@ -1,110 +1,131 @@
 #include "C3HashSystem.h"
+#include <algorithm>
 #include <cstring>
-#include <cctype>
-
-uint32_t C3HashSystem::StringToID(const char* str) {
-    if (!str) return 0;
-
-    constexpr uint32_t X0 = 0x37A8470E;
-    constexpr uint32_t Y0 = 0x7758B42B;
-    constexpr uint32_t W_CONST = 0x267B0B11;
-    constexpr uint32_t A = 0x2040801;
-    constexpr uint32_t B = 0x804021;
-    constexpr uint32_t C = 0xBFEF7FDF;
-    constexpr uint32_t D = 0x7DFEFBFF;
-    constexpr uint32_t V_INIT = 0xF4FA8928;
-    constexpr uint32_t SENTINEL1 = 0x9BE74448;
-    constexpr uint32_t SENTINEL2 = 0x66F42C48;
-
-    uint32_t m[70] = { 0 };
-    strncpy(reinterpret_cast<char*>(m), str, 256);
-
-    int i;
-    for (i = 0; i < 256 / 4 && m[i]; i++);
-    m[i++] = SENTINEL1;
-    m[i++] = SENTINEL2;
-
-    uint32_t v = V_INIT;
-    uint32_t esi = X0;
-    uint32_t edi = Y0;
-
-    for (int ecx = 0; ecx < i; ecx++) {
-        uint32_t w = W_CONST;
-        v = RotateLeft(v, 1);
-        w ^= v;
-
-        uint32_t eax = m[ecx];
-        esi ^= eax;
-        edi ^= eax;
-
-        uint32_t edx = w + edi;
-        edx = (edx | A) & C;
-
-        uint64_t mul64 = static_cast<uint64_t>(esi) * edx;
-        eax = static_cast<uint32_t>(mul64);
-        edx = static_cast<uint32_t>(mul64 >> 32);
-
-        uint32_t carry = 0;
-        eax += edx;
-        if (eax < edx) carry = 1;
-        eax += carry;
-
-        esi = eax;
+#include <vector>
+
+// Values produced by the original runtime implementation, so the
+// compile-time path cannot drift from what the client computes
+static_assert(C3HashSystem::StringToID("") == 0xBEBF74CD);
+static_assert(C3HashSystem::StringToID("a") == 0x2DD4AF54);
+static_assert(C3HashSystem::StringToID("abcd") == 0x0F17C17C);
+static_assert(C3HashSystem::StringToID("c3.wdf") == 0x142C9A3A);
+static_assert(C3HashSystem::StringToID("c3/mesh/1.c3") == 0x44190EB2);
+static_assert(C3HashSystem::RealName("Data\\X.C3") == 0x3FF18BBD);
+static_assert(C3HashSystem::PackName("C3/Effect/a.c3") == 0x142C9A3A);
+static_assert(C3HashSystem::PackName("ini") == 0x062A1C5E);
+static_assert("c3/mesh/1.c3"_c3id == 0x44190EB2);
+static_assert("c3/mesh/1.c3"_c3pack == 0x142C9A3A);
+static_assert(C3HashSystem::StringToID(std::string_view("data/x.c3\0ignored", 17)) == 0x3FF18BBD);
+static_assert(C3HashSystem::RealName(std::string_view("Data\\X.C3/trailing", 9)) == 0x3FF18BBD);
+
+namespace {
+
+constexpr size_t kLanes = 8;
+constexpr size_t kMaxWords = C3HashSystem::kMaxHashLength / 4;
+
+// Hashed length: up to the first NUL, capped like the scalar functions
+size_t HashedLength(std::string_view str) {
+    size_t n = std::min(str.size(), C3HashSystem::kMaxHashLength);
+    const void* nul = std::memchr(str.data(), 0, n);
+    return nul ? static_cast<size_t>(static_cast<const char*>(nul) - str.data()) : n;
+}
 
-        edx = w + esi;
-        edx = (edx | B) & D;
+// Little-endian word of up to four bytes, zero padded
+uint32_t LoadWord(const char* data, size_t count) {
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(data);
+    if (count >= 4) return uint32_t(b[0]) | (uint32_t(b[1]) << 8) | (uint32_t(b[2]) << 16) | (uint32_t(b[3]) << 24);
+    uint32_t word = 0;
+    for (size_t i = 0; i < count; i++) word |= uint32_t(b[i]) << (8 * i);
+    return word;
+}
 
-        mul64 = static_cast<uint64_t>(edi) * edx;
-        eax = static_cast<uint32_t>(mul64);
-        edx = static_cast<uint32_t>(mul64 >> 32);
+// Normalization four bytes at a time, matching the per-char loops
+constexpr uint32_t kOnes = 0x01010101;
+constexpr uint32_t kHighBits = 0x80808080;
 
-        edx += edx;
-        eax += edx;
-        if (eax < edx) eax += 2;
+// High bit set in each byte of word equal to ch
+uint32_t MatchBytes(uint32_t word, uint8_t ch) {
+    uint32_t x = word ^ (kOnes * ch);
+    return ~(((x & ~kHighBits) + ~kHighBits) | x) & kHighBits;
+}
 
-        edi = eax;
-    }
+uint32_t ReplaceBytes(uint32_t word, uint8_t from, uint8_t to) {
+    return word ^ ((MatchBytes(word, from) >> 7) * uint8_t(from ^ to));
+}
 
-    v = esi ^ edi;
-    return v;
+uint32_t LowerBytes(uint32_t word) {
+    uint32_t low = word & ~kHighBits;
+    uint32_t atLeastA = low + kOnes * (0x80 - 'A');
+    uint32_t pastZ = low + kOnes * (0x80 - 'Z' - 1);
+    return word | ((atLeastA & ~pastZ & ~word & kHighBits) >> 2);
 }
 
-uint32_t C3HashSystem::PackName(const char* path) {
-    if (!path) return 0;
+} // namespace
 
-    std::string buffer;
-    buffer.reserve(256);
+template <typename Map>
+void C3HashSystem::HashBatch(std::span<const std::string_view> strs, std::span<uint32_t> out, Map map) {
+    const size_t count = std::min(strs.size(), out.size());
 
-    for (int i = 0; path[i]; i++) {
-        if (path[i] == '/') {
-            buffer += ".wdf";
-            break;
+    // Group the strings by word count so every lane of a group runs the
+    // same rounds and the inner loop needs no per-lane bookkeeping
+    std::vector<uint16_t> lengths(count);
+    size_t bucketEnd[kMaxWords + 2] = {};
+    for (size_t i = 0; i < count; i++) {
+        lengths[i] = static_cast<uint16_t>(HashedLength(strs[i]));
+        bucketEnd[(lengths[i] + 3) / 4 + 1]++;
+    }
+    for (size_t w = 1; w <= kMaxWords + 1; w++) bucketEnd[w] += bucketEnd[w - 1];
+    std::vector<uint32_t> order(count);
+    for (size_t i = 0; i < count; i++) order[bucketEnd[(lengths[i] + 3) / 4]++] = static_cast<uint32_t>(i);
+
+    // words[round][lane]; spare lanes of a short group hash stale words and are not stored
+    uint32_t words[kMaxWords + 2][kLanes] = {};
+    size_t begin = 0;
+    for (size_t wordCount = 0; wordCount <= kMaxWords; wordCount++) {
+        const size_t end = bucketEnd[wordCount];
+        for (size_t group = begin; group < end; group += kLanes) {
+            const size_t lanes = std::min(kLanes, end - group);
+            for (size_t lane = 0; lane < lanes; lane++) {
+                const size_t index = order[group + lane];
+                const char* str = strs[index].data();
+                for (size_t w = 0; w < wordCount; w++) {
+                    words[w][lane] = map(LoadWord(str + w * 4, lengths[index] - w * 4));
+                }
+            }
+            for (size_t lane = 0; lane < kLanes; lane++) {
+                words[wordCount][lane] = kSentinel1;
+                words[wordCount + 1][lane] = kSentinel2;
+            }
+
+            // The round key is shared by the group; the lanes' multiply chains are
+            // independent, which also leaves this loop open to vectorization
+            State first;
+            uint32_t esi[kLanes];
+            uint32_t edi[kLanes];
+            for (size_t lane = 0; lane < kLanes; lane++) {
+                esi[lane] = first.esi;
+                edi[lane] = first.edi;
+            }
+            uint32_t v = first.v;
+            for (size_t round = 0; round < wordCount + 2; round++) {
+                v = RotateLeft(v, 1);
+                const uint32_t w = kRoundKey ^ v;
+                for (size_t lane = 0; lane < kLanes; lane++) Round(w, esi[lane], edi[lane], words[round][lane]);
+            }
+            for (size_t lane = 0; lane < lanes; lane++) out[order[group + lane]] = esi[lane] ^ edi[lane];
         }
-        buffer += std::tolower(path[i]);
+        begin = end;
     }
-
-    if (buffer.empty()) return 0;
-    return StringToID(buffer.c_str());
 }
 
-uint32_t C3HashSystem::RealName(const char* path) {
-    if (!path) return 0;
-
-    std::string normalized;
-    normalized.reserve(256);
+void C3HashSystem::StringToIDBatch(std::span<const std::string_view> strs, std::span<uint32_t> out) {
+    HashBatch(strs, out, [](uint32_t word) { return word; });
+}
 
-    for (int i = 0; path[i]; i++) {
-        char ch = path[i];
-        if (ch >= 'A' && ch <= 'Z') {
-            normalized += (ch - 'A' + 'a');
-        }
-        else if (ch == '\\') {
-            normalized += '/';
-        }
-        else {
-            normalized += ch;
-        }
-    }
+void C3HashSystem::RealNameBatch(std::span<const std::string_view> paths, std::span<uint32_t> out) {
+    HashBatch(paths, out, [](uint32_t word) { return LowerBytes(ReplaceBytes(word, '\\', '/')); });
+}
 
-    return StringToID(normalized.c_str());
-}
\ No newline at end of file
+void C3HashSystem::DnpRealNameBatch(std::span<const std::string_view> paths, std::span<uint32_t> out) {
+    HashBatch(paths, out, [](uint32_t word) { return LowerBytes(ReplaceBytes(word, '/', '\\')); });
+}
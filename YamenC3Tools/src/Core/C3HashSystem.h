@@ -1,16 +1,193 @@
 #pragma once
 #include <cstdint>
-#include <string>
+#include <span>
+#include <string_view>
 
 // Optional: For WDF/DNP archive support
+//
+// Every id is computed without allocating: path normalization (lowercasing,
+// separator conversion, pack-name truncation) feeds bytes straight into the
+// hash rounds, four at a time. Only the first 256 normalized characters
+// take part, and a NUL ends the input even inside a string_view.
 class C3HashSystem {
 public:
-    static uint32_t StringToID(const char* str);
-    static uint32_t PackName(const char* path);
-    static uint32_t RealName(const char* path);
+    static constexpr size_t kMaxHashLength = 256;
+
+    static constexpr uint32_t StringToID(const char* str) { return str ? StringToID(std::string_view(str)) : 0; }
+    static constexpr uint32_t PackName(const char* path) { return path ? PackName(std::string_view(path)) : 0; }
+    static constexpr uint32_t RealName(const char* path) { return path ? RealName(std::string_view(path)) : 0; }
+
+    // DawnPack (DNP) ids: lowercase with '\\' separators, pack is the first component
+    static constexpr uint32_t DnpPackName(const char* path) { return path ? DnpPackName(std::string_view(path)) : 0; }
+    static constexpr uint32_t DnpRealName(const char* path) { return path ? DnpRealName(std::string_view(path)) : 0; }
+
+    // Need not be null-terminated. Also usable in constant expressions, so
+    // ids of well-known assets can be computed by the compiler.
+    static constexpr uint32_t StringToID(std::string_view str);
+    static constexpr uint32_t PackName(std::string_view path);
+    static constexpr uint32_t RealName(std::string_view path);
+    static constexpr uint32_t DnpPackName(std::string_view path);
+    static constexpr uint32_t DnpRealName(std::string_view path);
+
+    // Many ids at once, bit-identical to the functions above: several strings
+    // are hashed in interleaved lanes so their multiply chains overlap.
+    // out must hold at least strs.size() ids.
+    static void StringToIDBatch(std::span<const std::string_view> strs, std::span<uint32_t> out);
+    static void RealNameBatch(std::span<const std::string_view> paths, std::span<uint32_t> out);
+    static void DnpRealNameBatch(std::span<const std::string_view> paths, std::span<uint32_t> out);
 
 private:
-    static inline uint32_t RotateLeft(uint32_t value, int shift) {
+    // The rounds over one little-endian input word. A hash is every input
+    // word followed by the two sentinels; the result is esi ^ edi.
+    struct State {
+        uint32_t v = 0xF4FA8928;
+        uint32_t esi = 0x37A8470E;
+        uint32_t edi = 0x7758B42B;
+
+        constexpr void Mix(uint32_t word);
+        constexpr uint32_t Result() const { return esi ^ edi; }
+    };
+
+    // One round given the round key w, which depends only on the word's position
+    static constexpr void Round(uint32_t w, uint32_t& esi, uint32_t& edi, uint32_t word);
+
+    static constexpr uint32_t kRoundKey = 0x267B0B11;
+    static constexpr uint32_t kSentinel1 = 0x9BE74448;
+    static constexpr uint32_t kSentinel2 = 0x66F42C48;
+
+    static constexpr uint32_t RotateLeft(uint32_t value, int shift) {
         return (value << shift) | (value >> (32 - shift));
     }
-};
\ No newline at end of file
+
+    // Packs normalized bytes into words and mixes each one as it fills
+    class Stream {
+    public:
+        // False once kMaxHashLength bytes have been taken
+        constexpr bool Put(char ch) {
+            if (m_count == kMaxHashLength) return false;
+            m_word |= uint32_t(static_cast<unsigned char>(ch)) << (8 * (m_count & 3));
+            if ((++m_count & 3) == 0) {
+                m_state.Mix(m_word);
+                m_word = 0;
+            }
+            return true;
+        }
+
+        constexpr size_t Count() const { return m_count; }
+
+        constexpr uint32_t Finish() {
+            if (m_count & 3) m_state.Mix(m_word);
+            m_state.Mix(kSentinel1);
+            m_state.Mix(kSentinel2);
+            return m_state.Result();
+        }
+
+    private:
+        State m_state;
+        uint32_t m_word = 0;
+        size_t m_count = 0;
+    };
+
+    template <typename Map>
+    static void HashBatch(std::span<const std::string_view> strs, std::span<uint32_t> out, Map map);
+
+    static constexpr char Lower(char ch) { return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch; }
+};
+
+constexpr void C3HashSystem::State::Mix(uint32_t word) {
+    v = RotateLeft(v, 1);
+    Round(kRoundKey ^ v, esi, edi, word);
+}
+
+constexpr void C3HashSystem::Round(uint32_t w, uint32_t& esi, uint32_t& edi, uint32_t word) {
+    constexpr uint32_t A = 0x2040801;
+    constexpr uint32_t B = 0x804021;
+    constexpr uint32_t C = 0xBFEF7FDF;
+    constexpr uint32_t D = 0x7DFEFBFF;
+
+    uint32_t eax = word;
+    esi ^= eax;
+    edi ^= eax;
+
+    uint32_t edx = w + edi;
+    edx = (edx | A) & C;
+
+    uint64_t mul64 = static_cast<uint64_t>(esi) * edx;
+    eax = static_cast<uint32_t>(mul64);
+    edx = static_cast<uint32_t>(mul64 >> 32);
+
+    uint32_t carry = 0;
+    eax += edx;
+    if (eax < edx) carry = 1;
+    eax += carry;
+
+    esi = eax;
+
+    edx = w + esi;
+    edx = (edx | B) & D;
+
+    mul64 = static_cast<uint64_t>(edi) * edx;
+    eax = static_cast<uint32_t>(mul64);
+    edx = static_cast<uint32_t>(mul64 >> 32);
+
+    edx += edx;
+    eax += edx;
+    if (eax < edx) eax += 2;
+
+    edi = eax;
+}
+
+constexpr uint32_t C3HashSystem::StringToID(std::string_view str) {
+    Stream stream;
+    for (size_t i = 0; i < str.size() && str[i] && stream.Put(str[i]); i++) {}
+    return stream.Finish();
+}
+
+constexpr uint32_t C3HashSystem::PackName(std::string_view path) {
+    // First component plus ".wdf", lowercased; the whole path if it has no '/'
+    Stream stream;
+    for (size_t i = 0; i < path.size() && path[i]; i++) {
+        if (path[i] == '/') {
+            for (char ch : std::string_view(".wdf")) stream.Put(ch);
+            break;
+        }
+        if (!stream.Put(Lower(path[i]))) break;
+    }
+    return stream.Count() ? stream.Finish() : 0;
+}
+
+constexpr uint32_t C3HashSystem::RealName(std::string_view path) {
+    Stream stream;
+    for (size_t i = 0; i < path.size() && path[i]; i++) {
+        char ch = path[i] == '\\' ? '/' : Lower(path[i]);
+        if (!stream.Put(ch)) break;
+    }
+    return stream.Finish();
+}
+
+constexpr uint32_t C3HashSystem::DnpPackName(std::string_view path) {
+    Stream stream;
+    for (size_t i = 0; i < path.size() && path[i] && path[i] != '/' && path[i] != '\\'; i++) {
+        if (!stream.Put(Lower(path[i]))) break;
+    }
+    return stream.Finish();
+}
+
+constexpr uint32_t C3HashSystem::DnpRealName(std::string_view path) {
+    Stream stream;
+    for (size_t i = 0; i < path.size() && path[i]; i++) {
+        char ch = path[i] == '/' ? '\\' : Lower(path[i]);
+        if (!stream.Put(ch)) break;
+    }
+    return stream.Finish();
+}
+
+// "c3/mesh/1.c3"_c3id is RealName of the path and "c3/mesh/1.c3"_c3pack is
+// its PackName, both evaluated by the compiler
+consteval uint32_t operator""_c3id(const char* str, size_t length) {
+    return C3HashSystem::RealName(std::string_view(str, length));
+}
+
+consteval uint32_t operator""_c3pack(const char* str, size_t length) {
+    return C3HashSystem::PackName(std::string_view(str, length));
+}
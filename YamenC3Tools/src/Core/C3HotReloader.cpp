@@ -0,0 +1,441 @@
+#include "C3HotReloader.h"
+#include "C3Model.h"
+#include "C3VirtualFileSystem.h"
+#include <algorithm>
+#include <filesystem>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+C3HotReloader::C3HotReloader(const Options& options) : m_options(options) {}
+
+C3HotReloader::~C3HotReloader() {
+    Stop();
+}
+
+const char* C3HotReloader::GetBackendName(Backend backend) {
+    return backend == Backend::Inotify ? "inotify" : "polling";
+}
+
+bool C3HotReloader::Watch(const std::string& root) {
+    std::error_code ec;
+    if (!fs::is_directory(root, ec)) {
+        m_lastError = "Not a directory: " + root;
+        return false;
+    }
+    // Disk paths are built from the root as given, so matching them back is a prefix test
+    std::string normalized = fs::path(root).lexically_normal().generic_string();
+    while (normalized.size() > 1 && normalized.back() == '/') normalized.pop_back();
+    m_roots.push_back(normalized);
+    return true;
+}
+
+void C3HotReloader::AddCache(C3AssetCache* cache) {
+    if (cache) m_caches.push_back(cache);
+}
+
+void C3HotReloader::AddListener(Listener* listener) {
+    if (listener) m_listeners.push_back(listener);
+}
+
+void C3HotReloader::RemoveListener(Listener* listener) {
+    m_listeners.erase(std::remove(m_listeners.begin(), m_listeners.end(), listener), m_listeners.end());
+}
+
+bool C3HotReloader::Start() {
+    if (IsRunning()) return true;
+    if (m_roots.empty()) {
+        m_lastError = "No directory to watch";
+        return false;
+    }
+    m_stopping.store(false);
+    m_pending.clear();
+    m_knownFiles.clear();
+
+    if (m_options.allowInotify && StartInotify()) {
+        m_backend = Backend::Inotify;
+        m_thread = std::thread([this] { InotifyLoop(); });
+        return true;
+    }
+    m_backend = Backend::Polling;
+    m_files.clear();
+    ScanFiles(false);
+    m_thread = std::thread([this] { PollLoop(); });
+    return true;
+}
+
+void C3HotReloader::Stop() {
+    if (!IsRunning()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping.store(true);
+    }
+    m_wake.notify_all();
+#if defined(__linux__)
+    if (m_wakeFd >= 0) {
+        uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = write(m_wakeFd, &one, sizeof(one));
+    }
+#endif
+    m_thread.join();
+    CloseInotify();
+    // Anything still waiting out its window is dropped; the next Start() sees the files as they are
+    m_pending.clear();
+}
+
+C3HotReloader::Stats C3HotReloader::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+std::string C3HotReloader::VirtualPath(const std::string& diskPath) const {
+    for (const auto& root : m_roots) {
+        if (diskPath.size() > root.size() + 1 && diskPath.compare(0, root.size(), root) == 0 &&
+            diskPath[root.size()] == '/') {
+            return C3VirtualFileSystem::NormalizePath(diskPath.substr(root.size() + 1));
+        }
+    }
+    return {};
+}
+
+void C3HotReloader::Touch(const std::string& diskPath) {
+    // Trailing debounce: every event pushes the file's window out again
+    m_pending[diskPath] = Clock::now() + std::chrono::milliseconds(m_options.debounceMs);
+}
+
+int C3HotReloader::ProcessDue() {
+    if (m_pending.empty()) return -1;
+
+    const Clock::time_point now = Clock::now();
+    std::vector<std::string> due;
+    Clock::time_point next = Clock::time_point::max();
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (it->second <= now) {
+            due.push_back(it->first);
+            it = m_pending.erase(it);
+        }
+        else {
+            next = std::min(next, it->second);
+            ++it;
+        }
+    }
+
+    if (!due.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.batches++;
+        }
+        std::sort(due.begin(), due.end());
+        for (const auto& path : due) {
+            if (m_stopping.load(std::memory_order_relaxed)) break;
+            Reload(path);
+        }
+    }
+
+    if (m_pending.empty()) return -1;
+    auto wait = std::chrono::ceil<std::chrono::milliseconds>(next - Clock::now()).count();
+    return static_cast<int>(std::max<decltype(wait)>(wait, 0));
+}
+
+void C3HotReloader::Reload(const std::string& diskPath) {
+    Change change;
+    change.diskPath = diskPath;
+    change.path = VirtualPath(diskPath);
+    if (change.path.empty()) return;
+    change.key = C3AssetCache::KeyForPath(change.path);
+
+    std::error_code ec;
+    const fs::file_status status = fs::status(diskPath, ec);
+    if (fs::is_directory(status)) return;
+
+    // Only what a cache holds is re-read; anything else is loaded fresh on its next use
+    std::vector<std::pair<C3AssetCache*, C3AssetCache::Kind>> holders;
+    for (C3AssetCache* cache : m_caches) {
+        C3AssetCache::Kind kind;
+        if (cache->FindKind(change.key, kind)) holders.emplace_back(cache, kind);
+    }
+    if (!holders.empty()) change.kind = holders.front().second;
+
+    // The file system first, so a reload triggered by a listener or a miss
+    // resolves the path the way the caches are about to see it
+    if (m_vfs) {
+        if (fs::exists(status)) m_vfs->AddLooseFile(change.path, diskPath);
+        else m_vfs->RemoveLooseFile(change.path);
+    }
+
+    if (m_backend == Backend::Inotify) {
+        if (fs::exists(status)) m_knownFiles.insert(diskPath);
+        else m_knownFiles.erase(diskPath);
+    }
+
+    if (!fs::exists(status)) {
+        change.type = ChangeType::Removed;
+        for (const auto& holder : holders) holder.first->Erase(change.key);
+    }
+    else if (!holders.empty()) {
+        bool wantModel = false, wantTexture = false;
+        for (const auto& holder : holders) {
+            if (holder.second == C3AssetCache::Kind::Texture) wantTexture = true;
+            else wantModel = true;
+        }
+
+        // Parsed with no lock held; the caches only see the finished value
+        std::vector<uint8_t> bytes;
+        if (!C3VirtualFileSystem::ReadDiskFile(diskPath, bytes, &change.error)) {
+            change.type = ChangeType::Failed;
+        }
+        else {
+            if (wantModel) {
+                auto model = std::make_shared<C3Model>();
+                if (model->LoadFromMemory(bytes)) {
+                    change.model = std::move(model);
+                }
+                else {
+                    change.type = ChangeType::Failed;
+                    change.error = model->GetError();
+                }
+            }
+            if (wantTexture && change.type != ChangeType::Failed) {
+                change.texture = std::make_shared<const C3AssetCache::Blob>(std::move(bytes));
+            }
+        }
+
+        if (change.type != ChangeType::Failed) {
+            for (const auto& holder : holders) {
+                if (holder.second == C3AssetCache::Kind::Texture) holder.first->PutTexture(change.key, change.texture);
+                else holder.first->PutModel(change.key, change.model, holder.second);
+            }
+            change.reloaded = true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.changes++;
+        if (change.reloaded) m_stats.reloaded++;
+        if (change.type == ChangeType::Removed) m_stats.removed++;
+        if (change.type == ChangeType::Failed) m_stats.failed++;
+    }
+    for (Listener* listener : m_listeners) {
+        listener->OnAssetChanged(change);
+    }
+}
+
+void C3HotReloader::PollLoop() {
+    const auto interval = std::chrono::milliseconds(std::max(1u, m_options.pollIntervalMs));
+    Clock::time_point nextScan = Clock::now() + interval;
+    while (!m_stopping.load()) {
+        if (Clock::now() >= nextScan) {
+            ScanFiles(true);
+            nextScan = Clock::now() + interval;
+        }
+        Clock::time_point wakeAt = nextScan;
+        int dueMs = ProcessDue();
+        if (dueMs >= 0) wakeAt = std::min(wakeAt, Clock::now() + std::chrono::milliseconds(dueMs));
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.wait_until(lock, wakeAt, [this] { return m_stopping.load(); });
+    }
+}
+
+void C3HotReloader::ScanFiles(bool queueChanges) {
+    std::unordered_map<std::string, FileState> files;
+    files.reserve(m_files.size());
+    for (const auto& root : m_roots) {
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end;
+            it != end; it.increment(ec)) {
+            if (ec) break;
+            if (!it->is_regular_file(ec)) continue;
+            FileState state;
+            state.size = it->file_size(ec);
+            state.writeTime = static_cast<int64_t>(it->last_write_time(ec).time_since_epoch().count());
+            files.emplace(it->path().generic_string(), state);
+        }
+    }
+
+    if (queueChanges) {
+        uint64_t events = 0;
+        for (const auto& [path, state] : files) {
+            auto it = m_files.find(path);
+            if (it == m_files.end() || it->second.size != state.size || it->second.writeTime != state.writeTime) {
+                Touch(path);
+                events++;
+            }
+        }
+        for (const auto& entry : m_files) {
+            if (!files.count(entry.first)) {
+                Touch(entry.first);
+                events++;
+            }
+        }
+        if (events) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.events += events;
+        }
+    }
+    m_files = std::move(files);
+}
+
+#if defined(__linux__)
+
+namespace {
+
+constexpr uint32_t kWatchMask = IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE |
+    IN_ONLYDIR | IN_EXCL_UNLINK;
+
+} // namespace
+
+bool C3HotReloader::StartInotify() {
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_inotifyFd < 0 || m_wakeFd < 0) {
+        m_lastError = std::string("inotify unavailable: ") + strerror(errno);
+        CloseInotify();
+        return false;
+    }
+    for (const auto& root : m_roots) {
+        if (!AddWatchTree(root, false)) {
+            CloseInotify();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool C3HotReloader::AddWatchTree(const std::string& dir, bool queueFiles) {
+    int wd = inotify_add_watch(m_inotifyFd, dir.c_str(), kWatchMask);
+    if (wd < 0) {
+        // Out of watches (fs.inotify.max_user_watches) is the usual cause
+        m_lastError = "Failed to watch " + dir + ": " + strerror(errno);
+        return false;
+    }
+    m_watchDirs[wd] = dir;
+
+    // Also catches files written into a new directory before its watch existed
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec), end;
+        it != end; it.increment(ec)) {
+        if (ec) break;
+        if (it->is_directory(ec)) {
+            const std::string sub = it->path().generic_string();
+            wd = inotify_add_watch(m_inotifyFd, sub.c_str(), kWatchMask);
+            if (wd < 0) {
+                m_lastError = "Failed to watch " + sub + ": " + strerror(errno);
+                return false;
+            }
+            m_watchDirs[wd] = sub;
+        }
+        else if (it->is_regular_file(ec)) {
+            std::string file = it->path().generic_string();
+            if (queueFiles) Touch(file);
+            m_knownFiles.insert(std::move(file));
+        }
+    }
+    return true;
+}
+
+void C3HotReloader::ForgetTree(const std::string& dir) {
+    // Its watches would keep reporting under the old name
+    const std::string prefix = dir + "/";
+    for (auto it = m_watchDirs.begin(); it != m_watchDirs.end();) {
+        if (it->second == dir || it->second.compare(0, prefix.size(), prefix) == 0) {
+            inotify_rm_watch(m_inotifyFd, it->first);
+            it = m_watchDirs.erase(it);
+        }
+        else ++it;
+    }
+    for (const auto& file : m_knownFiles) {
+        if (file.compare(0, prefix.size(), prefix) == 0) Touch(file);
+    }
+}
+
+void C3HotReloader::CloseInotify() {
+    if (m_inotifyFd >= 0) close(m_inotifyFd);
+    if (m_wakeFd >= 0) close(m_wakeFd);
+    m_inotifyFd = -1;
+    m_wakeFd = -1;
+    m_watchDirs.clear();
+    m_knownFiles.clear();
+}
+
+void C3HotReloader::InotifyLoop() {
+    alignas(inotify_event) char buffer[64 * 1024];
+    pollfd fds[2] = { { m_inotifyFd, POLLIN, 0 }, { m_wakeFd, POLLIN, 0 } };
+
+    while (!m_stopping.load()) {
+        int timeout = ProcessDue();
+        if (poll(fds, 2, timeout) < 0 && errno != EINTR) break;
+        if (m_stopping.load()) break;
+        if (!(fds[0].revents & POLLIN)) continue;
+
+        uint64_t events = 0, overflows = 0;
+        for (;;) {
+            ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+            if (length <= 0) break;
+            for (char* p = buffer; p < buffer + length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+                p += sizeof(inotify_event) + event->len;
+                events++;
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    // Events were lost: treat every file as changed; unchanged
+                    // ones are re-read but parse to the same result. Files known
+                    // from before but gone from the rescan are reported removed.
+                    overflows++;
+                    for (const auto& file : m_knownFiles) Touch(file);
+                    for (const auto& root : m_roots) AddWatchTree(root, true);
+                    continue;
+                }
+                if (event->mask & IN_IGNORED) {
+                    m_watchDirs.erase(event->wd);
+                    continue;
+                }
+                auto dir = m_watchDirs.find(event->wd);
+                if (dir == m_watchDirs.end() || event->len == 0) continue;
+                const std::string path = dir->second + "/" + event->name;
+
+                if (event->mask & IN_ISDIR) {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        AddWatchTree(path, true);
+                    }
+                    else if (event->mask & (IN_MOVED_FROM | IN_DELETE)) {
+                        ForgetTree(path);
+                    }
+                    continue;
+                }
+                Touch(path);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.events += events;
+        m_stats.overflows += overflows;
+    }
+}
+
+#else
+
+bool C3HotReloader::StartInotify() {
+    return false;
+}
+
+bool C3HotReloader::AddWatchTree(const std::string&, bool) {
+    return false;
+}
+
+void C3HotReloader::ForgetTree(const std::string&) {}
+
+void C3HotReloader::CloseInotify() {}
+
+void C3HotReloader::InotifyLoop() {}
+
+#endif
@@ -0,0 +1,152 @@
+#pragma once
+#include "C3AssetCache.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class C3Model;
+class C3VirtualFileSystem;
+
+// Watches asset directories and reloads files as artists save them. On
+// Linux changes come from inotify; elsewhere, or if inotify is refused,
+// the trees are polled for new sizes and write times. Events are debounced
+// per file (an editor's truncate, write and rename arrive as one change),
+// then each changed file that a registered cache holds is read and parsed
+// again and swapped in under the same key. Readers holding the previous
+// version keep it until they let go; a swap only takes the cache shard's
+// lock for the moment it takes to replace one pointer. Listeners are told
+// about every change after the caches have the new version. With a file
+// system attached, created and saved files are registered with it as loose
+// files and removed ones unregistered, so lookups stop reporting a new file
+// as missing and a loose override placed next to an archive wins at once.
+//
+// A file that no longer parses is reported as Failed and the cached
+// version is kept, so a half-saved asset never replaces a working one.
+class C3HotReloader {
+public:
+    enum class Backend { Inotify, Polling };
+    enum class ChangeType : uint8_t {
+        Modified, // Reloaded if cached, or just reported
+        Removed,  // Dropped from the caches
+        Failed,   // Could not be read or parsed; caches keep the old version
+    };
+
+    struct Change {
+        ChangeType type = ChangeType::Modified;
+        std::string path;     // Virtual path, relative to the watched root
+        std::string diskPath;
+        C3AssetCache::Key key = 0;
+        C3AssetCache::Kind kind = C3AssetCache::Kind::Model;
+        bool reloaded = false; // Re-read and swapped into at least one cache
+        std::shared_ptr<const C3Model> model;
+        std::shared_ptr<const C3AssetCache::Blob> texture;
+        std::string error;
+    };
+
+    // Called on the watcher thread, one change at a time
+    class Listener {
+    public:
+        virtual ~Listener() = default;
+        virtual void OnAssetChanged(const Change& change) = 0;
+    };
+
+    struct Options {
+        unsigned debounceMs = 150;     // Quiet time after a file's last event
+        unsigned pollIntervalMs = 500; // Polling backend only
+        bool allowInotify = true;
+    };
+
+    struct Stats {
+        uint64_t events = 0;    // Raw notifications, or differences seen when polling
+        uint64_t batches = 0;   // Debounced groups processed
+        uint64_t changes = 0;   // Files reported to listeners
+        uint64_t reloaded = 0;
+        uint64_t removed = 0;
+        uint64_t failed = 0;
+        uint64_t overflows = 0; // Kernel queue overflows, each followed by a rescan
+    };
+
+    C3HotReloader() : C3HotReloader(Options{}) {}
+    explicit C3HotReloader(const Options& options);
+    ~C3HotReloader();
+
+    C3HotReloader(const C3HotReloader&) = delete;
+    C3HotReloader& operator=(const C3HotReloader&) = delete;
+
+    // Setup, before Start(): every file under root, recursively, is
+    // watched under its path relative to root, as AddDirectory maps it
+    bool Watch(const std::string& root);
+    void AddCache(C3AssetCache* cache);
+    void SetFileSystem(C3VirtualFileSystem* vfs) { m_vfs = vfs; }
+    void AddListener(Listener* listener);
+    void RemoveListener(Listener* listener);
+
+    bool Start();
+    void Stop();
+    bool IsRunning() const { return m_thread.joinable(); }
+
+    Backend GetBackend() const { return m_backend; }
+    static const char* GetBackendName(Backend backend);
+    Stats GetStats() const;
+    const std::string& GetLastError() const { return m_lastError; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct FileState {
+        uint64_t size = 0;
+        int64_t writeTime = 0;
+    };
+
+    Options m_options;
+    Backend m_backend = Backend::Polling;
+    std::vector<std::string> m_roots;
+    std::vector<C3AssetCache*> m_caches;
+    C3VirtualFileSystem* m_vfs = nullptr;
+    std::vector<Listener*> m_listeners;
+
+    std::thread m_thread;
+    std::atomic<bool> m_stopping{ false };
+    mutable std::mutex m_mutex;      // Stats, and the stop signal for polling
+    std::condition_variable m_wake;
+    Stats m_stats;
+    std::string m_lastError;
+
+    // Disk path -> when its debounce window ends
+    std::unordered_map<std::string, Clock::time_point> m_pending;
+    // Polling: last seen state of every file
+    std::unordered_map<std::string, FileState> m_files;
+
+    int m_inotifyFd = -1;
+    int m_wakeFd = -1;
+    std::unordered_map<int, std::string> m_watchDirs; // inotify watch -> directory
+    // inotify: every file seen under the roots, so that files a directory
+    // move or a queue overflow took away can still be reported as removed
+    std::unordered_set<std::string> m_knownFiles;
+
+    bool StartInotify();
+    void InotifyLoop();
+    bool AddWatchTree(const std::string& dir, bool queueFiles);
+    // Drops the watches under dir and queues every known file there, which
+    // Reload then reports as removed
+    void ForgetTree(const std::string& dir);
+    void CloseInotify();
+
+    void PollLoop();
+    void ScanFiles(bool queueChanges);
+
+    void Touch(const std::string& diskPath);
+    // Processes every pending file whose window has ended; returns the
+    // time until the next one ends, or -1 if none is pending
+    int ProcessDue();
+    void Reload(const std::string& diskPath);
+    // Root-relative path, or empty if the file is outside every root
+    std::string VirtualPath(const std::string& diskPath) const;
+};
@@ -0,0 +1,167 @@
+#include "C3Lz.h"
+#include <cstring>
+
+namespace {
+
+constexpr size_t kMinMatch = 4;
+constexpr size_t kLastLiterals = 5;  // The block always ends with at least this many literals
+constexpr size_t kMatchFindLimit = 12; // No match may start within this many bytes of the end
+constexpr int kHashBits = 14;
+
+inline uint32_t Read32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+inline uint32_t Hash(uint32_t v) {
+    return (v * 2654435761u) >> (32 - kHashBits);
+}
+
+inline void WriteLength(uint8_t*& op, size_t length) {
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = static_cast<uint8_t>(length);
+}
+
+inline uint8_t* EmitSequence(uint8_t* op, const uint8_t* literals, size_t literalLength,
+    size_t offset, size_t matchLength) {
+    uint8_t* token = op++;
+    size_t matchCode = matchLength - kMinMatch;
+    *token = static_cast<uint8_t>(((literalLength < 15 ? literalLength : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+
+    if (literalLength >= 15) WriteLength(op, literalLength - 15);
+    memcpy(op, literals, literalLength);
+    op += literalLength;
+
+    *op++ = static_cast<uint8_t>(offset);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+
+    if (matchCode >= 15) WriteLength(op, matchCode - 15);
+    return op;
+}
+
+inline uint8_t* EmitLastLiterals(uint8_t* op, const uint8_t* literals, size_t literalLength) {
+    *op++ = static_cast<uint8_t>((literalLength < 15 ? literalLength : 15) << 4);
+    if (literalLength >= 15) WriteLength(op, literalLength - 15);
+    memcpy(op, literals, literalLength);
+    return op + literalLength;
+}
+
+inline bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& length) {
+    uint8_t b;
+    do {
+        if (ip >= end) return false;
+        b = *ip++;
+        length += b;
+    } while (b == 255);
+    return true;
+}
+
+} // namespace
+
+size_t C3Lz::Compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out) {
+    const size_t start = out.size();
+    out.resize(start + CompressBound(size));
+    uint8_t* const dst = out.data() + start;
+    uint8_t* op = dst;
+
+    size_t anchor = 0;
+    if (size > kMatchFindLimit) {
+        int32_t table[1 << kHashBits];
+        memset(table, 0xFF, sizeof(table));
+
+        const size_t matchLimit = size - kLastLiterals;
+        const size_t findLimit = size - kMatchFindLimit;
+        size_t ip = 0;
+
+        while (ip < findLimit) {
+            uint32_t seq = Read32(src + ip);
+            uint32_t h = Hash(seq);
+            int32_t ref = table[h];
+            table[h] = static_cast<int32_t>(ip);
+
+            if (ref < 0 || ip - ref > 65535 || Read32(src + ref) != seq) {
+                ip += 1 + ((ip - anchor) >> 6); // Skip faster through incompressible runs
+                continue;
+            }
+
+            size_t length = kMinMatch;
+            while (ip + length < matchLimit && src[ref + length] == src[ip + length]) length++;
+
+            op = EmitSequence(op, src + anchor, ip - anchor, ip - ref, length);
+            ip += length;
+            anchor = ip;
+
+            if (ip >= 2 && ip < findLimit) {
+                table[Hash(Read32(src + ip - 2))] = static_cast<int32_t>(ip - 2);
+            }
+        }
+    }
+
+    op = EmitLastLiterals(op, src + anchor, size - anchor);
+
+    size_t written = static_cast<size_t>(op - dst);
+    out.resize(start + written);
+    return written;
+}
+
+bool C3Lz::Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize) {
+    const uint8_t* ip = src;
+    const uint8_t* const iend = src + size;
+    uint8_t* op = dst;
+    uint8_t* const oend = dst + rawSize;
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !ReadLength(ip, iend, literalLength)) return false;
+        if (literalLength > static_cast<size_t>(iend - ip) || literalLength > static_cast<size_t>(oend - op)) return false;
+        if (literalLength <= 16 && iend - ip >= 16 && oend - op >= 16) {
+            memcpy(op, ip, 16); // Fixed-size copy; the excess is overwritten by what follows
+        }
+        else {
+            memcpy(op, ip, literalLength);
+        }
+        ip += literalLength;
+        op += literalLength;
+
+        if (ip == iend) break; // Last sequence carries literals only
+
+        if (iend - ip < 2) return false;
+        size_t offset = ip[0] | (size_t(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !ReadLength(ip, iend, matchLength)) return false;
+        matchLength += kMinMatch;
+        if (matchLength > static_cast<size_t>(oend - op)) return false;
+
+        const uint8_t* match = op - offset;
+        if (offset >= 16 && static_cast<size_t>(oend - op) >= matchLength + 16) {
+            // 16-byte steps never read bytes this copy has yet to write
+            for (size_t i = 0; i < matchLength; i += 16) memcpy(op + i, match + i, 16);
+            op += matchLength;
+        }
+        else if (offset >= matchLength) {
+            memcpy(op, match, matchLength);
+            op += matchLength;
+        }
+        else if (offset >= 8) {
+            // Overlapping, but each 8-byte step reads bytes already written
+            size_t i = 0;
+            for (; i + 8 <= matchLength; i += 8) memcpy(op + i, match + i, 8);
+            for (; i < matchLength; i++) op[i] = match[i];
+            op += matchLength;
+        }
+        else {
+            for (size_t i = 0; i < matchLength; i++) *op++ = *match++;
+        }
+    }
+
+    return op == oend;
+}
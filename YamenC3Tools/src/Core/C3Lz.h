@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Byte-oriented LZ77 codec using the LZ4 block layout: a token with
+// literal/match length nibbles, 16-bit offsets and a 4-byte minimum match.
+// Fast greedy matching; decoding is bounds checked against both buffers.
+class C3Lz {
+public:
+    // Worst-case compressed size for 'size' input bytes
+    static size_t CompressBound(size_t size) { return size + size / 255 + 16; }
+
+    // Appends the compressed block to 'out' and returns its size
+    static size_t Compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out);
+
+    // Decodes exactly 'rawSize' bytes; false on malformed input
+    static bool Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize);
+};
@@ -0,0 +1,182 @@
+#include "C3MappedFile.h"
+#include <utility>
+
+#ifdef PLATFORM_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+C3MappedFile::~C3MappedFile() {
+    Close();
+}
+
+C3MappedFile::C3MappedFile(C3MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+C3MappedFile& C3MappedFile::operator=(C3MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        m_handle = std::exchange(other.m_handle, kInvalidHandle);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+#ifdef PLATFORM_WINDOWS
+        m_mapping = std::exchange(other.m_mapping, 0);
+#endif
+        m_path = std::move(other.m_path);
+        m_lastError = std::move(other.m_lastError);
+    }
+    return *this;
+}
+
+bool C3MappedFile::Open(const std::string& path) {
+    Close();
+    m_path = path;
+
+#ifdef PLATFORM_WINDOWS
+    // Overlapped so concurrent ReadAt calls are not serialized on the file object
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        m_lastError = "Failed to open file: " + path;
+        return false;
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        m_lastError = "Failed to query file size: " + path;
+        return false;
+    }
+
+    m_handle = reinterpret_cast<intptr_t>(file);
+    m_size = static_cast<size_t>(size.QuadPart);
+    if (m_size == 0) return true; // Empty files cannot be mapped
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        Close();
+        m_lastError = "Failed to map file: " + path;
+        return false;
+    }
+    m_mapping = reinterpret_cast<intptr_t>(mapping);
+
+    m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data) {
+        Close();
+        m_lastError = "Failed to map view of file: " + path;
+        return false;
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        m_lastError = "Failed to open file: " + path;
+        return false;
+    }
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        m_lastError = "Failed to query file size: " + path;
+        return false;
+    }
+
+    m_handle = fd;
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size == 0) return true;
+
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        Close();
+        m_lastError = "Failed to map file: " + path;
+        return false;
+    }
+    m_data = static_cast<const uint8_t*>(data);
+#endif
+
+    return true;
+}
+
+void C3MappedFile::Close() {
+#ifdef PLATFORM_WINDOWS
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(reinterpret_cast<HANDLE>(m_mapping));
+    if (m_handle != kInvalidHandle) CloseHandle(reinterpret_cast<HANDLE>(m_handle));
+    m_mapping = 0;
+#else
+    if (m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+    if (m_handle != kInvalidHandle) ::close(static_cast<int>(m_handle));
+#endif
+    m_handle = kInvalidHandle;
+    m_data = nullptr;
+    m_size = 0;
+}
+
+std::span<const uint8_t> C3MappedFile::View(uint64_t offset, uint64_t size) const {
+    if (!m_data || offset > m_size || size > m_size - offset) return {};
+    return { m_data + offset, static_cast<size_t>(size) };
+}
+
+bool C3MappedFile::Prefetch(uint64_t offset, uint64_t size) const {
+    std::span<const uint8_t> range = View(offset, size);
+    if (range.empty()) return false;
+
+#ifdef PLATFORM_WINDOWS
+    WIN32_MEMORY_RANGE_ENTRY entry{ const_cast<uint8_t*>(range.data()), range.size() };
+    return PrefetchVirtualMemory(GetCurrentProcess(), 1, &entry, 0) != 0;
+#else
+    // madvise needs a page-aligned start
+    const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t begin = reinterpret_cast<uintptr_t>(range.data()) & ~(page - 1);
+    uintptr_t end = reinterpret_cast<uintptr_t>(range.data()) + range.size();
+    return madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED) == 0;
+#endif
+}
+
+bool C3MappedFile::ReadAt(uint64_t offset, void* dst, size_t size) const {
+    if (m_handle == kInvalidHandle || offset > m_size || size > m_size - offset) return false;
+
+#ifdef PLATFORM_WINDOWS
+    // One wait event per thread; each read carries its own offset
+    struct ThreadEvent {
+        HANDLE handle = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+        ~ThreadEvent() { if (handle) CloseHandle(handle); }
+    };
+    thread_local ThreadEvent event;
+    if (!event.handle) return false;
+
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    while (size > 0) {
+        OVERLAPPED ov{};
+        ov.Offset = static_cast<DWORD>(offset);
+        ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        ov.hEvent = event.handle;
+        DWORD chunk = static_cast<DWORD>(size > 0x40000000 ? 0x40000000 : size);
+        DWORD bytes = 0;
+        HANDLE file = reinterpret_cast<HANDLE>(m_handle);
+        if (!ReadFile(file, out, chunk, nullptr, &ov) && ::GetLastError() != ERROR_IO_PENDING) {
+            return false;
+        }
+        if (!GetOverlappedResult(file, &ov, &bytes, TRUE) || bytes == 0) {
+            return false;
+        }
+        out += bytes;
+        offset += bytes;
+        size -= bytes;
+    }
+#else
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    while (size > 0) {
+        ssize_t bytes = pread(static_cast<int>(m_handle), out, size, static_cast<off_t>(offset));
+        if (bytes <= 0) return false;
+        out += bytes;
+        offset += static_cast<uint64_t>(bytes);
+        size -= static_cast<size_t>(bytes);
+    }
+#endif
+    return true;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string>
+
+// Read-only view of a whole file. The mapping is immutable once Open()
+// returns, so any number of threads may read through Data() or ReadAt()
+// concurrently without locking.
+class C3MappedFile {
+public:
+    C3MappedFile() = default;
+    ~C3MappedFile();
+
+    C3MappedFile(const C3MappedFile&) = delete;
+    C3MappedFile& operator=(const C3MappedFile&) = delete;
+    C3MappedFile(C3MappedFile&& other) noexcept;
+    C3MappedFile& operator=(C3MappedFile&& other) noexcept;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return m_handle != kInvalidHandle; }
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+    const std::string& GetPath() const { return m_path; }
+    const std::string& GetLastError() const { return m_lastError; }
+
+    // Bounds-checked sub-range of the mapping; empty on overflow
+    std::span<const uint8_t> View(uint64_t offset, uint64_t size) const;
+
+    // Asks the OS to start reading the range into memory (madvise WILLNEED /
+    // PrefetchVirtualMemory) and returns without waiting
+    bool Prefetch(uint64_t offset, uint64_t size) const;
+
+    // Positional read through the file handle (pread / overlapped ReadFile),
+    // for callers that want the bytes in their own buffer
+    bool ReadAt(uint64_t offset, void* dst, size_t size) const;
+
+private:
+    static constexpr intptr_t kInvalidHandle = -1;
+
+    intptr_t m_handle = kInvalidHandle;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef PLATFORM_WINDOWS
+    intptr_t m_mapping = 0;
+#endif
+    std::string m_path;
+    std::string m_lastError;
+};
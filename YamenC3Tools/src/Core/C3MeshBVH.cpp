@@ -0,0 +1,402 @@
+#include "C3MeshBVH.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace DirectX;
+
+namespace {
+
+constexpr int kBinCount = 12;
+constexpr uint32_t kMaxLeafSize = 4;
+constexpr int kMaxStackDepth = 64;
+// A traversal holds at most depth + 1 nodes, so Build() keeps the tree this shallow
+constexpr uint32_t kMaxTreeDepth = kMaxStackDepth - 1;
+
+// Levels of median splits needed to bring 'count' triangles down to leaves
+uint32_t MedianLevels(uint32_t count) {
+    uint32_t levels = 0;
+    for (uint64_t capacity = kMaxLeafSize; capacity < count; capacity *= 2) levels++;
+    return levels;
+}
+
+struct Bounds {
+    XMFLOAT3 bmin{ FLT_MAX, FLT_MAX, FLT_MAX };
+    XMFLOAT3 bmax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    void Grow(const XMFLOAT3& p) {
+        bmin.x = std::min(bmin.x, p.x); bmin.y = std::min(bmin.y, p.y); bmin.z = std::min(bmin.z, p.z);
+        bmax.x = std::max(bmax.x, p.x); bmax.y = std::max(bmax.y, p.y); bmax.z = std::max(bmax.z, p.z);
+    }
+
+    void Grow(const Bounds& b) {
+        if (b.bmin.x > b.bmax.x) return;
+        Grow(b.bmin);
+        Grow(b.bmax);
+    }
+
+    float Area() const {
+        if (bmin.x > bmax.x) return 0.0f;
+        float dx = bmax.x - bmin.x, dy = bmax.y - bmin.y, dz = bmax.z - bmin.z;
+        return dx * dy + dy * dz + dz * dx;
+    }
+};
+
+inline float Axis(const XMFLOAT3& v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+// Slab test with both ends in one SIMD register pair; returns entry distance or FLT_MAX
+inline float IntersectBox(const XMFLOAT3& bmin, const XMFLOAT3& bmax,
+    FXMVECTOR origin, FXMVECTOR invDir, float maxT) {
+    XMVECTOR t0 = XMVectorMultiply(XMVectorSubtract(XMLoadFloat3(&bmin), origin), invDir);
+    XMVECTOR t1 = XMVectorMultiply(XMVectorSubtract(XMLoadFloat3(&bmax), origin), invDir);
+    XMFLOAT3 lo, hi;
+    XMStoreFloat3(&lo, XMVectorMin(t0, t1));
+    XMStoreFloat3(&hi, XMVectorMax(t0, t1));
+    float enter = std::max(std::max(lo.x, lo.y), std::max(lo.z, 0.0f));
+    float exit = std::min(std::min(hi.x, hi.y), std::min(hi.z, maxT));
+    return (enter <= exit) ? enter : FLT_MAX;
+}
+
+// Moller-Trumbore, vectorised over xyz
+inline bool IntersectTriangle(FXMVECTOR origin, FXMVECTOR dir, const XMFLOAT3& a, const XMFLOAT3& b,
+    const XMFLOAT3& c, float maxT, float& outT, float& outU, float& outV) {
+    XMVECTOR p0 = XMLoadFloat3(&a);
+    XMVECTOR e1 = XMVectorSubtract(XMLoadFloat3(&b), p0);
+    XMVECTOR e2 = XMVectorSubtract(XMLoadFloat3(&c), p0);
+    XMVECTOR pv = XMVector3Cross(dir, e2);
+    float det = XMVectorGetX(XMVector3Dot(e1, pv));
+    if (fabsf(det) < 1e-12f) return false;
+    float invDet = 1.0f / det;
+
+    XMVECTOR tv = XMVectorSubtract(origin, p0);
+    float u = XMVectorGetX(XMVector3Dot(tv, pv)) * invDet;
+    if (u < 0.0f || u > 1.0f) return false;
+
+    XMVECTOR qv = XMVector3Cross(tv, e1);
+    float v = XMVectorGetX(XMVector3Dot(dir, qv)) * invDet;
+    if (v < 0.0f || u + v > 1.0f) return false;
+
+    float t = XMVectorGetX(XMVector3Dot(e2, qv)) * invDet;
+    if (t < 0.0f || t > maxT) return false;
+
+    outT = t;
+    outU = u;
+    outV = v;
+    return true;
+}
+
+inline float SafeInverse(float d) {
+    if (fabsf(d) < 1e-20f) d = (d < 0.0f) ? -1e-20f : 1e-20f;
+    return 1.0f / d;
+}
+
+} // namespace
+
+bool C3MeshBVH::Build(const C3Model::MeshPart& mesh, uint32_t meshIndex) {
+    m_nodes.clear();
+    m_tris.clear();
+    m_meshIndex = meshIndex;
+    m_normalTriCount = static_cast<uint32_t>(mesh.normalIndices.size() / 3);
+
+    m_positions.resize(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); i++) {
+        m_positions[i] = mesh.vertices[i].positions[0];
+    }
+
+    const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    auto addTris = [&](const std::vector<uint16_t>& indices, uint32_t idBase) {
+        for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+            Triangle tri{ indices[t], indices[t + 1], indices[t + 2], idBase + static_cast<uint32_t>(t / 3) };
+            if (tri.i0 < vertexCount && tri.i1 < vertexCount && tri.i2 < vertexCount) {
+                m_tris.push_back(tri);
+            }
+        }
+    };
+    addTris(mesh.normalIndices, 0);
+    addTris(mesh.alphaIndices, m_normalTriCount);
+
+    if (m_tris.empty()) return false;
+
+    const uint32_t triCount = static_cast<uint32_t>(m_tris.size());
+    std::vector<Bounds> triBounds(triCount);
+    std::vector<XMFLOAT3> centroids(triCount);
+    for (uint32_t i = 0; i < triCount; i++) {
+        const Triangle& t = m_tris[i];
+        triBounds[i].Grow(m_positions[t.i0]);
+        triBounds[i].Grow(m_positions[t.i1]);
+        triBounds[i].Grow(m_positions[t.i2]);
+        centroids[i] = XMFLOAT3(
+            (triBounds[i].bmin.x + triBounds[i].bmax.x) * 0.5f,
+            (triBounds[i].bmin.y + triBounds[i].bmax.y) * 0.5f,
+            (triBounds[i].bmin.z + triBounds[i].bmax.z) * 0.5f);
+    }
+
+    // Work on a permutation so the triangle data is reordered only once
+    std::vector<uint32_t> order(triCount);
+    for (uint32_t i = 0; i < triCount; i++) order[i] = i;
+
+    m_nodes.reserve(triCount * 2 / kMaxLeafSize + 1);
+    m_nodes.push_back(Node{ {}, 0, {}, triCount });
+
+    // Node index and depth
+    std::vector<std::pair<uint32_t, uint32_t>> stack;
+    stack.push_back({ 0, 0 });
+
+    while (!stack.empty()) {
+        auto [nodeIdx, depth] = stack.back();
+        stack.pop_back();
+
+        uint32_t first = m_nodes[nodeIdx].leftOrFirst;
+        uint32_t count = m_nodes[nodeIdx].count;
+
+        Bounds bounds, centroidBounds;
+        for (uint32_t i = first; i < first + count; i++) {
+            bounds.Grow(triBounds[order[i]]);
+            centroidBounds.Grow(centroids[order[i]]);
+        }
+        m_nodes[nodeIdx].bmin = bounds.bmin;
+        m_nodes[nodeIdx].bmax = bounds.bmax;
+
+        if (count <= kMaxLeafSize) continue;
+
+        // A skewed SAH tree could outgrow the traversal stack; once only
+        // median splits can still fit under the limit, use those
+        if (depth + MedianLevels(count) >= kMaxTreeDepth) {
+            int axis = 0;
+            XMFLOAT3 extent(centroidBounds.bmax.x - centroidBounds.bmin.x, centroidBounds.bmax.y - centroidBounds.bmin.y,
+                centroidBounds.bmax.z - centroidBounds.bmin.z);
+            if (extent.y > extent.x) axis = 1;
+            if (extent.z > Axis(extent, axis)) axis = 2;
+            uint32_t leftCount = count / 2;
+            std::nth_element(order.begin() + first, order.begin() + first + leftCount, order.begin() + first + count,
+                [&](uint32_t a, uint32_t b) { return Axis(centroids[a], axis) < Axis(centroids[b], axis); });
+
+            uint32_t leftIdx = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.push_back(Node{ {}, first, {}, leftCount });
+            m_nodes.push_back(Node{ {}, first + leftCount, {}, count - leftCount });
+            m_nodes[nodeIdx].leftOrFirst = leftIdx;
+            m_nodes[nodeIdx].count = 0;
+            stack.push_back({ leftIdx + 1, depth + 1 });
+            stack.push_back({ leftIdx, depth + 1 });
+            continue;
+        }
+
+        // Binned SAH over all three axes
+        float bestCost = bounds.Area() * count;
+        int bestAxis = -1;
+        int bestSplit = 0;
+
+        for (int axis = 0; axis < 3; axis++) {
+            float lo = Axis(centroidBounds.bmin, axis);
+            float hi = Axis(centroidBounds.bmax, axis);
+            if (hi <= lo) continue;
+
+            Bounds bins[kBinCount];
+            uint32_t binCounts[kBinCount] = {};
+            float scale = kBinCount / (hi - lo);
+            for (uint32_t i = first; i < first + count; i++) {
+                int b = std::min(kBinCount - 1, static_cast<int>((Axis(centroids[order[i]], axis) - lo) * scale));
+                bins[b].Grow(triBounds[order[i]]);
+                binCounts[b]++;
+            }
+
+            float rightArea[kBinCount - 1];
+            uint32_t rightCount[kBinCount - 1];
+            Bounds acc;
+            uint32_t accCount = 0;
+            for (int b = kBinCount - 1; b > 0; b--) {
+                acc.Grow(bins[b]);
+                accCount += binCounts[b];
+                rightArea[b - 1] = acc.Area();
+                rightCount[b - 1] = accCount;
+            }
+
+            acc = Bounds{};
+            accCount = 0;
+            for (int b = 0; b < kBinCount - 1; b++) {
+                acc.Grow(bins[b]);
+                accCount += binCounts[b];
+                if (accCount == 0 || rightCount[b] == 0) continue;
+                float cost = acc.Area() * accCount + rightArea[b] * rightCount[b];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = b;
+                }
+            }
+        }
+
+        if (bestAxis < 0) continue; // Splitting does not pay off, keep as leaf
+
+        float lo = Axis(centroidBounds.bmin, bestAxis);
+        float scale = kBinCount / (Axis(centroidBounds.bmax, bestAxis) - lo);
+        auto mid = std::partition(order.begin() + first, order.begin() + first + count, [&](uint32_t t) {
+            int b = std::min(kBinCount - 1, static_cast<int>((Axis(centroids[t], bestAxis) - lo) * scale));
+            return b <= bestSplit;
+        });
+        uint32_t leftCount = static_cast<uint32_t>(mid - (order.begin() + first));
+        if (leftCount == 0 || leftCount == count) continue;
+
+        uint32_t leftIdx = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back(Node{ {}, first, {}, leftCount });
+        m_nodes.push_back(Node{ {}, first + leftCount, {}, count - leftCount });
+        m_nodes[nodeIdx].leftOrFirst = leftIdx;
+        m_nodes[nodeIdx].count = 0;
+
+        stack.push_back({ leftIdx + 1, depth + 1 });
+        stack.push_back({ leftIdx, depth + 1 });
+    }
+
+    std::vector<Triangle> reordered(triCount);
+    for (uint32_t i = 0; i < triCount; i++) reordered[i] = m_tris[order[i]];
+    m_tris = std::move(reordered);
+    m_nodes.shrink_to_fit();
+    return true;
+}
+
+void C3MeshBVH::Refit(const C3Model::MeshPart& mesh, const float morphWeights[4]) {
+    if (mesh.vertices.size() != m_positions.size()) return;
+
+    XMVECTOR w0 = XMVectorReplicate(morphWeights[0]);
+    XMVECTOR w1 = XMVectorReplicate(morphWeights[1]);
+    XMVECTOR w2 = XMVectorReplicate(morphWeights[2]);
+    XMVECTOR w3 = XMVectorReplicate(morphWeights[3]);
+    for (size_t i = 0; i < mesh.vertices.size(); i++) {
+        const XMFLOAT3* p = mesh.vertices[i].positions;
+        XMVECTOR blended = XMVectorMultiply(XMLoadFloat3(&p[0]), w0);
+        blended = XMVectorMultiplyAdd(XMLoadFloat3(&p[1]), w1, blended);
+        blended = XMVectorMultiplyAdd(XMLoadFloat3(&p[2]), w2, blended);
+        blended = XMVectorMultiplyAdd(XMLoadFloat3(&p[3]), w3, blended);
+        XMStoreFloat3(&m_positions[i], blended);
+    }
+    RefitNodes();
+}
+
+void C3MeshBVH::Refit(const XMFLOAT3* positions, size_t count) {
+    if (!positions || count != m_positions.size()) return;
+    std::copy(positions, positions + count, m_positions.begin());
+    RefitNodes();
+}
+
+void C3MeshBVH::RefitNodes() {
+    // Children always follow their parent, so a reverse sweep sees them first
+    for (size_t n = m_nodes.size(); n-- > 0;) {
+        Node& node = m_nodes[n];
+        Bounds b;
+        if (node.count > 0) {
+            for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; i++) {
+                const Triangle& t = m_tris[i];
+                b.Grow(m_positions[t.i0]);
+                b.Grow(m_positions[t.i1]);
+                b.Grow(m_positions[t.i2]);
+            }
+        }
+        else {
+            const Node& l = m_nodes[node.leftOrFirst];
+            const Node& r = m_nodes[node.leftOrFirst + 1];
+            b.Grow(l.bmin); b.Grow(l.bmax);
+            b.Grow(r.bmin); b.Grow(r.bmax);
+        }
+        node.bmin = b.bmin;
+        node.bmax = b.bmax;
+    }
+}
+
+bool C3MeshBVH::Raycast(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxT, Hit& hit) const {
+    if (m_nodes.empty()) return false;
+
+    XMVECTOR o = XMLoadFloat3(&origin);
+    XMVECTOR d = XMLoadFloat3(&direction);
+    XMVECTOR invD = XMVectorSet(SafeInverse(direction.x), SafeInverse(direction.y), SafeInverse(direction.z), 0.0f);
+
+    float bestT = (hit.IsValid() && hit.t < maxT) ? hit.t : maxT;
+    bool found = false;
+
+    if (IntersectBox(m_nodes[0].bmin, m_nodes[0].bmax, o, invD, bestT) == FLT_MAX) return false;
+
+    uint32_t stack[kMaxStackDepth];
+    int sp = 0;
+    stack[sp++] = 0;
+
+    while (sp > 0) {
+        const Node& node = m_nodes[stack[--sp]];
+
+        if (node.count > 0) {
+            for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; i++) {
+                const Triangle& tri = m_tris[i];
+                float t, u, v;
+                if (IntersectTriangle(o, d, m_positions[tri.i0], m_positions[tri.i1], m_positions[tri.i2],
+                    bestT, t, u, v)) {
+                    bestT = t;
+                    found = true;
+                    hit.meshIndex = m_meshIndex;
+                    hit.alpha = tri.id >= m_normalTriCount;
+                    hit.triangleIndex = hit.alpha ? tri.id - m_normalTriCount : tri.id;
+                    hit.t = t;
+                    hit.u = u;
+                    hit.v = v;
+                }
+            }
+            continue;
+        }
+
+        uint32_t nearChild = node.leftOrFirst;
+        uint32_t farChild = nearChild + 1;
+        float tNear = IntersectBox(m_nodes[nearChild].bmin, m_nodes[nearChild].bmax, o, invD, bestT);
+        float tFar = IntersectBox(m_nodes[farChild].bmin, m_nodes[farChild].bmax, o, invD, bestT);
+        if (tFar < tNear) {
+            std::swap(nearChild, farChild);
+            std::swap(tNear, tFar);
+        }
+
+        // Push the far child first so the near one is popped next; the
+        // depth limit in Build() keeps this within the stack
+        if (tFar != FLT_MAX) stack[sp++] = farChild;
+        if (tNear != FLT_MAX) stack[sp++] = nearChild;
+    }
+
+    return found;
+}
+
+bool C3MeshBVH::Segment(const XMFLOAT3& from, const XMFLOAT3& to, Hit& hit) const {
+    // Unnormalised direction: t is then the fraction along the segment
+    XMFLOAT3 dir(to.x - from.x, to.y - from.y, to.z - from.z);
+    return Raycast(from, dir, 1.0f, hit);
+}
+
+bool C3ModelBVH::Build(const C3Model& model) {
+    const auto& meshes = model.GetMeshes();
+    m_meshes.clear();
+    m_meshes.resize(meshes.size());
+
+    bool any = false;
+    for (size_t i = 0; i < meshes.size(); i++) {
+        any = m_meshes[i].Build(meshes[i], static_cast<uint32_t>(i)) || any;
+    }
+    return any;
+}
+
+void C3ModelBVH::Refit(const C3Model& model, const float morphWeights[4]) {
+    const auto& meshes = model.GetMeshes();
+    for (size_t i = 0; i < meshes.size() && i < m_meshes.size(); i++) {
+        m_meshes[i].Refit(meshes[i], morphWeights);
+    }
+}
+
+bool C3ModelBVH::Raycast(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxT, C3MeshBVH::Hit& hit) const {
+    bool found = false;
+    for (const auto& bvh : m_meshes) {
+        found = bvh.Raycast(origin, direction, maxT, hit) || found;
+    }
+    return found;
+}
+
+bool C3ModelBVH::Segment(const XMFLOAT3& from, const XMFLOAT3& to, C3MeshBVH::Hit& hit) const {
+    bool found = false;
+    for (const auto& bvh : m_meshes) {
+        found = bvh.Segment(from, to, hit) || found;
+    }
+    return found;
+}
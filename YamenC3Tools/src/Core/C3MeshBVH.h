@@ -0,0 +1,74 @@
+#pragma once
+#include "C3Model.h"
+#include <vector>
+
+// Binned-SAH bounding volume hierarchy over the triangles of one MeshPart.
+// Nodes are 32 bytes and children are stored after their parent, so a
+// refit after morphing or skinning is a single reverse sweep.
+class C3MeshBVH {
+public:
+    struct Hit {
+        uint32_t meshIndex = UINT32_MAX;
+        uint32_t triangleIndex = UINT32_MAX; // Index within normalIndices or alphaIndices
+        bool alpha = false;                  // True if the triangle comes from alphaIndices
+        float t = 0.0f;                      // Distance along the ray direction
+        float u = 0.0f, v = 0.0f;            // Barycentrics of vertices 1 and 2
+
+        bool IsValid() const { return triangleIndex != UINT32_MAX; }
+    };
+
+    bool Build(const C3Model::MeshPart& mesh, uint32_t meshIndex = 0);
+
+    // Recomputes positions from blended morph targets and refits the bounds
+    void Refit(const C3Model::MeshPart& mesh, const float morphWeights[4]);
+    // Refit from externally skinned positions (one per mesh vertex)
+    void Refit(const XMFLOAT3* positions, size_t count);
+
+    // Closest hit with t in [0, maxT]. 'hit' is only updated on a closer hit.
+    bool Raycast(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxT, Hit& hit) const;
+    bool Segment(const XMFLOAT3& from, const XMFLOAT3& to, Hit& hit) const;
+
+    bool IsEmpty() const { return m_nodes.empty(); }
+    size_t GetNodeCount() const { return m_nodes.size(); }
+    size_t GetTriangleCount() const { return m_tris.size(); }
+    XMFLOAT3 GetBoundsMin() const { return m_nodes.empty() ? XMFLOAT3{} : m_nodes[0].bmin; }
+    XMFLOAT3 GetBoundsMax() const { return m_nodes.empty() ? XMFLOAT3{} : m_nodes[0].bmax; }
+
+private:
+    struct Node {
+        XMFLOAT3 bmin;
+        uint32_t leftOrFirst; // Left child for interior nodes, first triangle for leaves
+        XMFLOAT3 bmax;
+        uint32_t count;       // Triangle count, 0 for interior nodes
+    };
+    static_assert(sizeof(Node) == 32, "BVH node must be 32 bytes");
+
+    struct Triangle {
+        uint32_t i0, i1, i2;
+        uint32_t id; // Combined index: normal triangles first, then alpha
+    };
+
+    std::vector<Node> m_nodes;
+    std::vector<Triangle> m_tris;
+    std::vector<XMFLOAT3> m_positions;
+    uint32_t m_meshIndex = 0;
+    uint32_t m_normalTriCount = 0;
+
+    void RefitNodes();
+};
+
+// One BVH per mesh part plus a combined query over the whole model
+class C3ModelBVH {
+public:
+    bool Build(const C3Model& model);
+    void Refit(const C3Model& model, const float morphWeights[4]);
+
+    bool Raycast(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxT, C3MeshBVH::Hit& hit) const;
+    bool Segment(const XMFLOAT3& from, const XMFLOAT3& to, C3MeshBVH::Hit& hit) const;
+
+    const std::vector<C3MeshBVH>& GetMeshBVHs() const { return m_meshes; }
+    std::vector<C3MeshBVH>& GetMeshBVHs() { return m_meshes; }
+
+private:
+    std::vector<C3MeshBVH> m_meshes;
+};
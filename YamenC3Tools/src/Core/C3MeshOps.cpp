@@ -0,0 +1,251 @@
+#include "C3MeshOps.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace DirectX;
+
+namespace {
+
+bool IsZeroMatrix(const XMFLOAT4X4& m) {
+    static const XMFLOAT4X4 zero{};
+    return memcmp(&m, &zero, sizeof(XMFLOAT4X4)) == 0;
+}
+
+bool SameMaterial(const C3Model::MeshPart& a, const C3Model::MeshPart& b) {
+    auto sameKeys = [](const std::vector<C3KeyFrame>& x, const std::vector<C3KeyFrame>& y) {
+        return x.size() == y.size() &&
+            (x.empty() || memcmp(x.data(), y.data(), x.size() * sizeof(C3KeyFrame)) == 0);
+    };
+    return a.textureName == b.textureName &&
+        a.textureRow == b.textureRow &&
+        a.blendCount == b.blendCount &&
+        memcmp(&a.initialMatrix, &b.initialMatrix, sizeof(XMFLOAT4X4)) == 0 &&
+        sameKeys(a.alphaKeyframes, b.alphaKeyframes) &&
+        sameKeys(a.drawKeyframes, b.drawKeyframes);
+}
+
+// Keeps referenced vertices in their original order, so every vertex moves
+// to an equal or lower slot and the compaction can run in place.
+void CompactVertices(C3Model::MeshPart& mesh, std::vector<uint32_t>& remap) {
+    remap.assign(mesh.vertices.size(), UINT32_MAX);
+    for (uint16_t idx : mesh.normalIndices) if (idx < remap.size()) remap[idx] = 0;
+    for (uint16_t idx : mesh.alphaIndices) if (idx < remap.size()) remap[idx] = 0;
+
+    std::vector<PhyVertex>& vertices = mesh.vertices.Edit();
+    uint32_t next = 0;
+    for (size_t v = 0; v < vertices.size(); v++) {
+        if (remap[v] == UINT32_MAX) continue;
+        remap[v] = next;
+        if (next != v) vertices[next] = vertices[v];
+        next++;
+    }
+    vertices.resize(next);
+
+    for (uint16_t& idx : mesh.normalIndices) idx = (idx < remap.size()) ? static_cast<uint16_t>(remap[idx]) : 0;
+    for (uint16_t& idx : mesh.alphaIndices) idx = (idx < remap.size()) ? static_cast<uint16_t>(remap[idx]) : 0;
+}
+
+void ReverseWinding(C3SharedBuffer<uint16_t>& indices) {
+    if (indices.empty()) return;
+    std::vector<uint16_t>& tris = indices.Edit();
+    for (size_t t = 0; t + 2 < tris.size(); t += 3) std::swap(tris[t + 1], tris[t + 2]);
+}
+
+void AppendOffset(C3SharedBuffer<uint16_t>& dst, const C3SharedBuffer<uint16_t>& src, size_t base) {
+    if (src.empty()) return;
+    std::vector<uint16_t>& out = dst.Edit();
+    out.reserve(out.size() + src.size());
+    for (uint16_t idx : src) out.push_back(static_cast<uint16_t>(idx + base));
+}
+
+} // namespace
+
+void C3MeshOps::TransformPositions(XMFLOAT3* first, size_t stride, size_t count, FXMMATRIX matrix) {
+    if (!first || count == 0) return;
+    XMVector3TransformCoordStream(first, stride, first, stride, count, matrix);
+}
+
+void C3MeshOps::Transform(C3Model::MeshPart& mesh, FXMMATRIX matrix) {
+    if (mesh.vertices.empty()) return;
+
+    PhyVertex* vertices = mesh.vertices.data();
+    for (int k = 0; k < 4; k++) {
+        TransformPositions(&vertices[0].positions[k], sizeof(PhyVertex), mesh.vertices.size(), matrix);
+    }
+    // A mirroring matrix turns every triangle inside out unless the winding flips with it
+    if (XMVectorGetX(XMMatrixDeterminant(matrix)) < 0.0f) {
+        ReverseWinding(mesh.normalIndices);
+        ReverseWinding(mesh.alphaIndices);
+    }
+    C3Model::ComputeMeshBounds(mesh, mesh.bboxMin, mesh.bboxMax);
+
+    for (auto& lod : mesh.lods) {
+        Transform(lod, matrix);
+    }
+}
+
+void C3MeshOps::Transform(C3Model& model, FXMMATRIX matrix) {
+    for (auto& mesh : model.GetMeshes()) {
+        Transform(mesh, matrix);
+    }
+    model.RecalculateBounds();
+}
+
+void C3MeshOps::BakeInitialMatrix(C3Model::MeshPart& mesh) {
+    if (!IsZeroMatrix(mesh.initialMatrix)) {
+        XMMATRIX m = XMLoadFloat4x4(&mesh.initialMatrix);
+        if (!XMMatrixIsIdentity(m)) {
+            Transform(mesh, m);
+        }
+    }
+    XMStoreFloat4x4(&mesh.initialMatrix, XMMatrixIdentity());
+}
+
+void C3MeshOps::BakeInitialMatrices(C3Model& model) {
+    for (auto& mesh : model.GetMeshes()) {
+        BakeInitialMatrix(mesh);
+    }
+    model.RecalculateBounds();
+}
+
+XMMATRIX C3MeshOps::NormalizationMatrix(const C3Model& model, float targetRadius) {
+    XMFLOAT3 center = model.GetCenter();
+    float radius = model.GetRadius();
+    float scale = (radius > 0) ? (targetRadius / radius) : 1.0f;
+    return XMMatrixMultiply(XMMatrixTranslation(-center.x, -center.y, -center.z),
+        XMMatrixScaling(scale, scale, scale));
+}
+
+void C3MeshOps::Recenter(C3Model& model, bool normalizeScale, float targetRadius) {
+    XMMATRIX m;
+    if (normalizeScale) {
+        m = NormalizationMatrix(model, targetRadius);
+    }
+    else {
+        XMFLOAT3 center = model.GetCenter();
+        m = XMMatrixTranslation(-center.x, -center.y, -center.z);
+    }
+    Transform(model, m);
+}
+
+bool C3MeshOps::Merge(C3Model::MeshPart& dst, const C3Model::MeshPart& src, std::string* error) {
+    size_t base = dst.vertices.size();
+    if (base + src.vertices.size() > 65535) {
+        if (error) *error = "Merged mesh would exceed 65535 vertices";
+        return false;
+    }
+
+    // Appended in place; a caller merging several parts reserves once (see MergeByMaterial)
+    if (!src.vertices.empty()) {
+        std::vector<PhyVertex>& vertices = dst.vertices.Edit();
+        vertices.insert(vertices.end(), src.vertices.begin(), src.vertices.end());
+    }
+    AppendOffset(dst.normalIndices, src.normalIndices, base);
+    AppendOffset(dst.alphaIndices, src.alphaIndices, base);
+
+    if (!src.vertices.empty()) {
+        if (base == 0) {
+            dst.bboxMin = src.bboxMin;
+            dst.bboxMax = src.bboxMax;
+        }
+        else {
+            dst.bboxMin = XMFLOAT3(std::min(dst.bboxMin.x, src.bboxMin.x), std::min(dst.bboxMin.y, src.bboxMin.y),
+                std::min(dst.bboxMin.z, src.bboxMin.z));
+            dst.bboxMax = XMFLOAT3(std::max(dst.bboxMax.x, src.bboxMax.x), std::max(dst.bboxMax.y, src.bboxMax.y),
+                std::max(dst.bboxMax.z, src.bboxMax.z));
+        }
+    }
+
+    dst.lods.clear(); // No longer match the merged geometry
+    return true;
+}
+
+size_t C3MeshOps::MergeByMaterial(std::vector<C3Model::MeshPart>& meshes) {
+    std::vector<uint8_t> consumed(meshes.size(), 0);
+    std::vector<size_t> group;
+    size_t mergedCount = 0;
+
+    for (size_t i = 0; i < meshes.size(); i++) {
+        if (consumed[i]) continue;
+
+        // Opaque triangles are depth-tested and may move to an earlier part.
+        // Alpha triangles are blended in part order, so a part with any only
+        // joins while no other alpha part is left between it and meshes[i].
+        group.clear();
+        size_t vertexTotal = meshes[i].vertices.size();
+        size_t normalTotal = meshes[i].normalIndices.size();
+        size_t alphaTotal = meshes[i].alphaIndices.size();
+        bool alphaBetween = false;
+        for (size_t j = i + 1; j < meshes.size(); j++) {
+            if (consumed[j]) continue;
+            const bool hasAlpha = !meshes[j].alphaIndices.empty();
+            if (SameMaterial(meshes[i], meshes[j]) && !(hasAlpha && alphaBetween) &&
+                vertexTotal + meshes[j].vertices.size() <= 65535) {
+                group.push_back(j);
+                vertexTotal += meshes[j].vertices.size();
+                normalTotal += meshes[j].normalIndices.size();
+                alphaTotal += meshes[j].alphaIndices.size();
+            }
+            else if (hasAlpha) {
+                alphaBetween = true;
+            }
+        }
+        if (group.empty()) continue;
+
+        // Sized once for the whole group, then every part is appended in order
+        meshes[i].vertices.reserve(vertexTotal);
+        meshes[i].normalIndices.reserve(normalTotal);
+        meshes[i].alphaIndices.reserve(alphaTotal);
+        for (size_t j : group) {
+            Merge(meshes[i], meshes[j]);
+            consumed[j] = 1;
+            mergedCount++;
+        }
+    }
+
+    size_t write = 0;
+    for (size_t i = 0; i < meshes.size(); i++) {
+        if (consumed[i]) continue;
+        if (write != i) meshes[write] = std::move(meshes[i]);
+        write++;
+    }
+    meshes.resize(write);
+    return mergedCount;
+}
+
+bool C3MeshOps::SplitByMaterial(C3Model::MeshPart& mesh, C3Model::MeshPart& outAlpha) {
+    if (mesh.alphaIndices.empty()) return false;
+
+    outAlpha = C3Model::MeshPart{};
+    outAlpha.name = mesh.name + "_alpha";
+    outAlpha.textureName = mesh.textureName;
+    outAlpha.initialMatrix = mesh.initialMatrix;
+    outAlpha.textureRow = mesh.textureRow;
+    outAlpha.blendCount = mesh.blendCount;
+    outAlpha.alphaKeyframes = mesh.alphaKeyframes;
+    outAlpha.drawKeyframes = mesh.drawKeyframes;
+
+    // Only the vertices the alpha triangles use are copied, in their original order
+    const std::vector<PhyVertex>& source = mesh.vertices.Get();
+    std::vector<uint32_t> remap(source.size(), UINT32_MAX);
+    for (uint16_t idx : mesh.alphaIndices) if (idx < remap.size()) remap[idx] = 0;
+    std::vector<PhyVertex> alphaVertices;
+    alphaVertices.reserve(static_cast<size_t>(std::count(remap.begin(), remap.end(), 0u)));
+    for (size_t v = 0; v < source.size(); v++) {
+        if (remap[v] == UINT32_MAX) continue;
+        remap[v] = static_cast<uint32_t>(alphaVertices.size());
+        alphaVertices.push_back(source[v]);
+    }
+    outAlpha.vertices = std::move(alphaVertices);
+    outAlpha.alphaIndices = std::move(mesh.alphaIndices);
+    mesh.alphaIndices.clear();
+    for (uint16_t& idx : outAlpha.alphaIndices) idx = (idx < remap.size()) ? static_cast<uint16_t>(remap[idx]) : 0;
+
+    // The opaque part drops the rest in place
+    CompactVertices(mesh, remap);
+
+    C3Model::ComputeMeshBounds(mesh, mesh.bboxMin, mesh.bboxMax);
+    C3Model::ComputeMeshBounds(outAlpha, outAlpha.bboxMin, outAlpha.bboxMax);
+    mesh.lods.clear();
+    return true;
+}
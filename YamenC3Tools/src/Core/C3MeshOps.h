@@ -0,0 +1,39 @@
+#pragma once
+#include "C3Model.h"
+#include <string>
+#include <vector>
+
+// Batched in-place mesh editing. Position transforms go through
+// XMVector3TransformCoordStream over the interleaved PhyVertex layout, one
+// stream per morph target, so no temporary vertex copies are made.
+class C3MeshOps {
+public:
+    // Transforms 'count' positions spaced 'stride' bytes apart, in place
+    static void TransformPositions(XMFLOAT3* first, size_t stride, size_t count, FXMMATRIX matrix);
+
+    // Applies the matrix to all four morph positions and refits the mesh bbox.
+    // A mirroring matrix (negative determinant) also reverses the winding.
+    static void Transform(C3Model::MeshPart& mesh, FXMMATRIX matrix);
+    static void Transform(C3Model& model, FXMMATRIX matrix);
+
+    // Applies initialMatrix to the vertices and resets it to identity.
+    // An all-zero matrix (absent in the file) is treated as identity.
+    static void BakeInitialMatrix(C3Model::MeshPart& mesh);
+    static void BakeInitialMatrices(C3Model& model);
+
+    // Matrix that moves the model center to the origin and scales it to targetRadius
+    static XMMATRIX NormalizationMatrix(const C3Model& model, float targetRadius);
+    static void Recenter(C3Model& model, bool normalizeScale = false, float targetRadius = 1.0f);
+
+    // Appends src to dst (dst keeps its texture and keyframes); fails past 65,535 vertices
+    static bool Merge(C3Model::MeshPart& dst, const C3Model::MeshPart& src, std::string* error = nullptr);
+    // Merges parts sharing texture, texture row, blend count, matrix and keyframes,
+    // each into the first part of its kind, in part order. A part with alpha
+    // triangles is only merged while no other alpha part draws between the two.
+    // Returns the number of parts folded into others.
+    static size_t MergeByMaterial(std::vector<C3Model::MeshPart>& meshes);
+
+    // Moves the alpha triangles into 'outAlpha', with copies of only the
+    // vertices they use; 'mesh' keeps the opaque ones and is compacted in place.
+    static bool SplitByMaterial(C3Model::MeshPart& mesh, C3Model::MeshPart& outAlpha);
+};
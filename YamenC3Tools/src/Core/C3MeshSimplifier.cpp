@@ -0,0 +1,469 @@
+#include "C3MeshSimplifier.h"
+#include <algorithm>
+#include <unordered_map>
+#include <cstring>
+#include <cmath>
+#include <cfloat>
+
+namespace {
+
+enum VertexKind : uint8_t {
+    KindManifold,
+    KindBorder,
+    KindLocked
+};
+
+// Symmetric 4x4 plane quadric plus the accumulated area weight
+struct Quadric {
+    double a2 = 0, ab = 0, ac = 0, ad = 0;
+    double b2 = 0, bc = 0, bd = 0;
+    double c2 = 0, cd = 0;
+    double d2 = 0;
+    double w = 0;
+
+    void AddPlane(double a, double b, double c, double d, double weight) {
+        a2 += weight * a * a; ab += weight * a * b; ac += weight * a * c; ad += weight * a * d;
+        b2 += weight * b * b; bc += weight * b * c; bd += weight * b * d;
+        c2 += weight * c * c; cd += weight * c * d;
+        d2 += weight * d * d;
+        w += weight;
+    }
+
+    void Add(const Quadric& o) {
+        a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+        b2 += o.b2; bc += o.bc; bd += o.bd;
+        c2 += o.c2; cd += o.cd;
+        d2 += o.d2;
+        w += o.w;
+    }
+
+    double Eval(const XMFLOAT3& p) const {
+        double x = p.x, y = p.y, z = p.z;
+        return a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+            + b2 * y * y + 2 * bc * y * z + 2 * bd * y
+            + c2 * z * z + 2 * cd * z
+            + d2;
+    }
+};
+
+struct Collapse {
+    uint32_t from;
+    uint32_t to;
+    float error;
+};
+
+struct PositionKey {
+    uint32_t x, y, z;
+    bool operator==(const PositionKey& o) const { return x == o.x && y == o.y && z == o.z; }
+};
+
+struct PositionKeyHash {
+    size_t operator()(const PositionKey& k) const {
+        return (size_t(k.x) * 73856093u) ^ (size_t(k.y) * 19349663u) ^ (size_t(k.z) * 83492791u);
+    }
+};
+
+inline uint64_t EdgeKey(uint32_t a, uint32_t b) {
+    return (a < b) ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+}
+
+inline XMFLOAT3 Sub(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return XMFLOAT3(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+inline XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return XMFLOAT3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+inline float Dot(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+inline uint32_t DominantBone(const PhyVertex& v) {
+    return (v.boneWeights[1] > v.boneWeights[0]) ? v.boneIndices[1] : v.boneIndices[0];
+}
+
+} // namespace
+
+bool C3MeshSimplifier::Simplify(const C3Model::MeshPart& source, C3Model::MeshPart& out, const Options& options) {
+    m_lastResult = Result{};
+
+    const size_t vertexCount = source.vertices.size();
+    const size_t normalTris = source.normalIndices.size() / 3;
+    const size_t alphaTris = source.alphaIndices.size() / 3;
+    const size_t triCount = normalTris + alphaTris;
+
+    if (vertexCount == 0 || triCount == 0) {
+        m_lastError = "Mesh has no triangles";
+        return false;
+    }
+
+    // Both partitions share one index list; the flag keeps each triangle in its partition
+    std::vector<uint32_t> indices(triCount * 3);
+    std::vector<uint8_t> isAlpha(triCount, 0);
+    for (size_t i = 0; i < normalTris * 3; i++) {
+        indices[i] = source.normalIndices[i];
+    }
+    for (size_t i = 0; i < alphaTris * 3; i++) {
+        indices[normalTris * 3 + i] = source.alphaIndices[i];
+        isAlpha[normalTris + i / 3] = 1;
+    }
+    for (uint32_t idx : indices) {
+        if (idx >= vertexCount) {
+            m_lastError = "Index out of range: " + std::to_string(idx);
+            return false;
+        }
+    }
+
+    // Weld by base position so UV seams show up as groups of coincident vertices
+    std::vector<uint32_t> weld(vertexCount);
+    std::vector<uint32_t> groupSize(vertexCount, 0);
+    {
+        std::unordered_map<PositionKey, uint32_t, PositionKeyHash> groups;
+        groups.reserve(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            PositionKey key;
+            memcpy(&key, &source.vertices[v].positions[0], sizeof(key));
+            auto it = groups.emplace(key, v).first;
+            weld[v] = it->second;
+            groupSize[it->second]++;
+        }
+    }
+
+    std::vector<uint8_t> seam(vertexCount, 0);
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        seam[v] = groupSize[weld[v]] > 1 ? 1 : 0;
+    }
+
+    XMFLOAT3 bmin{ FLT_MAX, FLT_MAX, FLT_MAX };
+    XMFLOAT3 bmax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (const auto& v : source.vertices) {
+        const XMFLOAT3& p = v.positions[0];
+        bmin.x = std::min(bmin.x, p.x); bmin.y = std::min(bmin.y, p.y); bmin.z = std::min(bmin.z, p.z);
+        bmax.x = std::max(bmax.x, p.x); bmax.y = std::max(bmax.y, p.y); bmax.z = std::max(bmax.z, p.z);
+    }
+    XMFLOAT3 extentVec = Sub(bmax, bmin);
+    float extent = sqrtf(Dot(extentVec, extentVec));
+    if (extent <= 0.0f) extent = 1.0f;
+
+    const int morphCount = options.morphAware ? 4 : 1;
+    std::vector<Quadric> quadrics(vertexCount * morphCount);
+
+    // Plane quadrics per morph target, area weighted
+    for (size_t t = 0; t < triCount; t++) {
+        for (int k = 0; k < morphCount; k++) {
+            const XMFLOAT3& p0 = source.vertices[indices[t * 3 + 0]].positions[k];
+            const XMFLOAT3& p1 = source.vertices[indices[t * 3 + 1]].positions[k];
+            const XMFLOAT3& p2 = source.vertices[indices[t * 3 + 2]].positions[k];
+            XMFLOAT3 n = Cross(Sub(p1, p0), Sub(p2, p0));
+            float len = sqrtf(Dot(n, n));
+            if (len <= 0.0f) continue;
+            double a = n.x / len, b = n.y / len, c = n.z / len;
+            double d = -(a * p0.x + b * p0.y + c * p0.z);
+            double area = len * 0.5;
+            for (int c3 = 0; c3 < 3; c3++) {
+                quadrics[indices[t * 3 + c3] * morphCount + k].AddPlane(a, b, c, d, area);
+            }
+        }
+    }
+
+    // Edge use counts in welded space, sorted for binary search
+    std::vector<std::pair<uint64_t, uint32_t>> edgeCounts;
+    std::vector<uint8_t> dead(triCount, 0);
+
+    auto rebuildEdges = [&]() {
+        std::vector<uint64_t> keys;
+        keys.reserve(triCount * 3);
+        for (size_t t = 0; t < triCount; t++) {
+            if (dead[t]) continue;
+            for (int e = 0; e < 3; e++) {
+                uint32_t a = weld[indices[t * 3 + e]];
+                uint32_t b = weld[indices[t * 3 + (e + 1) % 3]];
+                keys.push_back(EdgeKey(a, b));
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+        edgeCounts.clear();
+        for (size_t i = 0; i < keys.size();) {
+            size_t j = i;
+            while (j < keys.size() && keys[j] == keys[i]) j++;
+            edgeCounts.emplace_back(keys[i], static_cast<uint32_t>(j - i));
+            i = j;
+        }
+    };
+
+    auto edgeCount = [&](uint32_t a, uint32_t b) -> uint32_t {
+        uint64_t key = EdgeKey(weld[a], weld[b]);
+        auto it = std::lower_bound(edgeCounts.begin(), edgeCounts.end(), key,
+            [](const std::pair<uint64_t, uint32_t>& e, uint64_t k) { return e.first < k; });
+        return (it != edgeCounts.end() && it->first == key) ? it->second : 0;
+    };
+
+    // Border constraint planes keep open edges from sliding inward
+    rebuildEdges();
+    for (size_t t = 0; t < triCount; t++) {
+        for (int e = 0; e < 3; e++) {
+            uint32_t a = indices[t * 3 + e];
+            uint32_t b = indices[t * 3 + (e + 1) % 3];
+            if (edgeCount(a, b) != 1) continue;
+            for (int k = 0; k < morphCount; k++) {
+                const XMFLOAT3& p0 = source.vertices[indices[t * 3 + 0]].positions[k];
+                const XMFLOAT3& p1 = source.vertices[indices[t * 3 + 1]].positions[k];
+                const XMFLOAT3& p2 = source.vertices[indices[t * 3 + 2]].positions[k];
+                XMFLOAT3 faceNormal = Cross(Sub(p1, p0), Sub(p2, p0));
+                XMFLOAT3 edge = Sub(source.vertices[b].positions[k], source.vertices[a].positions[k]);
+                XMFLOAT3 n = Cross(edge, faceNormal);
+                float len = sqrtf(Dot(n, n));
+                if (len <= 0.0f) continue;
+                const XMFLOAT3& pa = source.vertices[a].positions[k];
+                double na = n.x / len, nb = n.y / len, nc = n.z / len;
+                double d = -(na * pa.x + nb * pa.y + nc * pa.z);
+                double weight = Dot(edge, edge) * 10.0;
+                quadrics[a * morphCount + k].AddPlane(na, nb, nc, d, weight);
+                quadrics[b * morphCount + k].AddPlane(na, nb, nc, d, weight);
+            }
+        }
+    }
+
+    size_t targetTris = static_cast<size_t>(std::max(1.0f, std::round(options.targetRatio * triCount)));
+    size_t liveTris = triCount;
+    float worstError = 0.0f;
+
+    std::vector<uint8_t> kind(vertexCount);
+    std::vector<uint32_t> adjOffsets(vertexCount + 1);
+    std::vector<uint32_t> adjTris;
+    std::vector<uint8_t> touched(vertexCount);
+    std::vector<Collapse> candidates;
+
+    auto collapseError = [&](uint32_t from, uint32_t to) -> float {
+        double err = 0, weight = 0;
+        for (int k = 0; k < morphCount; k++) {
+            Quadric q = quadrics[from * morphCount + k];
+            q.Add(quadrics[to * morphCount + k]);
+            err += q.Eval(source.vertices[to].positions[k]);
+            weight += q.w;
+        }
+        if (weight <= 0) return 0.0f;
+        return static_cast<float>(sqrt(std::max(0.0, err) / weight)) / extent;
+    };
+
+    auto canCollapse = [&](uint32_t from, uint32_t to) -> bool {
+        if (kind[from] == KindLocked || kind[to] == KindLocked) return false;
+        if (kind[from] == KindBorder && (kind[to] != KindBorder || edgeCount(from, to) != 1)) return false;
+        if (options.respectBoneBoundaries &&
+            DominantBone(source.vertices[from]) != DominantBone(source.vertices[to])) return false;
+        return true;
+    };
+
+    // Reject collapses that would flip or fully degenerate a surviving triangle
+    auto preservesOrientation = [&](uint32_t from, uint32_t to) -> bool {
+        for (uint32_t i = adjOffsets[from]; i < adjOffsets[from + 1]; i++) {
+            uint32_t t = adjTris[i];
+            if (dead[t]) continue;
+            const uint32_t* tri = &indices[t * 3];
+            if (tri[0] == to || tri[1] == to || tri[2] == to) continue;
+
+            const XMFLOAT3& p0 = source.vertices[tri[0]].positions[0];
+            const XMFLOAT3& p1 = source.vertices[tri[1]].positions[0];
+            const XMFLOAT3& p2 = source.vertices[tri[2]].positions[0];
+            XMFLOAT3 before = Cross(Sub(p1, p0), Sub(p2, p0));
+
+            const XMFLOAT3& q0 = source.vertices[tri[0] == from ? to : tri[0]].positions[0];
+            const XMFLOAT3& q1 = source.vertices[tri[1] == from ? to : tri[1]].positions[0];
+            const XMFLOAT3& q2 = source.vertices[tri[2] == from ? to : tri[2]].positions[0];
+            XMFLOAT3 after = Cross(Sub(q1, q0), Sub(q2, q0));
+
+            if (Dot(before, after) <= 0.0f) return false;
+        }
+        return true;
+    };
+
+    while (liveTris > targetTris) {
+        if (liveTris != triCount) {
+            rebuildEdges();
+        }
+
+        // Classify vertices against the current topology
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            kind[v] = seam[v] ? KindLocked : KindManifold;
+        }
+        for (size_t t = 0; t < triCount; t++) {
+            if (dead[t]) continue;
+            for (int e = 0; e < 3; e++) {
+                uint32_t a = indices[t * 3 + e];
+                uint32_t b = indices[t * 3 + (e + 1) % 3];
+                uint32_t count = edgeCount(a, b);
+                uint8_t edgeKind = (count == 1) ? (options.lockBorders ? KindLocked : KindBorder)
+                    : (count > 2) ? KindLocked : KindManifold;
+                kind[a] = std::max(kind[a], edgeKind);
+                kind[b] = std::max(kind[b], edgeKind);
+            }
+        }
+
+        // Vertex -> triangle adjacency (CSR)
+        std::fill(adjOffsets.begin(), adjOffsets.end(), 0);
+        for (size_t t = 0; t < triCount; t++) {
+            if (dead[t]) continue;
+            for (int c = 0; c < 3; c++) adjOffsets[indices[t * 3 + c] + 1]++;
+        }
+        for (size_t v = 0; v < vertexCount; v++) adjOffsets[v + 1] += adjOffsets[v];
+        adjTris.assign(adjOffsets[vertexCount], 0);
+        {
+            std::vector<uint32_t> fill(adjOffsets.begin(), adjOffsets.end() - 1);
+            for (size_t t = 0; t < triCount; t++) {
+                if (dead[t]) continue;
+                for (int c = 0; c < 3; c++) adjTris[fill[indices[t * 3 + c]]++] = static_cast<uint32_t>(t);
+            }
+        }
+
+        // Cheapest direction per edge
+        candidates.clear();
+        for (const auto& e : edgeCounts) {
+            uint32_t a = static_cast<uint32_t>(e.first >> 32);
+            uint32_t b = static_cast<uint32_t>(e.first & 0xFFFFFFFFu);
+            if (a == b) continue;
+
+            bool ab = canCollapse(a, b);
+            bool ba = canCollapse(b, a);
+            if (!ab && !ba) continue;
+
+            float errAB = ab ? collapseError(a, b) : FLT_MAX;
+            float errBA = ba ? collapseError(b, a) : FLT_MAX;
+            if (errAB <= errBA) candidates.push_back({ a, b, errAB });
+            else candidates.push_back({ b, a, errBA });
+        }
+
+        std::sort(candidates.begin(), candidates.end(),
+            [](const Collapse& x, const Collapse& y) { return x.error < y.error; });
+
+        std::fill(touched.begin(), touched.end(), 0);
+        size_t needed = liveTris - targetTris;
+        size_t removed = 0;
+        size_t collapsed = 0;
+
+        for (const Collapse& c : candidates) {
+            if (c.error > options.maxError || removed >= needed) break;
+            if (touched[c.from] || touched[c.to]) continue;
+            if (!preservesOrientation(c.from, c.to)) continue;
+
+            for (uint32_t i = adjOffsets[c.from]; i < adjOffsets[c.from + 1]; i++) {
+                uint32_t t = adjTris[i];
+                if (dead[t]) continue;
+                uint32_t* tri = &indices[t * 3];
+                for (int k = 0; k < 3; k++) touched[tri[k]] = 1;
+
+                if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+                    dead[t] = 1;
+                    removed++;
+                }
+                else {
+                    for (int k = 0; k < 3; k++) {
+                        if (tri[k] == c.from) tri[k] = c.to;
+                    }
+                }
+            }
+
+            for (int k = 0; k < morphCount; k++) {
+                quadrics[c.to * morphCount + k].Add(quadrics[c.from * morphCount + k]);
+            }
+            worstError = std::max(worstError, c.error);
+            collapsed++;
+        }
+
+        if (collapsed == 0) break;
+        liveTris -= removed;
+    }
+
+    // Compact vertices in first-use order and rebuild both partitions
+    std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+    C3Model::MeshPart result;
+    result.name = source.name;
+    result.textureName = source.textureName;
+    result.bboxMin = source.bboxMin;
+    result.bboxMax = source.bboxMax;
+    result.initialMatrix = source.initialMatrix;
+    result.textureRow = source.textureRow;
+    result.blendCount = source.blendCount;
+    result.alphaKeyframes = source.alphaKeyframes;
+    result.drawKeyframes = source.drawKeyframes;
+
+    for (int pass = 0; pass < 2; pass++) {
+        std::vector<uint16_t>& dst = (pass == 0) ? result.normalIndices.Edit() : result.alphaIndices.Edit();
+        for (size_t t = 0; t < triCount; t++) {
+            if (dead[t] || isAlpha[t] != pass) continue;
+            for (int k = 0; k < 3; k++) {
+                uint32_t v = indices[t * 3 + k];
+                if (remap[v] == UINT32_MAX) {
+                    remap[v] = static_cast<uint32_t>(result.vertices.size());
+                    result.vertices.push_back(source.vertices[v]);
+                }
+                dst.push_back(static_cast<uint16_t>(remap[v]));
+            }
+        }
+    }
+
+    m_lastResult.sourceTriangles = static_cast<uint32_t>(triCount);
+    m_lastResult.resultTriangles = static_cast<uint32_t>(liveTris);
+    m_lastResult.resultVertices = static_cast<uint32_t>(result.vertices.size());
+    m_lastResult.error = worstError;
+
+    out = std::move(result);
+    return true;
+}
+
+bool C3MeshSimplifier::BuildLODChain(const C3Model::MeshPart& source, std::vector<C3Model::MeshPart>& outLevels,
+    const LODOptions& options) {
+    outLevels.clear();
+
+    const size_t sourceTris = (source.normalIndices.size() + source.alphaIndices.size()) / 3;
+    if (sourceTris == 0) {
+        m_lastError = "Mesh has no triangles";
+        return false;
+    }
+
+    Options levelOptions;
+    levelOptions.maxError = options.maxError;
+    levelOptions.lockBorders = options.lockBorders;
+    levelOptions.respectBoneBoundaries = options.respectBoneBoundaries;
+    levelOptions.morphAware = options.morphAware;
+
+    // Each level starts from the previous one, which is both cheaper and keeps levels nested
+    const C3Model::MeshPart* previous = &source;
+    size_t previousTris = sourceTris;
+
+    for (size_t level = 0; level < options.ratios.size(); level++) {
+        size_t target = static_cast<size_t>(options.ratios[level] * sourceTris);
+        if (target == 0 || target >= previousTris) continue;
+        levelOptions.targetRatio = static_cast<float>(target) / static_cast<float>(previousTris);
+
+        C3Model::MeshPart lod;
+        if (!Simplify(*previous, lod, levelOptions)) {
+            return false;
+        }
+
+        size_t lodTris = m_lastResult.resultTriangles;
+        if (lodTris > previousTris * options.minReduction) {
+            break; // Error bound reached; further levels would be duplicates
+        }
+
+        lod.name = source.name + "_lod" + std::to_string(outLevels.size() + 1);
+        outLevels.push_back(std::move(lod));
+        previous = &outLevels.back();
+        previousTris = lodTris;
+    }
+
+    return true;
+}
+
+bool C3MeshSimplifier::GenerateLODs(C3Model& model, const LODOptions& options) {
+    bool any = false;
+    for (auto& mesh : model.GetMeshes()) {
+        std::vector<C3Model::MeshPart> levels;
+        if (!BuildLODChain(mesh, levels, options)) {
+            continue;
+        }
+        any = any || !levels.empty();
+        mesh.lods = std::move(levels);
+    }
+    return any;
+}
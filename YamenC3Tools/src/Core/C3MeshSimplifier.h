@@ -0,0 +1,49 @@
+#pragma once
+#include "C3Model.h"
+#include <vector>
+
+// Quadric-error edge-collapse simplifier for PHY mesh parts.
+// Collapses always keep one of the original vertices, so UVs, colors,
+// bone influences and all four morph positions stay untouched.
+class C3MeshSimplifier {
+public:
+    struct Options {
+        float targetRatio = 0.5f;         // Fraction of triangles to keep
+        float maxError = 0.01f;           // Max error relative to the mesh extent
+        bool lockBorders = false;         // Keep open-edge vertices in place
+        bool respectBoneBoundaries = true; // Never merge vertices driven by different bones
+        bool morphAware = true;           // Include morph targets 1..3 in the error metric
+    };
+
+    struct LODOptions {
+        std::vector<float> ratios{ 0.5f, 0.25f, 0.125f }; // Per level, relative to the source
+        float maxError = 0.05f;
+        bool lockBorders = false;
+        bool respectBoneBoundaries = true;
+        bool morphAware = true;
+        float minReduction = 0.95f;       // Stop once a level keeps more than this of the previous one
+    };
+
+    struct Result {
+        uint32_t sourceTriangles = 0;
+        uint32_t resultTriangles = 0;
+        uint32_t resultVertices = 0;
+        float error = 0.0f;               // Relative error of the worst collapse applied
+    };
+
+    bool Simplify(const C3Model::MeshPart& source, C3Model::MeshPart& out, const Options& options);
+
+    // Builds a chain of progressively coarser levels, each named "<name>_lod<N>".
+    bool BuildLODChain(const C3Model::MeshPart& source, std::vector<C3Model::MeshPart>& outLevels,
+        const LODOptions& options);
+
+    // Fills MeshPart::lods for every mesh of the model
+    bool GenerateLODs(C3Model& model, const LODOptions& options);
+
+    const Result& GetLastResult() const { return m_lastResult; }
+    const std::string& GetLastError() const { return m_lastError; }
+
+private:
+    Result m_lastResult;
+    std::string m_lastError;
+};
@@ -0,0 +1,212 @@
+#include "C3MeshSplitter.h"
+#include <algorithm>
+#include <deque>
+#include <cfloat>
+
+namespace {
+
+inline uint32_t Part1By2(uint32_t x) {
+    x &= 0x000003FF;
+    x = (x ^ (x << 16)) & 0xFF0000FF;
+    x = (x ^ (x << 8)) & 0x0300F00F;
+    x = (x ^ (x << 4)) & 0x030C30C3;
+    x = (x ^ (x << 2)) & 0x09249249;
+    return x;
+}
+
+inline uint32_t Morton3(float x, float y, float z) {
+    auto quantize = [](float f) {
+        return static_cast<uint32_t>(std::clamp(f, 0.0f, 1.0f) * 1023.0f);
+    };
+    return Part1By2(quantize(x)) | (Part1By2(quantize(y)) << 1) | (Part1By2(quantize(z)) << 2);
+}
+
+void FinishPart(C3Model::MeshPart& part) {
+    XMFLOAT3 bmin{ FLT_MAX, FLT_MAX, FLT_MAX };
+    XMFLOAT3 bmax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (const auto& v : part.vertices) {
+        const XMFLOAT3& p = v.positions[0];
+        bmin.x = std::min(bmin.x, p.x); bmin.y = std::min(bmin.y, p.y); bmin.z = std::min(bmin.z, p.z);
+        bmax.x = std::max(bmax.x, p.x); bmax.y = std::max(bmax.y, p.y); bmax.z = std::max(bmax.z, p.z);
+    }
+    if (!part.vertices.empty()) {
+        part.bboxMin = bmin;
+        part.bboxMax = bmax;
+    }
+}
+
+} // namespace
+
+bool C3MeshSplitter::Split(const SourceMesh& source, const C3Model::MeshPart& templ,
+    std::vector<C3Model::MeshPart>& outParts, const Options& options, std::string* error) {
+    outParts.clear();
+
+    const uint32_t vertexCount = static_cast<uint32_t>(source.vertices.size());
+    const size_t normalTris = source.normalIndices.size() / 3;
+    const size_t alphaTris = source.alphaIndices.size() / 3;
+    const size_t triCount = normalTris + alphaTris;
+    const uint32_t maxVertices = std::clamp<uint32_t>(options.maxVertices, 3, kMaxVertices);
+
+    auto fail = [&](const std::string& msg) {
+        if (error) *error = msg;
+        return false;
+    };
+
+    if (vertexCount == 0 || triCount == 0) {
+        return fail("Mesh has no triangles");
+    }
+
+    auto triIndex = [&](size_t t, int c) -> uint32_t {
+        return (t < normalTris) ? source.normalIndices[t * 3 + c] : source.alphaIndices[(t - normalTris) * 3 + c];
+    };
+
+    for (size_t t = 0; t < triCount; t++) {
+        for (int c = 0; c < 3; c++) {
+            if (triIndex(t, c) >= vertexCount) {
+                return fail("Index out of range: " + std::to_string(triIndex(t, c)));
+            }
+        }
+    }
+
+    auto makePart = [&]() {
+        C3Model::MeshPart part;
+        part.name = templ.name;
+        part.textureName = templ.textureName;
+        part.initialMatrix = templ.initialMatrix;
+        part.textureRow = templ.textureRow;
+        part.blendCount = templ.blendCount;
+        part.alphaKeyframes = templ.alphaKeyframes;
+        part.drawKeyframes = templ.drawKeyframes;
+        return part;
+    };
+
+    // Fast path: already fits, keep the original vertex order
+    if (vertexCount <= maxVertices) {
+        C3Model::MeshPart part = makePart();
+        part.vertices = source.vertices;
+        part.normalIndices.assign(source.normalIndices.begin(), source.normalIndices.end());
+        part.alphaIndices.assign(source.alphaIndices.begin(), source.alphaIndices.end());
+        FinishPart(part);
+        outParts.push_back(std::move(part));
+        return true;
+    }
+
+    // Morton order of triangle centroids gives spatially coherent seeds
+    XMFLOAT3 bmin{ FLT_MAX, FLT_MAX, FLT_MAX };
+    XMFLOAT3 bmax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (const auto& v : source.vertices) {
+        const XMFLOAT3& p = v.positions[0];
+        bmin.x = std::min(bmin.x, p.x); bmin.y = std::min(bmin.y, p.y); bmin.z = std::min(bmin.z, p.z);
+        bmax.x = std::max(bmax.x, p.x); bmax.y = std::max(bmax.y, p.y); bmax.z = std::max(bmax.z, p.z);
+    }
+    XMFLOAT3 invExtent{
+        (bmax.x > bmin.x) ? 1.0f / (bmax.x - bmin.x) : 0.0f,
+        (bmax.y > bmin.y) ? 1.0f / (bmax.y - bmin.y) : 0.0f,
+        (bmax.z > bmin.z) ? 1.0f / (bmax.z - bmin.z) : 0.0f
+    };
+
+    std::vector<std::pair<uint32_t, uint32_t>> order(triCount);
+    for (size_t t = 0; t < triCount; t++) {
+        XMFLOAT3 c{ 0, 0, 0 };
+        for (int k = 0; k < 3; k++) {
+            const XMFLOAT3& p = source.vertices[triIndex(t, k)].positions[0];
+            c.x += p.x; c.y += p.y; c.z += p.z;
+        }
+        order[t] = {
+            Morton3((c.x / 3 - bmin.x) * invExtent.x, (c.y / 3 - bmin.y) * invExtent.y, (c.z / 3 - bmin.z) * invExtent.z),
+            static_cast<uint32_t>(t)
+        };
+    }
+    std::sort(order.begin(), order.end());
+
+    // Vertex -> triangle adjacency (CSR)
+    std::vector<uint32_t> adjOffsets(vertexCount + 1, 0);
+    for (size_t t = 0; t < triCount; t++) {
+        for (int c = 0; c < 3; c++) adjOffsets[triIndex(t, c) + 1]++;
+    }
+    for (uint32_t v = 0; v < vertexCount; v++) adjOffsets[v + 1] += adjOffsets[v];
+    std::vector<uint32_t> adjTris(adjOffsets[vertexCount]);
+    {
+        std::vector<uint32_t> fill(adjOffsets.begin(), adjOffsets.end() - 1);
+        for (size_t t = 0; t < triCount; t++) {
+            for (int c = 0; c < 3; c++) adjTris[fill[triIndex(t, c)]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<uint8_t> assigned(triCount, 0);
+    std::vector<uint32_t> localIndex(vertexCount, UINT32_MAX);
+    std::vector<uint32_t> partVertices;
+    std::deque<uint32_t> frontier;
+    size_t seedCursor = 0;
+    size_t remaining = triCount;
+
+    while (remaining > 0) {
+        C3Model::MeshPart part = makePart();
+        partVertices.clear();
+        frontier.clear();
+
+        // Grow breadth-first through shared vertices; reseed in Morton order
+        // whenever the region is exhausted but the part still has room.
+        while (partVertices.size() + 3 <= maxVertices || !frontier.empty()) {
+            if (frontier.empty()) {
+                while (seedCursor < order.size() && assigned[order[seedCursor].second]) seedCursor++;
+                if (seedCursor == order.size()) break;
+                if (partVertices.size() + 3 > maxVertices) break;
+                frontier.push_back(order[seedCursor].second);
+            }
+
+            uint32_t t = frontier.front();
+            frontier.pop_front();
+            if (assigned[t]) continue;
+
+            uint32_t newVerts = 0;
+            for (int c = 0; c < 3; c++) {
+                if (localIndex[triIndex(t, c)] == UINT32_MAX) newVerts++;
+            }
+            if (partVertices.size() + newVerts > maxVertices) continue; // Picked up by a later part
+
+            uint16_t local[3];
+            for (int c = 0; c < 3; c++) {
+                uint32_t v = triIndex(t, c);
+                if (localIndex[v] == UINT32_MAX) {
+                    localIndex[v] = static_cast<uint32_t>(partVertices.size());
+                    partVertices.push_back(v);
+                }
+                local[c] = static_cast<uint16_t>(localIndex[v]);
+            }
+
+            std::vector<uint16_t>& dst = (t < normalTris) ? part.normalIndices.Edit() : part.alphaIndices.Edit();
+            dst.insert(dst.end(), local, local + 3);
+            assigned[t] = 1;
+            remaining--;
+
+            for (int c = 0; c < 3; c++) {
+                uint32_t v = triIndex(t, c);
+                for (uint32_t i = adjOffsets[v]; i < adjOffsets[v + 1]; i++) {
+                    if (!assigned[adjTris[i]]) frontier.push_back(adjTris[i]);
+                }
+            }
+        }
+
+        part.vertices.reserve(partVertices.size());
+        for (uint32_t v : partVertices) {
+            part.vertices.push_back(source.vertices[v]);
+            localIndex[v] = UINT32_MAX;
+        }
+
+        if (part.vertices.empty()) {
+            return fail("Failed to make progress while splitting mesh");
+        }
+
+        FinishPart(part);
+        outParts.push_back(std::move(part));
+    }
+
+    if (outParts.size() > 1) {
+        for (size_t i = 0; i < outParts.size(); i++) {
+            outParts[i].name = templ.name + "_part" + std::to_string(i);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "C3Model.h"
+#include <vector>
+
+// Splits 32-bit indexed meshes into PHY-compatible parts (16-bit indices).
+// Triangles are grown into parts from Morton-ordered seeds so each part is
+// spatially compact and shares as many vertices as possible.
+class C3MeshSplitter {
+public:
+    static constexpr uint32_t kMaxVertices = 65535; // 0xFFFF stays free as a restart value
+
+    struct SourceMesh {
+        std::vector<PhyVertex> vertices;
+        std::vector<uint32_t> normalIndices;
+        std::vector<uint32_t> alphaIndices;
+    };
+
+    struct Options {
+        uint32_t maxVertices = kMaxVertices;
+    };
+
+    // Every output part copies the non-geometry fields of 'templ'. Parts are
+    // named "<name>_part<N>" when more than one is produced.
+    static bool Split(const SourceMesh& source, const C3Model::MeshPart& templ,
+        std::vector<C3Model::MeshPart>& outParts, const Options& options, std::string* error = nullptr);
+
+    static bool Split(const SourceMesh& source, const C3Model::MeshPart& templ,
+        std::vector<C3Model::MeshPart>& outParts, std::string* error = nullptr) {
+        return Split(source, templ, outParts, Options{}, error);
+    }
+};
@@ -1,5 +1,6 @@
 #include "C3Model.h"
-#include <fstream>
+#include "C3BakedModel.h"
+#include "C3VirtualFileSystem.h"
 #include <algorithm>
 #include <cstring>
 #include <cmath>
@@ -7,25 +8,56 @@
 #include <cstdio>
 using namespace DirectX;
 
-bool C3Model::LoadFromFile(const std::string& path) {
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
-        m_error = "Failed to open file: " + path;
-        return false;
+namespace {
+
+// "<parent>_lod<N>", as C3MeshSimplifier names levels and C3Writer stores them
+bool SplitLODName(const std::string& name, std::string& parent, size_t& level) {
+    size_t pos = name.rfind("_lod");
+    if (pos == std::string::npos || pos == 0 || pos + 4 == name.size()) return false;
+    level = 0;
+    for (size_t i = pos + 4; i < name.size(); i++) {
+        if (name[i] < '0' || name[i] > '9' || level > 1000) return false;
+        level = level * 10 + size_t(name[i] - '0');
     }
+    parent = name.substr(0, pos);
+    return level > 0;
+}
 
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
+// A 76-byte chunk cut short can still pass for the 40-byte layout, leaving
+// garbage vertices and index counts read from the wrong place
+bool IndicesInRange(const C3Model::MeshPart& part) {
+    const size_t vertexCount = part.vertices.size();
+    auto inRange = [&](const std::vector<uint16_t>& indices) {
+        return std::all_of(indices.begin(), indices.end(), [&](uint16_t idx) { return idx < vertexCount; });
+    };
+    return inRange(part.normalIndices) && inRange(part.alphaIndices);
+}
 
-    std::vector<uint8_t> data(fileSize);
-    file.read(reinterpret_cast<char*>(data.data()), fileSize);
-    file.close();
+} // namespace
 
-    return LoadFromMemory(data);
+const C3Model::ChunkId* C3Model::FindChunkId(const void* id) {
+    for (const ChunkId& chunk : kChunkIds) {
+        if (memcmp(id, chunk.id, 4) == 0) return &chunk;
+    }
+    return nullptr;
+}
+
+bool C3Model::LoadFromFile(const std::string& path) {
+    // Loose overrides, then mounted archives, then the disk
+    C3VirtualFileSystem::FileData file;
+    if (!C3VirtualFileSystem::Get().Open(path, file, &m_error)) {
+        return false;
+    }
+
+    return LoadFromMemory(file.Data(), file.Size());
 }
 
 bool C3Model::LoadFromMemory(const std::vector<uint8_t>& data) {
-    if (data.size() < sizeof(C3FileHeader)) {
+    return LoadFromMemory(data.data(), data.size());
+}
+
+bool C3Model::LoadFromMemory(const uint8_t* data, size_t size) {
+    if (!data || size < sizeof(C3FileHeader)) {
         m_error = "File too small";
         return false;
     }
@@ -34,7 +66,7 @@ bool C3Model::LoadFromMemory(const std::vector<uint8_t>& data) {
 
     // Read C3 header (exactly like the reference code)
     C3FileHeader header;
-    memcpy(&header, data.data(), sizeof(C3FileHeader));
+    memcpy(&header, data, sizeof(C3FileHeader));
     offset += sizeof(C3FileHeader);
 
     if (strncmp(header.magic, "MAXFILE C3", 10) != 0) {
@@ -43,50 +75,34 @@ bool C3Model::LoadFromMemory(const std::vector<uint8_t>& data) {
     }
 
     // Get chunk type from header (NOT from a chunk ID!)
-    std::string chunkType(header.physicsType, 4);
+    const ChunkId* chunk = FindChunkId(header.physicsType);
+    if (!chunk || !chunk->inHeader) {
+        m_error = "Not a supported file type (type: " + std::string(header.physicsType, 4) + ")";
+        return false;
+    }
 
     // Read chunk size (at offset 20, NO chunk ID!)
-    if (offset + 4 > data.size()) {
+    if (offset + 4 > size) {
         m_error = "No chunk size";
         return false;
     }
 
-    uint32_t chunkSize = *reinterpret_cast<const uint32_t*>(data.data() + offset);
+    uint32_t chunkSize = *reinterpret_cast<const uint32_t*>(data + offset);
     offset += 4;
 
-    if (chunkSize == 0 || offset + chunkSize > data.size()) {
+    if (chunkSize == 0 || offset + chunkSize > size) {
         m_error = "Invalid chunk size: " + std::to_string(chunkSize);
         return false;
     }
 
-    // Parse PHY chunks only (like reference code)
-    if (chunkType == "PHY4" || chunkType == "PHY " || chunkType == "PHY3") {
-        if (!ParsePHYS(data.data(), offset, chunkSize)) {
-            return false;
-        }
-        m_type = (chunkType == "PHY3") ? C3ChunkType::PHY3 : 
-                 (chunkType == "PHY4") ? C3ChunkType::PHY4 : C3ChunkType::PHY;
-    }
-    else if (chunkType == "MOTI") {
-        if (!ParseMOTI(data.data(), offset, chunkSize)) {
-            return false;
-        }
-    }
-    else if (chunkType == "SMOT" || chunkType == "SHAP") {
-        if (!ParseSMOT(data.data(), offset, chunkSize)) {
-            return false;
-        }
-        m_type = C3ChunkType::SHAP;
+    if (!ParseChunk(chunk->parser, data, offset, chunkSize)) {
+        return false;
     }
-    else if (chunkType == "PTCL") {
-        if (!ParsePTCL(data.data(), offset, chunkSize)) {
-            return false;
-        }
-        m_type = C3ChunkType::PTCL;
+    if (chunk->type != C3ChunkType::Unknown) {
+        m_type = chunk->type;
     }
-    else {
-        m_error = "Not a supported file type (type: " + chunkType + ")";
-        return false;
+    if (chunk->parser == ChunkParser::Phy) {
+        ParseLODChunks(data, offset + chunkSize, size);
     }
 
     if (m_meshes.empty() && m_shapes.empty() && m_particles.empty()) {
@@ -99,8 +115,16 @@ bool C3Model::LoadFromMemory(const std::vector<uint8_t>& data) {
 }
 
 bool C3Model::ParsePHY(const uint8_t* data, size_t offset, size_t chunkSize) {
-    size_t chunkEnd = offset + chunkSize;
     MeshPart part;
+    if (!ReadPHY(data, offset, chunkSize, part)) {
+        return false;
+    }
+    m_meshes.push_back(std::move(part));
+    return true;
+}
+
+bool C3Model::ReadPHY(const uint8_t* data, size_t offset, size_t chunkSize, MeshPart& part) {
+    size_t chunkEnd = offset + chunkSize;
 
     // Read name (optional, variable length)
     if (offset + 4 > chunkEnd) {
@@ -137,16 +161,18 @@ bool C3Model::ParsePHY(const uint8_t* data, size_t offset, size_t chunkSize) {
     uint32_t alphaVertCount = *reinterpret_cast<const uint32_t*>(data + offset);
     offset += 4;
 
-    uint32_t totalVerts = normalVertCount + alphaVertCount;
-    if (totalVerts == 0 || totalVerts > 100000) {
-        m_error = "Invalid vertex count: " + std::to_string(totalVerts);
+    // Bound by the chunk itself rather than a fixed cap (at least 40 bytes per vertex)
+    uint64_t totalVerts64 = uint64_t(normalVertCount) + alphaVertCount;
+    if (totalVerts64 == 0 || totalVerts64 * 40 > chunkEnd - offset) {
+        m_error = "Invalid vertex count: " + std::to_string(totalVerts64);
         return false;
     }
+    uint32_t totalVerts = static_cast<uint32_t>(totalVerts64);
 
     // Check if we have 76-byte or 40-byte format
     size_t remainingBytes = chunkEnd - offset;
-    size_t required76 = totalVerts * 76;
-    size_t required40 = totalVerts * 40;
+    size_t required76 = size_t(totalVerts) * 76;
+    size_t required40 = size_t(totalVerts) * 40;
 
     part.vertices.resize(totalVerts);
 
@@ -237,6 +263,8 @@ bool C3Model::ParsePHY(const uint8_t* data, size_t offset, size_t chunkSize) {
         offset += sizeof(XMFLOAT3);
     }
 
+    ValidateMeshBounds(part);
+
     // Read initial matrix
     if (offset + sizeof(XMFLOAT4X4) <= chunkEnd) {
         memcpy(&part.initialMatrix, data + offset, sizeof(XMFLOAT4X4));
@@ -249,7 +277,6 @@ bool C3Model::ParsePHY(const uint8_t* data, size_t offset, size_t chunkSize) {
         offset += 4;
     }
 
-    m_meshes.push_back(std::move(part));
     return true;
 }
 
@@ -515,30 +542,27 @@ bool C3Model::ParsePHYS(const uint8_t* data, size_t offset, size_t chunkSize) {
 }
 
 bool C3Model::MergeFromFile(const std::string& path) {
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
-        m_error = "Failed to open file: " + path;
+    // Loose overrides, then mounted archives, then the disk
+    C3VirtualFileSystem::FileData file;
+    if (!C3VirtualFileSystem::Get().Open(path, file, &m_error)) {
         return false;
     }
 
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    std::vector<uint8_t> data(fileSize);
-    file.read(reinterpret_cast<char*>(data.data()), fileSize);
-    file.close();
-
-    return MergeFromMemory(data);
+    return MergeFromMemory(file.Data(), file.Size());
 }
 
 bool C3Model::MergeFromMemory(const std::vector<uint8_t>& data) {
-    if (data.size() < sizeof(C3FileHeader)) {
+    return MergeFromMemory(data.data(), data.size());
+}
+
+bool C3Model::MergeFromMemory(const uint8_t* data, size_t size) {
+    if (!data || size < sizeof(C3FileHeader)) {
         m_error = "File too small";
         return false;
     }
 
     C3FileHeader header;
-    memcpy(&header, data.data(), sizeof(C3FileHeader));
+    memcpy(&header, data, sizeof(C3FileHeader));
 
     if (strncmp(header.magic, "MAXFILE C3", 10) != 0) {
         m_error = "Invalid C3 file header";
@@ -548,33 +572,21 @@ bool C3Model::MergeFromMemory(const std::vector<uint8_t>& data) {
     // Parse chunks and merge data
     size_t offset = sizeof(C3FileHeader);
     bool merged = false;
+    const size_t firstMesh = m_meshes.size();
     
-    while (offset < data.size() - 8) {
+    while (offset < size - 8) {
         char chunkID[4];
         uint32_t chunkSize;
         
-        if (offset + 8 > data.size()) break;
-        memcpy(chunkID, data.data() + offset, 4);
-        memcpy(&chunkSize, data.data() + offset + 4, 4);
+        if (offset + 8 > size) break;
+        memcpy(chunkID, data + offset, 4);
+        memcpy(&chunkSize, data + offset + 4, 4);
         offset += 8;
         
-        std::string chunkStr(chunkID, 4);
         bool parsed = false;
         
-        if (chunkStr == "PHYS" || chunkStr == "PHY " || chunkStr == "PHY3" || chunkStr == "PHY4") {
-            parsed = ParsePHYS(data.data(), offset, chunkSize);
-            merged = true;
-        }
-        else if (chunkStr == "MOTI") {
-            parsed = ParseMOTI(data.data(), offset, chunkSize);
-            merged = true;
-        }
-        else if (chunkStr == "SMOT" || chunkStr == "SHAP") {
-            parsed = ParseSMOT(data.data(), offset, chunkSize);
-            merged = true;
-        }
-        else if (chunkStr == "PTCL") {
-            parsed = ParsePTCL(data.data(), offset, chunkSize);
+        if (const ChunkId* chunk = FindChunkId(chunkID)) {
+            parsed = ParseChunk(chunk->parser, data, offset, chunkSize);
             merged = true;
         }
         
@@ -588,12 +600,222 @@ bool C3Model::MergeFromMemory(const std::vector<uint8_t>& data) {
     }
     
     if (merged) {
+        for (size_t i = firstMesh; i < m_meshes.size();) {
+            if (!AttachLOD(i, firstMesh)) i++;
+        }
         CalculateBounds();
     }
     
     return merged;
 }
 
+bool C3Model::ParseChunk(ChunkParser parser, const uint8_t* data, size_t offset, size_t chunkSize) {
+    switch (parser) {
+    case ChunkParser::Phy: return ParsePHYS(data, offset, chunkSize);
+    case ChunkParser::Motion: return ParseMOTI(data, offset, chunkSize);
+    case ChunkParser::Shape: return ParseSMOT(data, offset, chunkSize);
+    case ChunkParser::Particle: return ParsePTCL(data, offset, chunkSize);
+    }
+    return false;
+}
+
+C3Model::MeshPart* C3Model::FindLODParent(const std::string& name, size_t firstMesh, size_t lastMesh) {
+    std::string parentName;
+    size_t level = 0;
+    if (!SplitLODName(name, parentName, level)) return nullptr;
+
+    for (size_t i = firstMesh; i < lastMesh; i++) {
+        MeshPart& parent = m_meshes[i];
+        if (parent.name == parentName && parent.lods.size() + 1 == level) return &parent;
+    }
+    return nullptr;
+}
+
+bool C3Model::AttachLOD(size_t index, size_t firstMesh) {
+    MeshPart* parent = FindLODParent(m_meshes[index].name, firstMesh, index);
+    if (!parent) return false;
+    parent->lods.push_back(std::move(m_meshes[index]));
+    m_meshes.erase(m_meshes.begin() + index);
+    return true;
+}
+
+void C3Model::ParseLODChunks(const uint8_t* data, size_t offset, size_t size) {
+    // The reference loader reads only the first chunk; anything after it
+    // other than LOD levels of the meshes already read is still ignored
+    const std::string error = m_error;
+    while (offset + 8 <= size) {
+        const ChunkId* chunk = FindChunkId(data + offset);
+        uint32_t chunkSize = 0;
+        memcpy(&chunkSize, data + offset + 4, 4);
+        offset += 8;
+        if (chunkSize == 0 || chunkSize > size - offset) break;
+
+        // Each level is parsed aside and attached only once it has checked
+        // out whole, so a damaged chunk leaves the model as it was
+        if (chunk && chunk->parser == ChunkParser::Phy) {
+            MeshPart lod;
+            if (ReadPHY(data, offset, chunkSize, lod) && IndicesInRange(lod)) {
+                if (MeshPart* parent = FindLODParent(lod.name, 0, m_meshes.size())) {
+                    parent->lods.push_back(std::move(lod));
+                }
+            }
+        }
+        offset += chunkSize;
+    }
+    m_error = error;
+}
+
+bool C3Model::SaveBaked(const std::string& path, uint64_t sourceChecksum, std::string* error) const {
+    return C3BakedModel::Write(*this, path, sourceChecksum, error);
+}
+
+bool C3Model::LoadBaked(const std::string& path) {
+    C3BakedModel baked;
+    if (!baked.Open(path)) {
+        m_error = baked.GetLastError();
+        return false;
+    }
+    return LoadFromBaked(baked);
+}
+
+bool C3Model::LoadFromBaked(const C3BakedModel& baked) {
+    if (!baked.IsOpen()) {
+        m_error = "Baked model is not open";
+        return false;
+    }
+
+    auto meshRecords = baked.GetMeshes();
+    std::vector<MeshPart> parts(meshRecords.size());
+    for (size_t i = 0; i < meshRecords.size(); i++) {
+        const C3BakedModel::MeshRecord& record = meshRecords[i];
+        MeshPart& part = parts[i];
+        part.name = baked.GetString(record.name);
+        part.textureName = baked.GetString(record.texture);
+        part.bboxMin = record.bboxMin;
+        part.bboxMax = record.bboxMax;
+        part.initialMatrix = record.initialMatrix;
+        part.textureRow = record.textureRow;
+        part.blendCount = record.blendCount;
+
+        // Streams back into the interleaved vertex layout
+        auto p0 = baked.GetBlock<XMFLOAT3>(record.positions[0]);
+        auto p1 = baked.GetBlock<XMFLOAT3>(record.positions[1]);
+        auto p2 = baked.GetBlock<XMFLOAT3>(record.positions[2]);
+        auto p3 = baked.GetBlock<XMFLOAT3>(record.positions[3]);
+        auto uvs = baked.GetBlock<XMFLOAT2>(record.uvs);
+        auto colors = baked.GetBlock<uint32_t>(record.colors);
+        auto boneIndices = baked.GetBlock<XMUINT2>(record.boneIndices);
+        auto boneWeights = baked.GetBlock<XMFLOAT2>(record.boneWeights);
+        part.vertices.resize(record.vertexCount);
+        for (uint32_t v = 0; v < record.vertexCount; v++) {
+            PhyVertex& out = part.vertices[v];
+            out.positions[0] = p0[v];
+            out.positions[1] = p1[v];
+            out.positions[2] = p2[v];
+            out.positions[3] = p3[v];
+            out.u = uvs[v].x;
+            out.v = uvs[v].y;
+            out.color = colors[v];
+            out.boneIndices[0] = boneIndices[v].x;
+            out.boneIndices[1] = boneIndices[v].y;
+            out.boneWeights[0] = boneWeights[v].x;
+            out.boneWeights[1] = boneWeights[v].y;
+        }
+
+        auto normalIndices = baked.GetBlock<uint16_t>(record.normalIndices);
+        auto alphaIndices = baked.GetBlock<uint16_t>(record.alphaIndices);
+        auto alphaKeys = baked.GetBlock<C3KeyFrame>(record.alphaKeys);
+        auto drawKeys = baked.GetBlock<C3KeyFrame>(record.drawKeys);
+        part.normalIndices.assign(normalIndices.begin(), normalIndices.end());
+        part.alphaIndices.assign(alphaIndices.begin(), alphaIndices.end());
+        part.alphaKeyframes.assign(alphaKeys.begin(), alphaKeys.end());
+        part.drawKeyframes.assign(drawKeys.begin(), drawKeys.end());
+    }
+
+    // LODs follow their parent; attach them from the back so each list keeps its order
+    for (size_t i = parts.size(); i-- > 0;) {
+        int32_t parent = meshRecords[i].parent;
+        if (parent >= 0) parts[parent].lods.insert(parts[parent].lods.begin(), std::move(parts[i]));
+    }
+    m_meshes.clear();
+    for (size_t i = 0; i < parts.size(); i++) {
+        if (meshRecords[i].parent < 0) m_meshes.push_back(std::move(parts[i]));
+    }
+
+    auto lines = baked.GetLines();
+    m_shapes.clear();
+    for (const auto& record : baked.GetShapes()) {
+        ShapeData shape;
+        shape.name = baked.GetString(record.name);
+        shape.textureName = baked.GetString(record.texture);
+        shape.segmentCount = record.segmentCount;
+        shape.lines.resize(record.lineCount);
+        for (uint32_t l = 0; l < record.lineCount; l++) {
+            auto points = baked.GetBlock<XMFLOAT3>(lines[record.firstLine + l].points);
+            shape.lines[l].points.assign(points.begin(), points.end());
+        }
+        m_shapes.push_back(std::move(shape));
+    }
+
+    m_particles.clear();
+    for (const auto& record : baked.GetParticles()) {
+        ParticleSystem ps;
+        ps.name = baked.GetString(record.name);
+        ps.textureName = baked.GetString(record.texture);
+        ps.emitterPos = record.emitterPos;
+        ps.emitRate = record.emitRate;
+        ps.lifetime = record.lifetime;
+        ps.speed = record.speed;
+        ps.size = record.size;
+        ps.startColor = record.startColor;
+        ps.endColor = record.endColor;
+        ps.maxParticles = record.maxParticles;
+        m_particles.push_back(std::move(ps));
+    }
+
+    m_bones.clear();
+    for (const auto& record : baked.GetBones()) {
+        Bone bone;
+        bone.bindMatrix = record.bindMatrix;
+        bone.invBindMatrix = record.invBindMatrix;
+        bone.name = baked.GetString(record.name);
+        bone.parentIndex = record.parentIndex;
+        m_bones.push_back(std::move(bone));
+    }
+
+    auto keyFrames = baked.GetKeyFrames();
+    m_animations.clear();
+    for (const auto& record : baked.GetAnimations()) {
+        Animation anim;
+        anim.name = baked.GetString(record.name);
+        anim.boneCount = record.boneCount;
+        anim.frameCount = record.frameCount;
+        anim.keyFrameCount = record.keyFrameCount;
+        anim.morphCount = record.morphCount;
+        auto morphWeights = baked.GetBlock<float>(record.morphWeights);
+        anim.morphWeights.assign(morphWeights.begin(), morphWeights.end());
+        anim.keyFrames.resize(record.keyFrameRecords);
+        for (uint32_t k = 0; k < record.keyFrameRecords; k++) {
+            const auto& key = keyFrames[record.firstKeyFrame + k];
+            auto matrices = baked.GetBlock<XMFLOAT4X4>(key.boneMatrices);
+            anim.keyFrames[k].frame = key.frame;
+            anim.keyFrames[k].boneMatrices.assign(matrices.begin(), matrices.end());
+        }
+        m_animations.push_back(std::move(anim));
+    }
+
+    const C3BakedModel::FileHeader& header = baked.GetHeader();
+    m_type = baked.GetType();
+    m_boundsMin = header.boundsMin;
+    m_boundsMax = header.boundsMax;
+    m_center = header.center;
+    m_radius = header.radius;
+    m_boundedMeshCount = m_meshes.size();
+    m_boundsStale = false;
+    m_error.clear();
+    return true;
+}
+
 void C3Model::SetAnimationFrame(uint32_t animIndex, uint32_t frame) {
     if (animIndex < m_animations.size()) {
         m_currentAnimIndex = animIndex;
@@ -656,25 +878,113 @@ void C3Model::InterpolateKeyFrames(const Animation& anim, uint32_t frame, std::v
     }
 }
 
-void C3Model::CalculateBounds() {
-    if (m_meshes.empty()) return;
-
-    XMFLOAT3 min{ FLT_MAX, FLT_MAX, FLT_MAX };
-    XMFLOAT3 max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
-
-    for (const auto& mesh : m_meshes) {
-        for (const auto& v : mesh.vertices) {
-            const XMFLOAT3& pos = v.positions[0];
-            min.x = std::min(min.x, pos.x);
-            min.y = std::min(min.y, pos.y);
-            min.z = std::min(min.z, pos.z);
-            max.x = std::max(max.x, pos.x);
-            max.y = std::max(max.y, pos.y);
-            max.z = std::max(max.z, pos.z);
+void C3Model::ComputeMeshBounds(const MeshPart& mesh, XMFLOAT3& outMin, XMFLOAT3& outMax) {
+    if (mesh.vertices.empty()) {
+        outMin = outMax = XMFLOAT3{ 0, 0, 0 };
+        return;
+    }
+
+    // Two independent min/max chains keep both SIMD pipes busy
+    XMVECTOR min0 = XMLoadFloat3(&mesh.vertices[0].positions[0]);
+    XMVECTOR max0 = min0;
+    XMVECTOR min1 = min0;
+    XMVECTOR max1 = min0;
+
+    const size_t count = mesh.vertices.size();
+    size_t i = 1;
+    for (; i + 1 < count; i += 2) {
+        XMVECTOR p0 = XMLoadFloat3(&mesh.vertices[i].positions[0]);
+        XMVECTOR p1 = XMLoadFloat3(&mesh.vertices[i + 1].positions[0]);
+        min0 = XMVectorMin(min0, p0);
+        max0 = XMVectorMax(max0, p0);
+        min1 = XMVectorMin(min1, p1);
+        max1 = XMVectorMax(max1, p1);
+    }
+    if (i < count) {
+        XMVECTOR p = XMLoadFloat3(&mesh.vertices[i].positions[0]);
+        min0 = XMVectorMin(min0, p);
+        max0 = XMVectorMax(max0, p);
+    }
+
+    XMStoreFloat3(&outMin, XMVectorMin(min0, min1));
+    XMStoreFloat3(&outMax, XMVectorMax(max0, max1));
+}
+
+void C3Model::ValidateMeshBounds(MeshPart& part) {
+    // Keep the file's bbox when it plausibly fits the geometry; stale or
+    // missing boxes are replaced by the fitted one so later merges can trust it.
+    XMFLOAT3 actualMin, actualMax;
+    ComputeMeshBounds(part, actualMin, actualMax);
+
+    float dx = actualMax.x - actualMin.x;
+    float dy = actualMax.y - actualMin.y;
+    float dz = actualMax.z - actualMin.z;
+    float eps = 1e-4f * sqrtf(dx * dx + dy * dy + dz * dz) + 1e-6f;
+
+    bool encloses =
+        part.bboxMin.x <= actualMin.x + eps && part.bboxMin.y <= actualMin.y + eps && part.bboxMin.z <= actualMin.z + eps &&
+        part.bboxMax.x >= actualMax.x - eps && part.bboxMax.y >= actualMax.y - eps && part.bboxMax.z >= actualMax.z - eps;
+
+    // A box far larger than the geometry is as useless for culling as a wrong one
+    float fx = part.bboxMax.x - part.bboxMin.x;
+    float fy = part.bboxMax.y - part.bboxMin.y;
+    float fz = part.bboxMax.z - part.bboxMin.z;
+    bool tight = sqrtf(fx * fx + fy * fy + fz * fz) <= 2.0f * sqrtf(dx * dx + dy * dy + dz * dz) + eps;
+
+    if (!encloses || !tight) {
+        part.bboxMin = actualMin;
+        part.bboxMax = actualMax;
+    }
+}
+
+void C3Model::RecalculateBounds(bool refreshMeshBounds) {
+    if (refreshMeshBounds) {
+        for (auto& mesh : m_meshes) {
+            ComputeMeshBounds(mesh, mesh.bboxMin, mesh.bboxMax);
         }
     }
 
-    m_center = XMFLOAT3{
+    m_boundsStale = true;
+    CalculateBounds();
+}
+
+void C3Model::CalculateBounds() {
+    // Meshes were edited or removed behind our back; start over
+    if (m_boundsStale || m_boundedMeshCount > m_meshes.size()) {
+        m_boundsMin = XMFLOAT3{ FLT_MAX, FLT_MAX, FLT_MAX };
+        m_boundsMax = XMFLOAT3{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        m_boundedMeshCount = 0;
+    }
+
+    // Only meshes added since the last call are folded in, so merging N
+    // files costs O(N) mesh visits instead of re-walking every vertex.
+    const Bounds bounds = FoldBounds(m_boundedMeshCount, { m_boundsMin, m_boundsMax, m_center, m_radius });
+    m_boundsMin = bounds.min;
+    m_boundsMax = bounds.max;
+    m_center = bounds.center;
+    m_radius = bounds.radius;
+    m_boundedMeshCount = m_meshes.size();
+    m_boundsStale = false;
+}
+
+C3Model::Bounds C3Model::FoldBounds(size_t firstMesh, Bounds bounds) const {
+    XMVECTOR vmin = XMLoadFloat3(&bounds.min);
+    XMVECTOR vmax = XMLoadFloat3(&bounds.max);
+    for (size_t i = firstMesh; i < m_meshes.size(); i++) {
+        const MeshPart& mesh = m_meshes[i];
+        if (mesh.vertices.empty()) continue;
+        vmin = XMVectorMin(vmin, XMLoadFloat3(&mesh.bboxMin));
+        vmax = XMVectorMax(vmax, XMLoadFloat3(&mesh.bboxMax));
+    }
+    XMStoreFloat3(&bounds.min, vmin);
+    XMStoreFloat3(&bounds.max, vmax);
+
+    if (bounds.min.x > bounds.max.x) return bounds;
+
+    const XMFLOAT3& min = bounds.min;
+    const XMFLOAT3& max = bounds.max;
+
+    bounds.center = XMFLOAT3{
         (min.x + max.x) * 0.5f,
         (min.y + max.y) * 0.5f,
         (min.z + max.z) * 0.5f
@@ -683,5 +993,95 @@ void C3Model::CalculateBounds() {
     float dx = max.x - min.x;
     float dy = max.y - min.y;
     float dz = max.z - min.z;
-    m_radius = sqrtf(dx * dx + dy * dy + dz * dz) * 0.5f;
-}
\ No newline at end of file
+    bounds.radius = sqrtf(dx * dx + dy * dy + dz * dz) * 0.5f;
+    return bounds;
+}
+
+// Computed rather than cached while stale, so a const model shared between
+// threads is never written by a query
+C3Model::Bounds C3Model::CurrentBounds() const {
+    if (!m_boundsStale) return { m_boundsMin, m_boundsMax, m_center, m_radius };
+    return FoldBounds(0, { XMFLOAT3{ FLT_MAX, FLT_MAX, FLT_MAX }, XMFLOAT3{ -FLT_MAX, -FLT_MAX, -FLT_MAX }, m_center, m_radius });
+}
+
+namespace {
+
+// Heap bytes of a string; short strings live inside the object
+size_t StringBytes(const std::string& s) {
+    return s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0;
+}
+
+template <typename T>
+size_t VectorBytes(const std::vector<T>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+// Counted in full even when shared, so a budget charged with it stays an upper bound
+template <typename T>
+size_t VectorBytes(const C3SharedBuffer<T>& v) {
+    return VectorBytes(v.Get());
+}
+
+size_t MeshBytes(const C3Model::MeshPart& mesh) {
+    size_t bytes = StringBytes(mesh.name) + StringBytes(mesh.textureName) + VectorBytes(mesh.vertices) +
+        VectorBytes(mesh.normalIndices) + VectorBytes(mesh.alphaIndices) + VectorBytes(mesh.alphaKeyframes) +
+        VectorBytes(mesh.drawKeyframes) + VectorBytes(mesh.lods);
+    for (const auto& lod : mesh.lods) bytes += MeshBytes(lod);
+    return bytes;
+}
+
+} // namespace
+
+size_t C3Model::GetMemoryUsage() const {
+    size_t bytes = sizeof(*this) + StringBytes(m_error) + VectorBytes(m_meshes) + VectorBytes(m_shapes) +
+        VectorBytes(m_particles) + VectorBytes(m_bones) + VectorBytes(m_animations);
+    for (const auto& mesh : m_meshes) bytes += MeshBytes(mesh);
+    for (const auto& shape : m_shapes) {
+        bytes += StringBytes(shape.name) + StringBytes(shape.textureName) + VectorBytes(shape.lines);
+        for (const auto& line : shape.lines) bytes += VectorBytes(line.points);
+    }
+    for (const auto& particle : m_particles) bytes += StringBytes(particle.name) + StringBytes(particle.textureName);
+    for (const auto& bone : m_bones) bytes += StringBytes(bone.name);
+    for (const auto& animation : m_animations) {
+        bytes += StringBytes(animation.name) + VectorBytes(animation.keyFrames) + VectorBytes(animation.morphWeights);
+        for (const auto& keyFrame : animation.keyFrames) bytes += VectorBytes(keyFrame.boneMatrices);
+    }
+    return bytes;
+}
+
+BoundingSphere C3Model::FitBoundingSphere(size_t meshIndex) const {
+    BoundingSphere sphere;
+    if (meshIndex >= m_meshes.size() || m_meshes[meshIndex].vertices.empty()) return sphere;
+
+    const MeshPart& mesh = m_meshes[meshIndex];
+    BoundingSphere::CreateFromPoints(sphere, mesh.vertices.size(),
+        &mesh.vertices[0].positions[0], sizeof(PhyVertex));
+    return sphere;
+}
+
+BoundingSphere C3Model::FitBoundingSphere() const {
+    BoundingSphere result;
+    bool first = true;
+    for (size_t i = 0; i < m_meshes.size(); i++) {
+        if (m_meshes[i].vertices.empty()) continue;
+        BoundingSphere sphere = FitBoundingSphere(i);
+        if (first) {
+            result = sphere;
+            first = false;
+        }
+        else {
+            BoundingSphere::CreateMerged(result, result, sphere);
+        }
+    }
+    return result;
+}
+
+BoundingOrientedBox C3Model::FitOrientedBox(size_t meshIndex) const {
+    BoundingOrientedBox box;
+    if (meshIndex >= m_meshes.size() || m_meshes[meshIndex].vertices.empty()) return box;
+
+    const MeshPart& mesh = m_meshes[meshIndex];
+    BoundingOrientedBox::CreateFromPoints(box, mesh.vertices.size(),
+        &mesh.vertices[0].positions[0], sizeof(PhyVertex));
+    return box;
+}
@@ -1,14 +1,21 @@
 #pragma once
+#include "C3SharedBuffer.h"
 #include "C3Types.h"
+#include <DirectXCollision.h>
 #include <memory>
+#include <cfloat>
+
+class C3BakedModel;
 
 class C3Model {
 public:
     struct MeshPart {
         std::string name;
-        std::vector<PhyVertex> vertices;
-        std::vector<uint16_t> normalIndices;
-        std::vector<uint16_t> alphaIndices;
+        // Shared between copies until written (see C3SharedBuffer), so
+        // models interned by C3DedupStore can hold identical geometry once
+        C3SharedBuffer<PhyVertex> vertices;
+        C3SharedBuffer<uint16_t> normalIndices;
+        C3SharedBuffer<uint16_t> alphaIndices;
         std::string textureName;
         XMFLOAT3 bboxMin{}, bboxMax{};
         XMFLOAT4X4 initialMatrix{};
@@ -16,6 +23,7 @@ public:
         uint32_t blendCount = 0;
         std::vector<C3KeyFrame> alphaKeyframes;
         std::vector<C3KeyFrame> drawKeyframes;
+        std::vector<MeshPart> lods; // Simplified levels, coarsest last (see C3MeshSimplifier)
     };
 
     struct ShapeData {
@@ -62,17 +70,48 @@ public:
         uint32_t morphCount = 0;
     };
 
+    // Every chunk id the loader understands and how it reads each one, so
+    // tools that inspect C3 files (C3ArchiveVerifier) agree with it
+    enum class ChunkParser : uint8_t { Phy, Motion, Shape, Particle };
+    struct ChunkId {
+        const char* id;     // Four characters
+        ChunkParser parser;
+        C3ChunkType type;   // Model type when it names the first chunk; Unknown leaves it unset
+        bool inHeader;      // May name the first chunk in C3FileHeader::physicsType
+    };
+    static constexpr ChunkId kChunkIds[] = {
+        { "PHY ", ChunkParser::Phy, C3ChunkType::PHY, true },
+        { "PHY3", ChunkParser::Phy, C3ChunkType::PHY3, true },
+        { "PHY4", ChunkParser::Phy, C3ChunkType::PHY4, true },
+        { "PHYS", ChunkParser::Phy, C3ChunkType::PHY, false },
+        { "MOTI", ChunkParser::Motion, C3ChunkType::Unknown, true },
+        { "SMOT", ChunkParser::Shape, C3ChunkType::SHAP, true },
+        { "SHAP", ChunkParser::Shape, C3ChunkType::SHAP, true },
+        { "PTCL", ChunkParser::Particle, C3ChunkType::PTCL, true },
+    };
+    // Null if the four bytes at 'id' are not a known chunk id
+    static const ChunkId* FindChunkId(const void* id);
+
     C3Model() = default;
     ~C3Model() = default;
 
     bool LoadFromFile(const std::string& path);
     bool LoadFromMemory(const std::vector<uint8_t>& data);
+    bool LoadFromMemory(const uint8_t* data, size_t size); // Parses in place, e.g. from an archive mapping
     bool MergeFromFile(const std::string& path); // Merge additional C3 file data
     bool MergeFromMemory(const std::vector<uint8_t>& data);
+    bool MergeFromMemory(const uint8_t* data, size_t size);
+
+    // Baked form (see C3BakedModel): a mapped file copied back block by
+    // block, with nothing decoded field by field
+    bool SaveBaked(const std::string& path, uint64_t sourceChecksum = 0, std::string* error = nullptr) const;
+    bool LoadBaked(const std::string& path);
+    bool LoadFromBaked(const C3BakedModel& baked);
 
     C3ChunkType GetType() const { return m_type; }
     const std::vector<MeshPart>& GetMeshes() const { return m_meshes; }
-    std::vector<MeshPart>& GetMeshes() { return m_meshes; }
+    // Mutable access marks the model bounds stale (see RecalculateBounds)
+    std::vector<MeshPart>& GetMeshes() { m_boundsStale = true; return m_meshes; }
     const std::vector<ShapeData>& GetShapes() const { return m_shapes; }
     std::vector<ShapeData>& GetShapes() { return m_shapes; }
     const std::vector<ParticleSystem>& GetParticles() const { return m_particles; }
@@ -83,8 +122,26 @@ public:
     std::vector<Animation>& GetAnimations() { return m_animations; }
     const std::string& GetError() const { return m_error; }
 
-    XMFLOAT3 GetCenter() const { return m_center; }
-    float GetRadius() const { return m_radius; }
+    XMFLOAT3 GetCenter() const { return CurrentBounds().center; }
+    float GetRadius() const { return CurrentBounds().radius; }
+    XMFLOAT3 GetBoundsMin() const { return CurrentBounds().min; }
+    XMFLOAT3 GetBoundsMax() const { return CurrentBounds().max; }
+
+    // Bounds are accumulated from per-mesh bboxes as meshes are added. While
+    // the meshes are stale (handed out mutably since the last fold) the getters
+    // refold every mesh bbox on each call; this stores the result again.
+    // refreshMeshBounds also re-fits each mesh bbox to its vertices.
+    void RecalculateBounds(bool refreshMeshBounds = false);
+    static void ComputeMeshBounds(const MeshPart& mesh, XMFLOAT3& outMin, XMFLOAT3& outMax);
+
+    // Bytes this model owns: the object plus every vector and string buffer
+    // it has allocated (capacities, not sizes), without allocator overhead
+    size_t GetMemoryUsage() const;
+
+    // Tighter culling volumes, fitted to the base pose on demand
+    BoundingSphere FitBoundingSphere(size_t meshIndex) const;
+    BoundingSphere FitBoundingSphere() const;
+    BoundingOrientedBox FitOrientedBox(size_t meshIndex) const;
     
     // Animation helpers
     void SetAnimationFrame(uint32_t animIndex, uint32_t frame);
@@ -100,15 +157,38 @@ private:
     std::string m_error;
     XMFLOAT3 m_center{};
     float m_radius = 1.0f;
+    XMFLOAT3 m_boundsMin{ FLT_MAX, FLT_MAX, FLT_MAX };
+    XMFLOAT3 m_boundsMax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    size_t m_boundedMeshCount = 0; // Meshes already folded into m_boundsMin/Max
+    bool m_boundsStale = false;    // Meshes may have changed since they were folded
     
     uint32_t m_currentAnimIndex = 0;
     uint32_t m_currentFrame = 0;
 
     bool ParsePHY(const uint8_t* data, size_t offset, size_t chunkSize);
+    bool ReadPHY(const uint8_t* data, size_t offset, size_t chunkSize, MeshPart& part); // Without adding it
     bool ParseSMOT(const uint8_t* data, size_t offset, size_t chunkSize);
     bool ParsePTCL(const uint8_t* data, size_t offset, size_t chunkSize);
     bool ParseMOTI(const uint8_t* data, size_t offset, size_t chunkSize);
     bool ParsePHYS(const uint8_t* data, size_t offset, size_t chunkSize); // Physics chunk with bones
+    bool ParseChunk(ChunkParser parser, const uint8_t* data, size_t offset, size_t chunkSize);
+    // The mesh in m_meshes[firstMesh, lastMesh) that a "<parent>_lod<N>"
+    // name would be level N of, if N is its next level
+    MeshPart* FindLODParent(const std::string& name, size_t firstMesh, size_t lastMesh);
+    // Moves m_meshes[index] into its parent's lods if it is "<parent>_lod<N>",
+    // the parent is at or after firstMesh and N is its next level
+    bool AttachLOD(size_t index, size_t firstMesh);
+    void ParseLODChunks(const uint8_t* data, size_t offset, size_t size);
+    struct Bounds {
+        XMFLOAT3 min;
+        XMFLOAT3 max;
+        XMFLOAT3 center;
+        float radius;
+    };
+
     void CalculateBounds();
+    Bounds FoldBounds(size_t firstMesh, Bounds bounds) const;
+    Bounds CurrentBounds() const;
+    void ValidateMeshBounds(MeshPart& part);
     void InterpolateKeyFrames(const Animation& anim, uint32_t frame, std::vector<XMFLOAT4X4>& outMatrices);
 };
\ No newline at end of file
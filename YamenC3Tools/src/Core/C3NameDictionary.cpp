@@ -0,0 +1,260 @@
+#include "C3NameDictionary.h"
+#include "C3Archive.h"
+#include "C3HashSystem.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+namespace {
+
+void PutVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool GetVarint(const uint8_t*& p, const uint8_t* end, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        value |= uint32_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+size_t SharedPrefix(const std::string& a, const std::string& b) {
+    size_t n = std::min(a.size(), b.size());
+    size_t i = 0;
+    while (i < n && a[i] == b[i]) i++;
+    return i;
+}
+
+template <typename T>
+void Append(std::vector<uint8_t>& out, const T* data, size_t count) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + count * sizeof(T));
+}
+
+} // namespace
+
+C3NameDictionary::Scheme C3NameDictionary::SchemeFor(const C3Archive& archive) {
+    return strcmp(archive.GetIdScheme(), "DNP") == 0 ? Scheme::Dnp : Scheme::Wdf;
+}
+
+bool C3NameDictionary::Build(std::vector<std::string> paths, Scheme scheme) {
+    Clear();
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+    if (paths.size() > UINT32_MAX / 2) {
+        m_lastError = "Too many paths for a name dictionary";
+        return false;
+    }
+    const uint32_t count = static_cast<uint32_t>(paths.size());
+
+    std::vector<uint32_t> pathIds(count);
+    {
+        std::vector<std::string_view> views(paths.begin(), paths.end());
+        if (scheme == Scheme::Dnp) C3HashSystem::DnpRealNameBatch(views, pathIds);
+        else C3HashSystem::RealNameBatch(views, pathIds);
+    }
+
+    std::vector<uint32_t> pathIndices(count);
+    std::iota(pathIndices.begin(), pathIndices.end(), 0u);
+    std::sort(pathIndices.begin(), pathIndices.end(), [&](uint32_t a, uint32_t b) {
+        return pathIds[a] != pathIds[b] ? pathIds[a] < pathIds[b] : a < b;
+    });
+    std::vector<uint32_t> ids(count);
+    for (uint32_t i = 0; i < count; i++) ids[i] = pathIds[pathIndices[i]];
+
+    std::vector<uint8_t> blob;
+    std::vector<uint32_t> blockOffsets;
+    for (uint32_t i = 0; i < count; i++) {
+        const std::string& path = paths[i];
+        size_t shared = 0;
+        if (i % kBlockSize == 0) {
+            blockOffsets.push_back(static_cast<uint32_t>(blob.size()));
+        }
+        else {
+            shared = SharedPrefix(paths[i - 1], path);
+            PutVarint(blob, static_cast<uint32_t>(shared));
+        }
+        PutVarint(blob, static_cast<uint32_t>(path.size() - shared));
+        blob.insert(blob.end(), path.begin() + shared, path.end());
+        if (blob.size() > UINT32_MAX) {
+            m_lastError = "Path data too large for a name dictionary";
+            return false;
+        }
+    }
+    blockOffsets.push_back(static_cast<uint32_t>(blob.size()));
+
+    FileHeader header{};
+    memcpy(header.magic, "C3ND", 4);
+    header.version = kVersion;
+    header.scheme = static_cast<uint32_t>(scheme);
+    header.entryCount = count;
+    header.blockSize = kBlockSize;
+    header.blobSize = static_cast<uint32_t>(blob.size());
+
+    std::vector<uint8_t> image;
+    image.reserve(sizeof(header) + (ids.size() * 2 + blockOffsets.size()) * sizeof(uint32_t) + blob.size());
+    Append(image, &header, 1);
+    Append(image, ids.data(), ids.size());
+    Append(image, pathIndices.data(), pathIndices.size());
+    Append(image, blockOffsets.data(), blockOffsets.size());
+    Append(image, blob.data(), blob.size());
+
+    m_built = std::move(image);
+    return Attach(m_built.data(), m_built.size());
+}
+
+bool C3NameDictionary::BuildFromList(const std::string& listPath, Scheme scheme) {
+    std::ifstream file(listPath);
+    if (!file) {
+        m_lastError = "Failed to open path list: " + listPath;
+        return false;
+    }
+
+    std::vector<std::string> paths;
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t begin = line.find_first_not_of(" \t");
+        size_t end = line.find_last_not_of(" \t\r");
+        if (begin == std::string::npos || line[begin] == '#') continue;
+        paths.push_back(line.substr(begin, end - begin + 1));
+    }
+    return Build(std::move(paths), scheme);
+}
+
+bool C3NameDictionary::Save(const std::string& path) {
+    if (!m_header) {
+        m_lastError = "No dictionary to save";
+        return false;
+    }
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        m_lastError = "Failed to create name dictionary: " + path;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(m_header), static_cast<std::streamsize>(m_size));
+    if (!file) {
+        m_lastError = "Failed to write name dictionary: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool C3NameDictionary::Load(const std::string& path) {
+    Clear();
+    if (!m_file.Open(path)) {
+        m_lastError = m_file.GetLastError();
+        return false;
+    }
+    if (!Attach(m_file.Data(), m_file.Size())) {
+        m_lastError += ": " + path;
+        m_file.Close();
+        return false;
+    }
+    return true;
+}
+
+void C3NameDictionary::Clear() {
+    m_file.Close();
+    m_built.clear();
+    m_header = nullptr;
+    m_ids = m_pathIndices = m_blockOffsets = nullptr;
+    m_blob = nullptr;
+    m_size = 0;
+}
+
+bool C3NameDictionary::Attach(const uint8_t* data, size_t size) {
+    FileHeader header{};
+    if (size < sizeof(header)) {
+        m_lastError = "Not a name dictionary";
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, "C3ND", 4) != 0) {
+        m_lastError = "Not a name dictionary";
+        return false;
+    }
+    if (header.version != kVersion || header.blockSize == 0 || header.scheme > uint32_t(Scheme::Dnp)) {
+        m_lastError = "Unsupported name dictionary version " + std::to_string(header.version);
+        return false;
+    }
+
+    const uint64_t blockCount = (uint64_t(header.entryCount) + header.blockSize - 1) / header.blockSize;
+    const uint64_t tableBytes = (uint64_t(header.entryCount) * 2 + blockCount + 1) * sizeof(uint32_t);
+    if (sizeof(header) + tableBytes + header.blobSize != size) {
+        m_lastError = "Truncated name dictionary";
+        return false;
+    }
+
+    const uint32_t* tables = reinterpret_cast<const uint32_t*>(data + sizeof(header));
+    const uint32_t* blockOffsets = tables + uint64_t(header.entryCount) * 2;
+    // Offsets must be ascending and inside the blob; decoding checks the rest
+    for (uint64_t b = 0; b <= blockCount; b++) {
+        if (blockOffsets[b] > header.blobSize || (b > 0 && blockOffsets[b] < blockOffsets[b - 1])) {
+            m_lastError = "Corrupt name dictionary block table";
+            return false;
+        }
+    }
+
+    m_header = reinterpret_cast<const FileHeader*>(data);
+    m_ids = tables;
+    m_pathIndices = tables + header.entryCount;
+    m_blockOffsets = blockOffsets;
+    m_blob = data + sizeof(header) + tableBytes;
+    m_size = size;
+    return true;
+}
+
+bool C3NameDictionary::GetPath(size_t index, std::string& out) const {
+    if (!m_header || index >= m_header->entryCount) return false;
+
+    const size_t block = index / m_header->blockSize;
+    const uint8_t* p = m_blob + m_blockOffsets[block];
+    const uint8_t* end = m_blob + m_blockOffsets[block + 1];
+
+    out.clear();
+    for (size_t i = block * m_header->blockSize; i <= index; i++) {
+        uint32_t shared = 0;
+        uint32_t length = 0;
+        if (i != block * m_header->blockSize && !GetVarint(p, end, shared)) return false;
+        if (!GetVarint(p, end, length) || shared > out.size() || length > size_t(end - p)) return false;
+        out.resize(shared);
+        out.append(reinterpret_cast<const char*>(p), length);
+        p += length;
+    }
+    return true;
+}
+
+bool C3NameDictionary::Lookup(uint32_t id, std::string& out) const {
+    if (!m_header) return false;
+    const uint32_t* end = m_ids + m_header->entryCount;
+    const uint32_t* it = std::lower_bound(m_ids, end, id);
+    return it != end && *it == id && GetPath(m_pathIndices[it - m_ids], out);
+}
+
+std::vector<std::string> C3NameDictionary::LookupAll(uint32_t id) const {
+    std::vector<std::string> paths;
+    if (!m_header) return paths;
+    const uint32_t* end = m_ids + m_header->entryCount;
+    for (const uint32_t* it = std::lower_bound(m_ids, end, id); it != end && *it == id; ++it) {
+        std::string path;
+        if (GetPath(m_pathIndices[it - m_ids], path)) paths.push_back(std::move(path));
+    }
+    return paths;
+}
+
+std::string C3NameDictionary::Describe(uint32_t id) const {
+    std::string path;
+    if (Lookup(id, path)) return path;
+    char hex[16];
+    snprintf(hex, sizeof(hex), "0x%08X", id);
+    return hex;
+}
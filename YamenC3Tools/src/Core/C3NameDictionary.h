@@ -0,0 +1,93 @@
+#pragma once
+#include "C3MappedFile.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+class C3Archive;
+
+// Maps archive file ids back to the paths they were hashed from, so listings
+// and error messages can show names instead of opaque numbers. Built from a
+// list of known paths and saved as one file that Load() memory-maps: the
+// sorted ids, each id's path index, and the paths themselves sorted and
+// front-coded in blocks (the first path of a block whole, the rest as a
+// shared prefix length plus suffix). Nothing is decoded up front, so even
+// millions of entries load in about the time it takes to map the file.
+//
+// Lookups are const and safe from any number of threads once built or loaded.
+class C3NameDictionary {
+public:
+    // Which id function the paths go through
+    enum class Scheme : uint32_t {
+        Wdf, // C3HashSystem::RealName (WDF and WDZ archives)
+        Dnp, // C3HashSystem::DnpRealName
+    };
+
+#pragma pack(push, 1)
+    struct FileHeader {
+        char magic[4]; // "C3ND"
+        uint32_t version;
+        uint32_t scheme;
+        uint32_t entryCount;
+        uint32_t blockSize;  // Paths per front-coded block
+        uint32_t blobSize;   // Bytes of front-coded path data
+        uint64_t reserved;
+        // uint32_t ids[entryCount], sorted
+        // uint32_t pathIndices[entryCount], parallel to ids
+        // uint32_t blockOffsets[blockCount + 1], into the blob
+        // uint8_t blob[blobSize]
+    };
+#pragma pack(pop)
+
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kBlockSize = 16;
+
+    C3NameDictionary() = default;
+    C3NameDictionary(const C3NameDictionary&) = delete;
+    C3NameDictionary& operator=(const C3NameDictionary&) = delete;
+
+    static Scheme SchemeFor(const C3Archive& archive);
+
+    // Duplicate paths are dropped; paths sharing an id are all kept
+    bool Build(std::vector<std::string> paths, Scheme scheme);
+    // One path per line; blank lines and lines starting with '#' are skipped
+    bool BuildFromList(const std::string& listPath, Scheme scheme);
+
+    bool Save(const std::string& path);
+    bool Load(const std::string& path);
+    void Clear();
+
+    bool IsLoaded() const { return m_header != nullptr; }
+    Scheme GetScheme() const { return m_header ? static_cast<Scheme>(m_header->scheme) : Scheme::Wdf; }
+    size_t GetEntryCount() const { return m_header ? m_header->entryCount : 0; }
+    // Bytes the dictionary occupies, mapped or built
+    size_t GetStorageSize() const { return m_size; }
+
+    // First path with this id; false if the id is unknown
+    bool Lookup(uint32_t id, std::string& out) const;
+    // Every path with this id, more than one on a hash collision
+    std::vector<std::string> LookupAll(uint32_t id) const;
+    // The path if known, otherwise the id as "0x1A2B3C4D"
+    std::string Describe(uint32_t id) const;
+
+    // Path at a position in sorted order, for listing the whole dictionary
+    bool GetPath(size_t index, std::string& out) const;
+
+    const std::string& GetLastError() const { return m_lastError; }
+
+private:
+    // Points the views at a complete image in memory; false if it is malformed
+    bool Attach(const uint8_t* data, size_t size);
+
+    C3MappedFile m_file;
+    std::vector<uint8_t> m_built;  // Image made by Build(), same layout as the file
+
+    const FileHeader* m_header = nullptr;
+    const uint32_t* m_ids = nullptr;
+    const uint32_t* m_pathIndices = nullptr;
+    const uint32_t* m_blockOffsets = nullptr;
+    const uint8_t* m_blob = nullptr;
+    size_t m_size = 0;
+
+    std::string m_lastError;
+};
@@ -0,0 +1,210 @@
+#include "C3PerfectHash.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+constexpr uint32_t kKeysPerBucket = 4;
+constexpr uint32_t kMaxSeedAttempts = 16;
+
+} // namespace
+
+bool C3PerfectHash::Build(std::span<const uint32_t> keys) {
+    auto start = std::chrono::steady_clock::now();
+    Clear();
+    if (keys.size() >= UINT32_MAX) {
+        m_lastError = "Too many keys for a perfect hash";
+        return false;
+    }
+
+    std::vector<uint32_t> sorted(keys.begin(), keys.end());
+    std::sort(sorted.begin(), sorted.end());
+    auto duplicate = std::adjacent_find(sorted.begin(), sorted.end());
+    if (duplicate != sorted.end()) {
+        char hex[16];
+        snprintf(hex, sizeof(hex), "%08X", *duplicate);
+        m_lastError = std::string("Duplicate id ") + hex + ", ids must be distinct";
+        return false;
+    }
+    if (keys.empty()) {
+        m_lastError = "No keys to hash";
+        return false;
+    }
+
+    for (uint32_t attempt = 0; attempt < kMaxSeedAttempts; attempt++) {
+        m_stats.seedAttempts = attempt + 1;
+        if (TryBuild(keys, Mix(0x5EED0000ULL + attempt))) {
+            m_stats.keyCount = keys.size();
+            m_stats.bucketCount = m_pilots.size();
+            m_stats.bitsPerKey = 32.0 * double(m_pilots.size()) / double(keys.size());
+            m_stats.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            return true;
+        }
+    }
+    Clear();
+    m_lastError = "No perfect hash found for the key set";
+    return false;
+}
+
+bool C3PerfectHash::TryBuild(std::span<const uint32_t> keys, uint64_t seed) {
+    const uint32_t n = static_cast<uint32_t>(keys.size());
+    const uint32_t bucketCount = std::max(1u, (n + kKeysPerBucket - 1) / kKeysPerBucket);
+    const uint64_t maxPilot = std::min<uint64_t>(UINT32_MAX, std::max<uint64_t>(1u << 20, uint64_t(n) * 64));
+
+    // Group key positions by bucket
+    std::vector<uint64_t> hashes(n);
+    std::vector<uint32_t> bucketStart(bucketCount + 1, 0);
+    for (uint32_t i = 0; i < n; i++) {
+        hashes[i] = Mix(keys[i] ^ seed);
+        bucketStart[Range(uint32_t(hashes[i] >> 32), bucketCount) + 1]++;
+    }
+    uint32_t largest = 0;
+    for (uint32_t b = 0; b < bucketCount; b++) {
+        largest = std::max(largest, bucketStart[b + 1]);
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    std::vector<uint32_t> members(n);
+    {
+        std::vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+        for (uint32_t i = 0; i < n; i++) members[fill[Range(uint32_t(hashes[i] >> 32), bucketCount)]++] = i;
+    }
+
+    // Largest buckets first, while the table is still mostly empty
+    std::vector<uint32_t> order(bucketCount);
+    {
+        std::vector<uint32_t> sizeStart(largest + 2, 0);
+        for (uint32_t b = 0; b < bucketCount; b++) sizeStart[largest - (bucketStart[b + 1] - bucketStart[b]) + 1]++;
+        for (uint32_t s = 0; s <= largest; s++) sizeStart[s + 1] += sizeStart[s];
+        for (uint32_t b = 0; b < bucketCount; b++) order[sizeStart[largest - (bucketStart[b + 1] - bucketStart[b])]++] = b;
+    }
+
+    m_seed = seed;
+    m_stats.maxPilot = 0;
+    m_pilots.assign(bucketCount, 0);
+    m_positions.assign(n, 0);
+    std::vector<uint8_t> taken(n, 0);
+    std::vector<uint32_t> slots(largest);
+
+    for (uint32_t bucket : order) {
+        const uint32_t begin = bucketStart[bucket];
+        const uint32_t size = bucketStart[bucket + 1] - begin;
+        if (size == 0) break;
+
+        for (uint64_t pilot = 0;; pilot++) {
+            if (pilot > maxPilot) return false;
+            m_stats.pilotTrials++;
+
+            bool placed = true;
+            for (uint32_t k = 0; k < size && placed; k++) {
+                uint32_t slot = Range(uint32_t(Mix(hashes[members[begin + k]] ^ (pilot * kPilotMultiplier))), n);
+                placed = !taken[slot] && std::find(slots.begin(), slots.begin() + k, slot) == slots.begin() + k;
+                slots[k] = slot;
+            }
+            if (!placed) continue;
+
+            for (uint32_t k = 0; k < size; k++) {
+                taken[slots[k]] = 1;
+                m_positions[slots[k]] = members[begin + k];
+            }
+            m_pilots[bucket] = static_cast<uint32_t>(pilot);
+            m_stats.maxPilot = std::max(m_stats.maxPilot, static_cast<uint32_t>(pilot));
+            break;
+        }
+    }
+    return true;
+}
+
+void C3PerfectHash::Clear() {
+    m_seed = 0;
+    m_pilots.clear();
+    m_positions.clear();
+    m_stats = {};
+}
+
+uint64_t C3PerfectHash::KeyChecksum(std::span<const uint32_t> keys) {
+    uint64_t sum = keys.size();
+    for (uint32_t key : keys) sum = Mix(sum ^ key);
+    return sum;
+}
+
+bool C3PerfectHash::Save(const std::string& path, uint64_t keyChecksum) {
+    if (!IsLoaded()) {
+        m_lastError = "No perfect hash to save";
+        return false;
+    }
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        m_lastError = "Failed to create perfect hash: " + path;
+        return false;
+    }
+
+    FileHeader header{};
+    memcpy(header.magic, "C3PH", 4);
+    header.version = kVersion;
+    header.keyCount = static_cast<uint32_t>(m_positions.size());
+    header.bucketCount = static_cast<uint32_t>(m_pilots.size());
+    header.seed = m_seed;
+    header.keyChecksum = keyChecksum;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_pilots.data()), m_pilots.size() * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(m_positions.data()), m_positions.size() * sizeof(uint32_t));
+    if (!file) {
+        m_lastError = "Failed to write perfect hash: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool C3PerfectHash::Load(const std::string& path, size_t keyCount, uint64_t keyChecksum) {
+    Clear();
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        m_lastError = "Failed to open perfect hash: " + path;
+        return false;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+
+    FileHeader header{};
+    if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        memcmp(header.magic, "C3PH", 4) != 0 || header.version != kVersion) {
+        m_lastError = "Not a perfect hash file: " + path;
+        return false;
+    }
+    if (header.keyCount != keyCount || header.keyChecksum != keyChecksum) {
+        m_lastError = "Perfect hash was built for different contents: " + path;
+        return false;
+    }
+    if (header.keyCount == 0 || header.bucketCount == 0 ||
+        fileSize != sizeof(header) + (uint64_t(header.bucketCount) + header.keyCount) * sizeof(uint32_t)) {
+        m_lastError = "Truncated perfect hash: " + path;
+        return false;
+    }
+
+    std::vector<uint32_t> pilots(header.bucketCount);
+    std::vector<uint32_t> positions(header.keyCount);
+    file.read(reinterpret_cast<char*>(pilots.data()), pilots.size() * sizeof(uint32_t));
+    file.read(reinterpret_cast<char*>(positions.data()), positions.size() * sizeof(uint32_t));
+    if (!file) {
+        m_lastError = "Failed to read perfect hash: " + path;
+        return false;
+    }
+    // Lookup() indexes with whatever it finds here, so every position must be in range
+    for (uint32_t position : positions) {
+        if (position >= header.keyCount) {
+            m_lastError = "Corrupt perfect hash: " + path;
+            return false;
+        }
+    }
+
+    m_seed = header.seed;
+    m_pilots = std::move(pilots);
+    m_positions = std::move(positions);
+    m_stats.keyCount = m_positions.size();
+    m_stats.bucketCount = m_pilots.size();
+    m_stats.bitsPerKey = 32.0 * double(m_pilots.size()) / double(m_positions.size());
+    return true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// Minimal perfect hash over a fixed set of distinct 32-bit ids (hash and
+// displace): ids are split into buckets of about four, and each bucket gets
+// the first "pilot" that sends all of its ids to free slots of a table with
+// exactly one slot per id. Each slot holds the id's position in the key
+// list it was built from, so a lookup is one hash, one pilot read and one
+// table read. Ids outside the set land on an arbitrary position, so the
+// caller must compare the id stored there.
+class C3PerfectHash {
+public:
+    struct Stats {
+        size_t keyCount = 0;
+        size_t bucketCount = 0;
+        uint32_t seedAttempts = 0; // Seeds tried before every bucket found a pilot
+        uint64_t pilotTrials = 0;  // Pilots tested across all buckets
+        uint32_t maxPilot = 0;
+        double bitsPerKey = 0.0;   // Pilots only; the position table adds 32 bits per key
+        double buildMs = 0.0;
+    };
+
+#pragma pack(push, 1)
+    struct FileHeader {
+        char magic[4]; // "C3PH"
+        uint32_t version;
+        uint32_t keyCount;
+        uint32_t bucketCount;
+        uint64_t seed;
+        uint64_t keyChecksum; // KeyChecksum() of the keys, in order
+        // uint32_t pilots[bucketCount]
+        // uint32_t positions[keyCount]
+    };
+#pragma pack(pop)
+
+    static constexpr uint32_t kVersion = 1;
+
+    // False if the keys are not distinct
+    bool Build(std::span<const uint32_t> keys);
+    void Clear();
+
+    bool IsLoaded() const { return !m_positions.empty(); }
+    size_t GetKeyCount() const { return m_positions.size(); }
+    const Stats& GetStats() const { return m_stats; }
+
+    // Position of the key in the build list; any valid position if it was not in it
+    uint32_t Lookup(uint32_t key) const {
+        const uint64_t h = Mix(key ^ m_seed);
+        const uint32_t pilot = m_pilots[Range(uint32_t(h >> 32), uint32_t(m_pilots.size()))];
+        return m_positions[Range(uint32_t(Mix(h ^ (pilot * kPilotMultiplier))), uint32_t(m_positions.size()))];
+    }
+
+    // Order-dependent digest of a key list, stored so a sidecar built for
+    // other contents can be rejected
+    static uint64_t KeyChecksum(std::span<const uint32_t> keys);
+
+    bool Save(const std::string& path, uint64_t keyChecksum);
+    // Fails unless the file was built over keyCount keys with this checksum
+    bool Load(const std::string& path, size_t keyCount, uint64_t keyChecksum);
+
+    const std::string& GetLastError() const { return m_lastError; }
+
+private:
+    static constexpr uint64_t kPilotMultiplier = 0x9E3779B97F4A7C15ULL;
+
+    static uint64_t Mix(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDULL;
+        x ^= x >> 33;
+        x *= 0xC4CEB9FE1A85EC53ULL;
+        return x ^ (x >> 33);
+    }
+
+    // Maps a uniform 32-bit value onto [0, n) without a division
+    static uint32_t Range(uint32_t x, uint32_t n) { return uint32_t((uint64_t(x) * n) >> 32); }
+
+    bool TryBuild(std::span<const uint32_t> keys, uint64_t seed);
+
+    uint64_t m_seed = 0;
+    std::vector<uint32_t> m_pilots;
+    std::vector<uint32_t> m_positions;
+    Stats m_stats;
+    std::string m_lastError;
+};
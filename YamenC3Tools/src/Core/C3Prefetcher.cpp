@@ -0,0 +1,142 @@
+#include "C3Prefetcher.h"
+#include <algorithm>
+
+C3Prefetcher::C3Prefetcher(const C3AssetResolver& resolver, size_t lookahead, unsigned workers)
+    : m_resolver(resolver), m_lookahead(std::max<size_t>(1, lookahead)), m_workerCount(std::max(1u, workers)) {
+}
+
+C3Prefetcher::~C3Prefetcher() {
+    Stop();
+}
+
+void C3Prefetcher::SetTrace(std::vector<C3AccessTrace::Entry> trace) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_trace = std::move(trace);
+    m_positions.clear();
+    for (size_t i = 0; i < m_trace.size(); i++) {
+        m_positions[KeyOf(m_trace[i])].push_back(static_cast<uint32_t>(i));
+    }
+    m_cursor = 0;
+    m_issuedEnd = 0;
+    m_pending.clear();
+    m_queue.clear();
+}
+
+void C3Prefetcher::Start() {
+    if (IsRunning()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = false;
+        QueueWindow();
+    }
+    for (unsigned i = 0; i < m_workerCount; i++) {
+        m_workers.emplace_back(&C3Prefetcher::WorkerLoop, this);
+    }
+}
+
+void C3Prefetcher::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_queue.clear();
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) worker.join();
+    m_workers.clear();
+}
+
+void C3Prefetcher::OnAccess(const C3AssetResolver::Location& location) {
+    const uint64_t key = KeyOf(location.packId, location.fileId);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.accesses++;
+
+        auto pending = m_pending.find(key);
+        if (pending == m_pending.end()) m_stats.misses++;
+        else if (pending->second.state == State::Done) m_stats.hits++;
+        else m_stats.late++;
+        if (pending != m_pending.end()) m_pending.erase(pending);
+
+        auto found = m_positions.find(key);
+        if (found == m_positions.end()) return; // Not in the trace; keep the current prediction
+        const auto& positions = found->second;
+
+        if (m_cursor < m_trace.size() && KeyOf(m_trace[m_cursor]) == key) {
+            m_cursor++;
+        }
+        else {
+            // Jump to the next occurrence after the cursor, or wrap to the first
+            auto next = std::lower_bound(positions.begin(), positions.end(), static_cast<uint32_t>(m_cursor));
+            size_t cursor = (next != positions.end() ? *next : positions.front()) + size_t(1);
+            if (cursor < m_cursor || cursor > m_issuedEnd) m_issuedEnd = cursor;
+            m_cursor = cursor;
+            m_stats.resyncs++;
+        }
+
+        // A repeat already inside the window is resident now that it has been read
+        auto repeat = std::lower_bound(positions.begin(), positions.end(), static_cast<uint32_t>(m_cursor));
+        if (repeat != positions.end() && *repeat < m_issuedEnd) {
+            m_pending[key] = Pending{ State::Done, *repeat };
+        }
+        QueueWindow();
+    }
+    m_wake.notify_all();
+}
+
+void C3Prefetcher::QueueWindow() {
+    const size_t end = std::min(m_trace.size(), m_cursor + m_lookahead);
+    for (; m_issuedEnd < end; m_issuedEnd++) {
+        uint64_t key = KeyOf(m_trace[m_issuedEnd]);
+        if (m_pending.emplace(key, Pending{ State::Queued, static_cast<uint32_t>(m_issuedEnd) }).second) {
+            m_queue.push_back(key);
+            m_stats.issued++;
+        }
+    }
+    if (m_pending.size() > 4 * m_lookahead) DropStale();
+}
+
+// Forgets prefetches the replay has already moved well past
+void C3Prefetcher::DropStale() {
+    const size_t horizon = m_cursor > m_lookahead ? m_cursor - m_lookahead : 0;
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (it->second.position < horizon) {
+            m_stats.wasted++;
+            it = m_pending.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void C3Prefetcher::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+        if (m_stopping) return;
+
+        uint64_t key = m_queue.front();
+        m_queue.pop_front();
+        if (!m_pending.count(key)) continue; // Already accessed
+
+        lock.unlock();
+        C3AssetResolver::Location loc;
+        if (m_resolver.Resolve(static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key), loc)) {
+            loc.archive->Prefetch(loc.fileId, true);
+        }
+        lock.lock();
+
+        auto pending = m_pending.find(key);
+        if (pending != m_pending.end()) pending->second.state = State::Done;
+    }
+}
+
+C3Prefetcher::Stats C3Prefetcher::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void C3Prefetcher::ResetStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats = {};
+}
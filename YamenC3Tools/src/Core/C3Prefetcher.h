@@ -0,0 +1,77 @@
+#pragma once
+#include "C3AccessTrace.h"
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+// Replays a recorded access trace ahead of the caller. Each archive hit
+// seen through the VFS advances (or resynchronizes) a cursor into the
+// trace, and the next 'lookahead' assets are faulted in by background
+// workers, so the real load finds its bytes resident.
+//
+// Stop the prefetcher before unmounting archives it may be touching.
+class C3Prefetcher : public C3VirtualFileSystem::AccessListener {
+public:
+    struct Stats {
+        uint64_t accesses = 0;
+        uint64_t hits = 0;    // Prefetched and resident before the access
+        uint64_t late = 0;    // Queued or in progress when the access came
+        uint64_t misses = 0;  // Not predicted
+        uint64_t issued = 0;  // Prefetches queued
+        uint64_t wasted = 0;  // Fell behind the cursor without being accessed
+        uint64_t resyncs = 0; // Accesses that moved the cursor off the expected entry
+
+        double HitRate() const { return accesses ? double(hits) / double(accesses) : 0.0; }
+    };
+
+    explicit C3Prefetcher(const C3AssetResolver& resolver, size_t lookahead = 64, unsigned workers = 2);
+    ~C3Prefetcher();
+
+    C3Prefetcher(const C3Prefetcher&) = delete;
+    C3Prefetcher& operator=(const C3Prefetcher&) = delete;
+
+    // Replaces the trace and rewinds the cursor; call while stopped
+    void SetTrace(std::vector<C3AccessTrace::Entry> trace);
+
+    // Starts the workers and queues the first 'lookahead' assets
+    void Start();
+    void Stop();
+    bool IsRunning() const { return !m_workers.empty(); }
+
+    void OnAccess(const C3AssetResolver::Location& location) override;
+
+    Stats GetStats() const;
+    void ResetStats();
+
+private:
+    enum class State : uint8_t { Queued, Done };
+
+    struct Pending {
+        State state = State::Queued;
+        uint32_t position = 0; // Trace position it was queued for
+    };
+
+    static uint64_t KeyOf(uint32_t packId, uint32_t fileId) { return (uint64_t(packId) << 32) | fileId; }
+    static uint64_t KeyOf(const C3AccessTrace::Entry& e) { return KeyOf(e.packId, e.fileId); }
+
+    const C3AssetResolver& m_resolver;
+    size_t m_lookahead;
+    unsigned m_workerCount;
+
+    std::vector<C3AccessTrace::Entry> m_trace;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_positions; // Key -> ascending trace positions
+    size_t m_cursor = 0;    // Next expected trace position
+    size_t m_issuedEnd = 0; // Positions before this have been queued
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::unordered_map<uint64_t, Pending> m_pending;
+    std::deque<uint64_t> m_queue;
+    std::vector<std::thread> m_workers;
+    bool m_stopping = false;
+    Stats m_stats;
+
+    void QueueWindow();
+    void DropStale();
+    void WorkerLoop();
+};
@@ -0,0 +1,118 @@
+#pragma once
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+// A vector whose copies share one allocation until one of them is written,
+// so geometry that many models load identically is held once (see
+// C3DedupStore). Const access reads the shared storage; every non-const
+// access first takes a private copy if anyone else still holds it. As with
+// any copy-on-write type, pointers and iterators obtained through non-const
+// access must not be kept across a copy of the buffer.
+template <typename T>
+class C3SharedBuffer {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+    using Storage = std::shared_ptr<const std::vector<T>>;
+
+    C3SharedBuffer() = default;
+    C3SharedBuffer(std::vector<T> values) {
+        if (!values.empty()) m_data = std::make_shared<std::vector<T>>(std::move(values));
+    }
+    C3SharedBuffer(std::initializer_list<T> values) : C3SharedBuffer(std::vector<T>(values)) {}
+    explicit C3SharedBuffer(size_t count, const T& value = T()) : C3SharedBuffer(std::vector<T>(count, value)) {}
+    template <typename It>
+    C3SharedBuffer(It first, It last) : C3SharedBuffer(std::vector<T>(first, last)) {}
+
+    const std::vector<T>& Get() const { return m_data ? *m_data : Empty(); }
+    operator const std::vector<T>&() const { return Get(); }
+
+    // The vector itself, unshared first
+    std::vector<T>& Edit() {
+        if (!m_data) {
+            m_data = std::make_shared<std::vector<T>>();
+        }
+        else if (m_data.use_count() != 1) {
+            m_data = std::make_shared<std::vector<T>>(*m_data);
+        }
+        else {
+            // Pairs with the release of the last other owner, whose reads must finish before our writes
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *m_data;
+    }
+
+    // Sharing, for interning identical content
+    Storage GetStorage() const { return m_data; }
+    void Share(Storage storage) { m_data = std::const_pointer_cast<std::vector<T>>(std::move(storage)); }
+    bool SharesWith(const C3SharedBuffer& other) const { return m_data && m_data == other.m_data; }
+
+    size_t size() const { return Get().size(); }
+    bool empty() const { return Get().empty(); }
+    size_t capacity() const { return Get().capacity(); }
+
+    const T* data() const { return Get().data(); }
+    const T& operator[](size_t i) const { return Get()[i]; }
+    const T& at(size_t i) const { return Get().at(i); }
+    const T& front() const { return Get().front(); }
+    const T& back() const { return Get().back(); }
+    const_iterator begin() const { return Get().begin(); }
+    const_iterator end() const { return Get().end(); }
+    const_iterator cbegin() const { return Get().begin(); }
+    const_iterator cend() const { return Get().end(); }
+
+    T* data() { return Edit().data(); }
+    T& operator[](size_t i) { return Edit()[i]; }
+    T& at(size_t i) { return Edit().at(i); }
+    T& front() { return Edit().front(); }
+    T& back() { return Edit().back(); }
+    iterator begin() { return Edit().begin(); }
+    iterator end() { return Edit().end(); }
+
+    void push_back(const T& value) { Edit().push_back(value); }
+    void push_back(T&& value) { Edit().push_back(std::move(value)); }
+    template <typename... Args>
+    T& emplace_back(Args&&... args) { return Edit().emplace_back(std::forward<Args>(args)...); }
+    void pop_back() { Edit().pop_back(); }
+    void resize(size_t count) { Edit().resize(count); }
+    void resize(size_t count, const T& value) { Edit().resize(count, value); }
+    void reserve(size_t count) { Edit().reserve(count); }
+    void shrink_to_fit() { if (m_data && m_data.use_count() == 1) m_data->shrink_to_fit(); }
+    void assign(size_t count, const T& value) { Edit().assign(count, value); }
+    template <typename It>
+    void assign(It first, It last) { Edit().assign(first, last); }
+    template <typename It>
+    iterator insert(const_iterator pos, It first, It last) {
+        const size_t at = static_cast<size_t>(pos - Get().begin());
+        std::vector<T>& values = Edit();
+        return values.insert(values.begin() + at, first, last);
+    }
+    iterator insert(const_iterator pos, const T& value) {
+        const size_t at = static_cast<size_t>(pos - Get().begin());
+        std::vector<T>& values = Edit();
+        return values.insert(values.begin() + at, value);
+    }
+    iterator erase(const_iterator first, const_iterator last) {
+        const size_t from = static_cast<size_t>(first - Get().begin());
+        const size_t to = static_cast<size_t>(last - Get().begin());
+        std::vector<T>& values = Edit();
+        return values.erase(values.begin() + from, values.begin() + to);
+    }
+    // Drops this copy's reference; other holders keep theirs
+    void clear() { m_data.reset(); }
+    void swap(C3SharedBuffer& other) noexcept { m_data.swap(other.m_data); }
+
+    bool operator==(const C3SharedBuffer& other) const { return m_data == other.m_data || Get() == other.Get(); }
+
+private:
+    std::shared_ptr<std::vector<T>> m_data; // Null while empty
+
+    static const std::vector<T>& Empty() {
+        static const std::vector<T> empty;
+        return empty;
+    }
+};
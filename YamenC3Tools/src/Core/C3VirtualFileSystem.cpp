@@ -0,0 +1,257 @@
+#include "C3VirtualFileSystem.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+C3VirtualFileSystem& C3VirtualFileSystem::Get() {
+    static C3VirtualFileSystem instance;
+    return instance;
+}
+
+std::string C3VirtualFileSystem::NormalizePath(const std::string& path) {
+    std::string normalized;
+    normalized.reserve(path.size());
+
+    size_t start = 0;
+    while (path.compare(start, 2, "./") == 0 || path.compare(start, 2, ".\\") == 0) start += 2;
+
+    for (size_t i = start; i < path.size(); i++) {
+        char ch = path[i];
+        if (ch >= 'A' && ch <= 'Z') {
+            normalized += static_cast<char>(ch - 'A' + 'a');
+        }
+        else if (ch == '\\') {
+            normalized += '/';
+        }
+        else {
+            normalized += ch;
+        }
+    }
+    return normalized;
+}
+
+bool C3VirtualFileSystem::AddDirectory(const std::string& root) {
+    std::error_code ec;
+    if (!fs::is_directory(root, ec)) {
+        m_lastError = "Not a directory: " + root;
+        return false;
+    }
+
+    m_directories.push_back(root);
+    ScanDirectory(root);
+    ClearNegativeCache();
+    return true;
+}
+
+void C3VirtualFileSystem::ClearDirectories() {
+    m_directories.clear();
+    {
+        std::unique_lock<std::shared_mutex> lock(m_looseMutex);
+        m_looseFiles.clear();
+    }
+    ClearNegativeCache();
+}
+
+void C3VirtualFileSystem::Rescan() {
+    {
+        std::unique_lock<std::shared_mutex> lock(m_looseMutex);
+        m_looseFiles.clear();
+    }
+    for (const auto& root : m_directories) {
+        ScanDirectory(root);
+    }
+    ClearNegativeCache();
+}
+
+void C3VirtualFileSystem::AddLooseFile(const std::string& path, const std::string& diskPath) {
+    const std::string key = NormalizePath(path);
+    {
+        std::unique_lock<std::shared_mutex> lock(m_looseMutex);
+        m_looseFiles[key] = diskPath;
+    }
+    NegativeShard& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.paths.erase(key);
+}
+
+bool C3VirtualFileSystem::RemoveLooseFile(const std::string& path) {
+    std::unique_lock<std::shared_mutex> lock(m_looseMutex);
+    return m_looseFiles.erase(NormalizePath(path)) != 0;
+}
+
+size_t C3VirtualFileSystem::GetLooseFileCount() const {
+    std::shared_lock<std::shared_mutex> lock(m_looseMutex);
+    return m_looseFiles.size();
+}
+
+void C3VirtualFileSystem::ScanDirectory(const std::string& root) {
+    std::error_code ec;
+    fs::path rootPath(root);
+    for (fs::recursive_directory_iterator it(rootPath, fs::directory_options::skip_permission_denied, ec), end;
+        it != end; it.increment(ec)) {
+        if (ec) break;
+        if (!it->is_regular_file(ec)) continue;
+
+        std::string relative = fs::relative(it->path(), rootPath, ec).generic_string();
+        if (ec || relative.empty()) continue;
+        std::unique_lock<std::shared_mutex> lock(m_looseMutex);
+        m_looseFiles[NormalizePath(relative)] = it->path().string();
+    }
+}
+
+bool C3VirtualFileSystem::MountArchive(const std::string& path, int priority) {
+    if (!m_resolver.MountFile(path, priority)) {
+        m_lastError = m_resolver.GetLastError();
+        return false;
+    }
+    ClearNegativeCache();
+    return true;
+}
+
+bool C3VirtualFileSystem::UnmountArchive(const C3Archive* archive) {
+    if (!m_resolver.Unmount(archive)) {
+        m_lastError = m_resolver.GetLastError();
+        return false;
+    }
+    ClearNegativeCache();
+    return true;
+}
+
+void C3VirtualFileSystem::AddListener(AccessListener* listener) {
+    if (listener && std::find(m_listeners.begin(), m_listeners.end(), listener) == m_listeners.end()) {
+        m_listeners.push_back(listener);
+    }
+}
+
+void C3VirtualFileSystem::RemoveListener(AccessListener* listener) {
+    m_listeners.erase(std::remove(m_listeners.begin(), m_listeners.end(), listener), m_listeners.end());
+}
+
+bool C3VirtualFileSystem::Exists(const std::string& path) {
+    std::string key = NormalizePath(path);
+    {
+        std::shared_lock<std::shared_mutex> lock(m_looseMutex);
+        if (m_looseFiles.count(key)) return true;
+    }
+    if (m_resolver.Exists(key.c_str())) return true;
+
+    std::error_code ec;
+    return fs::is_regular_file(path, ec);
+}
+
+bool C3VirtualFileSystem::Open(const std::string& path, FileData& out, std::string* error) {
+    out = FileData{};
+    std::string key = NormalizePath(path);
+
+    std::string loosePath;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_looseMutex);
+        auto loose = m_looseFiles.find(key);
+        if (loose != m_looseFiles.end()) loosePath = loose->second;
+    }
+    if (!loosePath.empty() && ReadDiskFile(loosePath, out.owned)) {
+        out.source = Source::Loose;
+        m_looseHits++;
+        return true;
+    }
+
+    // Only the indexed layers are negative-cached. The plain disk read is
+    // always tried, since files can appear there without any layer changing
+    // and a case-sensitive disk may hold paths that share one key.
+    // Absolute paths (e.g. from the file dialog) are never cached.
+    const bool cacheable = !fs::path(path).has_root_path();
+    bool knownMissing = false;
+    if (cacheable) {
+        NegativeShard& shard = ShardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        knownMissing = shard.paths.count(key) != 0;
+    }
+
+    if (knownMissing) {
+        m_negativeHits++;
+    }
+    else {
+        C3AssetResolver::Location loc;
+        if (m_resolver.Resolve(key.c_str(), loc)) {
+            bool ok = false;
+            if (loc.archive->SupportsZeroCopy()) {
+                out.view = loc.archive->GetData(loc.fileId);
+                ok = out.view.size() == loc.size;
+            }
+            else {
+                ok = loc.archive->ReadFile(loc.fileId, out.owned, error);
+            }
+            if (ok) {
+                out.source = Source::Archive;
+                m_archiveHits++;
+                for (AccessListener* listener : m_listeners) listener->OnAccess(loc);
+                return true;
+            }
+        }
+        else if (cacheable) {
+            NegativeShard& shard = ShardFor(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (shard.paths.size() >= kMaxNegativeEntries) shard.paths.clear();
+            shard.paths.insert(key);
+        }
+    }
+
+    if (ReadDiskFile(path, out.owned)) {
+        out.source = Source::Disk;
+        m_diskHits++;
+        return true;
+    }
+
+    m_misses++;
+    if (error) *error = "Failed to open file: " + path;
+    return false;
+}
+
+bool C3VirtualFileSystem::ReadFile(const std::string& path, std::vector<uint8_t>& out, std::string* error) {
+    FileData data;
+    if (!Open(path, data, error)) return false;
+
+    if (data.owned.empty()) {
+        out.assign(data.view.begin(), data.view.end());
+    }
+    else {
+        out = std::move(data.owned);
+    }
+    return true;
+}
+
+void C3VirtualFileSystem::ClearNegativeCache() {
+    for (auto& shard : m_negative) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.paths.clear();
+    }
+}
+
+C3VirtualFileSystem::Stats C3VirtualFileSystem::GetStats() const {
+    Stats stats;
+    stats.looseHits = m_looseHits;
+    stats.archiveHits = m_archiveHits;
+    stats.diskHits = m_diskHits;
+    stats.negativeHits = m_negativeHits;
+    stats.misses = m_misses;
+    return stats;
+}
+
+bool C3VirtualFileSystem::ReadDiskFile(const std::string& path, std::vector<uint8_t>& out, std::string* error) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    std::streamoff size = file.is_open() ? std::streamoff(file.tellg()) : -1;
+    if (size < 0) {
+        if (error) *error = "Failed to open file: " + path;
+        return false;
+    }
+    file.seekg(0, std::ios::beg);
+
+    out.resize(static_cast<size_t>(size));
+    if (size > 0 && !file.read(reinterpret_cast<char*>(out.data()), size)) {
+        if (error) *error = "Failed to read file: " + path;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "C3AssetResolver.h"
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+// Layered asset lookup, replacing CDnFile's disperse-file map + pack +
+// fopen chain. Loose directories override archives. Their contents are
+// indexed once when the directory is added, so an override check never
+// touches the disk. Relative paths that no loose file or archive holds go
+// into a negative cache, cleared whenever a layer is added or removed, so
+// repeated misses skip the archive probes. The direct disk read behind the
+// layers is never cached: a file created there is found on the next open.
+//
+// Lookups and reads may run on any number of threads. Adding or removing
+// layers must not overlap with them; single loose files may come and go at
+// any time through AddLooseFile/RemoveLooseFile.
+class C3VirtualFileSystem {
+public:
+    enum class Source { None, Loose, Archive, Disk };
+
+    // Uncompressed archive hits are views into the mapping; everything else owns its bytes
+    struct FileData {
+        std::span<const uint8_t> view;
+        std::vector<uint8_t> owned;
+        Source source = Source::None;
+
+        const uint8_t* Data() const { return owned.empty() ? view.data() : owned.data(); }
+        size_t Size() const { return owned.empty() ? view.size() : owned.size(); }
+    };
+
+    // Told about every archive hit, e.g. to record or predict access order.
+    // Called on the thread doing the lookup, so it must be thread-safe.
+    class AccessListener {
+    public:
+        virtual ~AccessListener() = default;
+        virtual void OnAccess(const C3AssetResolver::Location& location) = 0;
+    };
+
+    struct Stats {
+        uint64_t looseHits = 0;
+        uint64_t archiveHits = 0;
+        uint64_t diskHits = 0;     // Paths found by the direct open fallback
+        uint64_t negativeHits = 0; // Archive probes skipped by the negative cache
+        uint64_t misses = 0;       // Found nowhere, disk included
+    };
+
+    // Process-wide instance used by C3Model and the importers
+    static C3VirtualFileSystem& Get();
+
+    // Indexes every file under root. Directories added later take precedence.
+    bool AddDirectory(const std::string& root);
+    void ClearDirectories();
+    void Rescan();
+    // Maps one virtual path to a file on disk, over whatever it resolved to,
+    // and forgets that the path was missing. Safe during lookups, for file
+    // watchers tracking files that appear after the directory was indexed.
+    void AddLooseFile(const std::string& path, const std::string& diskPath);
+    bool RemoveLooseFile(const std::string& path);
+
+    bool MountArchive(const std::string& path, int priority = 0);
+    bool UnmountArchive(const C3Archive* archive);
+    C3AssetResolver& GetResolver() { return m_resolver; }
+    const C3AssetResolver& GetResolver() const { return m_resolver; }
+
+    // Listeners are part of the layer setup: do not add or remove them during lookups
+    void AddListener(AccessListener* listener);
+    void RemoveListener(AccessListener* listener);
+
+    bool Exists(const std::string& path);
+    bool Open(const std::string& path, FileData& out, std::string* error = nullptr);
+    bool ReadFile(const std::string& path, std::vector<uint8_t>& out, std::string* error = nullptr);
+
+    void ClearNegativeCache();
+    Stats GetStats() const;
+    size_t GetLooseFileCount() const;
+    const std::string& GetLastError() const { return m_lastError; }
+
+    // Lowercase, forward slashes, no leading "./"
+    static std::string NormalizePath(const std::string& path);
+    // Whole file straight from the disk, bypassing every layer
+    static bool ReadDiskFile(const std::string& path, std::vector<uint8_t>& out, std::string* error = nullptr);
+
+private:
+    static constexpr size_t kNegativeShards = 16;
+    static constexpr size_t kMaxNegativeEntries = 4096; // Per shard
+
+    // Sharded so concurrent misses on different paths do not contend
+    struct NegativeShard {
+        std::mutex mutex;
+        std::unordered_set<std::string> paths;
+    };
+
+    std::vector<std::string> m_directories;
+    mutable std::shared_mutex m_looseMutex;
+    std::unordered_map<std::string, std::string> m_looseFiles; // Normalized virtual path -> disk path
+    C3AssetResolver m_resolver;
+    std::vector<AccessListener*> m_listeners;
+
+    NegativeShard m_negative[kNegativeShards];
+
+    std::atomic<uint64_t> m_looseHits{ 0 };
+    std::atomic<uint64_t> m_archiveHits{ 0 };
+    std::atomic<uint64_t> m_diskHits{ 0 };
+    std::atomic<uint64_t> m_negativeHits{ 0 };
+    std::atomic<uint64_t> m_misses{ 0 };
+    std::string m_lastError;
+
+    NegativeShard& ShardFor(const std::string& key) { return m_negative[std::hash<std::string>{}(key) % kNegativeShards]; }
+    void ScanDirectory(const std::string& root);
+};
@@ -0,0 +1,102 @@
+#include "C3WdfArchive.h"
+#include "C3HashSystem.h"
+#include <algorithm>
+#include <cstring>
+
+bool C3WdfArchive::Open(const std::string& path) {
+    Close();
+
+    if (!m_file.Open(path)) {
+        m_lastError = m_file.GetLastError();
+        return false;
+    }
+
+    Header header{};
+    if (m_file.Size() < sizeof(Header)) {
+        Close();
+        m_lastError = "File too small for WDF header";
+        return false;
+    }
+    memcpy(&header, m_file.Data(), sizeof(Header));
+
+    if (header.number < 0) {
+        Close();
+        m_lastError = "Invalid WDF entry count";
+        return false;
+    }
+
+    uint64_t indexBytes = static_cast<uint64_t>(header.number) * sizeof(IndexEntry);
+    std::span<const uint8_t> indexData = m_file.View(header.offset, indexBytes);
+    if (header.number > 0 && indexData.empty()) {
+        Close();
+        m_lastError = "WDF index extends past end of file";
+        return false;
+    }
+
+    // Use the index in place when it is aligned and sorted, otherwise keep a sorted copy
+    const size_t count = static_cast<size_t>(header.number);
+    bool aligned = (reinterpret_cast<uintptr_t>(indexData.data()) % alignof(uint32_t)) == 0;
+    if (aligned) {
+        m_index = { reinterpret_cast<const IndexEntry*>(indexData.data()), count };
+    }
+    if (!aligned || !std::is_sorted(m_index.begin(), m_index.end(),
+        [](const IndexEntry& a, const IndexEntry& b) { return a.uid < b.uid; })) {
+        m_ownedIndex.resize(count);
+        if (count > 0) memcpy(m_ownedIndex.data(), indexData.data(), indexBytes);
+        std::sort(m_ownedIndex.begin(), m_ownedIndex.end(),
+            [](const IndexEntry& a, const IndexEntry& b) { return a.uid < b.uid; });
+        m_index = m_ownedIndex;
+    }
+
+    for (const auto& entry : m_index) {
+        if (m_file.View(entry.offset, entry.size).size() != entry.size) {
+            Close();
+            m_lastError = "WDF entry extends past end of file";
+            return false;
+        }
+    }
+
+    // The client identifies an archive by the id of the name it was opened with
+    size_t slash = path.find_last_of("/\\");
+    std::string fileName = (slash == std::string::npos) ? path : path.substr(slash + 1);
+    m_packId = C3HashSystem::RealName(fileName.c_str());
+    return true;
+}
+
+void C3WdfArchive::Close() {
+    C3Archive::Close();
+    m_index = {};
+    m_ownedIndex.clear();
+}
+
+uint32_t C3WdfArchive::PackIdFromPath(const char* path) const {
+    return C3HashSystem::PackName(path);
+}
+
+uint32_t C3WdfArchive::FileIdFromPath(const char* path) const {
+    return C3HashSystem::RealName(path);
+}
+
+C3Archive::Entry C3WdfArchive::GetEntry(size_t index) const {
+    if (index >= m_index.size()) return {};
+    const IndexEntry& e = m_index[index];
+    return { e.uid, e.offset, e.size };
+}
+
+const C3WdfArchive::IndexEntry* C3WdfArchive::FindIndex(uint32_t uid) const {
+    if (m_perfectHash.IsLoaded()) {
+        const IndexEntry& e = m_index[m_perfectHash.Lookup(uid)];
+        return e.uid == uid ? &e : nullptr;
+    }
+    auto it = std::lower_bound(m_index.begin(), m_index.end(), uid,
+        [](const IndexEntry& e, uint32_t id) { return e.uid < id; });
+    if (it == m_index.end() || it->uid != uid) return nullptr;
+    return &*it;
+}
+
+bool C3WdfArchive::Find(uint32_t fileId, Entry& out) const {
+    const IndexEntry* e = FindIndex(fileId);
+    if (!e) return false;
+    out = { e->uid, e->offset, e->size };
+    return true;
+}
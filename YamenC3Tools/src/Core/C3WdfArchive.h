@@ -0,0 +1,47 @@
+#pragma once
+#include "C3Archive.h"
+
+// WDF data file as written by the client tools: a header, the packed file
+// data and a trailing index sorted by uid. Paths resolve with
+// C3HashSystem::PackName (which archive) and RealName (which entry).
+class C3WdfArchive : public C3Archive {
+public:
+#pragma pack(push, 1)
+    struct Header {
+        uint32_t id;     // 'PFDW'; not checked by the client
+        int32_t number;  // Entry count
+        uint32_t offset; // Offset of the index
+    };
+
+    struct IndexEntry {
+        uint32_t uid;
+        uint32_t offset;
+        uint32_t size;
+        uint32_t space; // Allocated bytes, size plus padding
+    };
+#pragma pack(pop)
+
+    static constexpr uint32_t kHeaderId = 0x57444650;
+
+    bool Open(const std::string& path) override;
+    void Close() override;
+    const char* GetFormatName() const override { return "WDF"; }
+    const char* GetFileExtension() const override { return ".wdf"; }
+
+    uint32_t PackIdFromPath(const char* path) const override;
+    uint32_t FileIdFromPath(const char* path) const override;
+    const char* GetIdScheme() const override { return "WDF"; }
+
+    size_t GetEntryCount() const override { return m_index.size(); }
+    Entry GetEntry(size_t index) const override;
+    bool Find(uint32_t fileId, Entry& out) const override;
+    using C3Archive::Find;
+
+    // Through the perfect hash if one is loaded, else a binary search over the uid-sorted index
+    const IndexEntry* FindIndex(uint32_t uid) const;
+    std::span<const IndexEntry> GetIndex() const { return m_index; }
+
+private:
+    std::span<const IndexEntry> m_index; // Points into the mapping or m_ownedIndex
+    std::vector<IndexEntry> m_ownedIndex;
+};
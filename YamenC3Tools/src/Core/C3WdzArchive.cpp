@@ -0,0 +1,353 @@
+#include "C3WdzArchive.h"
+#include "C3HashSystem.h"
+#include "C3Lz.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Below this many blocks a request decodes on the calling thread
+constexpr size_t kParallelBlockThreshold = 8;
+
+template <typename T>
+std::span<const T> LoadTable(const C3MappedFile& file, uint64_t offset, size_t count, std::vector<T>& owned) {
+    std::span<const uint8_t> bytes = file.View(offset, uint64_t(count) * sizeof(T));
+    if (count > 0 && bytes.empty()) return {};
+    if (reinterpret_cast<uintptr_t>(bytes.data()) % alignof(uint32_t) == 0) {
+        return { reinterpret_cast<const T*>(bytes.data()), count };
+    }
+    owned.resize(count);
+    if (count > 0) memcpy(owned.data(), bytes.data(), bytes.size());
+    return owned;
+}
+
+// Process-wide helpers for decoding large requests, started on first use and
+// shared by every archive, so concurrent readers never add threads. The
+// calling thread always works on its own request too: when every helper is
+// busy with other readers, a request still finishes, just serially.
+class DecodePool {
+public:
+    static DecodePool& Get() {
+        static DecodePool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+
+    ~DecodePool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (auto& thread : m_threads) thread.join();
+    }
+
+    unsigned GetHelperCount() const { return static_cast<unsigned>(m_threads.size()); }
+
+    // Calls task(i) for every i below count, on the caller and up to 'helpers'
+    // pool threads; false if any call failed
+    bool Run(size_t count, unsigned helpers, const std::function<bool(size_t)>& task) {
+        auto batch = std::make_shared<Batch>();
+        batch->count = count;
+        batch->task = &task;
+        helpers = std::min(helpers, GetHelperCount());
+        if (helpers) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (unsigned i = 0; i < helpers; i++) m_queue.push_back(batch);
+            }
+            if (helpers == 1) m_wake.notify_one();
+            else m_wake.notify_all();
+        }
+
+        Work(*batch);
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        batch->finished.wait(lock, [&] { return batch->done.load() == count; });
+        return batch->ok.load();
+    }
+
+private:
+    // Helpers that reach a batch after its last item was claimed leave it at
+    // once, so 'task' is never called once Run() has returned
+    struct Batch {
+        size_t count = 0;
+        const std::function<bool(size_t)>* task = nullptr;
+        std::atomic<size_t> next{ 0 };
+        std::atomic<size_t> done{ 0 };
+        std::atomic<bool> ok{ true };
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    explicit DecodePool(unsigned threads) {
+        for (unsigned t = 0; t < threads; t++) m_threads.emplace_back([this] { Loop(); });
+    }
+
+    static void Work(Batch& batch) {
+        for (size_t i = batch.next++; i < batch.count; i = batch.next++) {
+            if (batch.ok.load(std::memory_order_relaxed) && !(*batch.task)(i)) batch.ok = false;
+            if (++batch.done == batch.count) {
+                std::lock_guard<std::mutex> lock(batch.mutex);
+                batch.finished.notify_all();
+            }
+        }
+    }
+
+    void Loop() {
+        for (;;) {
+            std::shared_ptr<Batch> batch;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+                if (m_queue.empty()) return;
+                batch = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+            Work(*batch);
+        }
+    }
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::shared_ptr<Batch>> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+};
+
+} // namespace
+
+bool C3WdzArchive::Open(const std::string& path) {
+    Close();
+
+    if (!m_file.Open(path)) {
+        m_lastError = m_file.GetLastError();
+        return false;
+    }
+
+    Header header{};
+    if (m_file.Size() < sizeof(Header)) {
+        Close();
+        m_lastError = "File too small for WDZ header";
+        return false;
+    }
+    memcpy(&header, m_file.Data(), sizeof(Header));
+
+    if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+        Close();
+        m_lastError = "Not a WDZ archive or unsupported version";
+        return false;
+    }
+    if (header.blockSize == 0) {
+        Close();
+        m_lastError = "Invalid WDZ block size";
+        return false;
+    }
+    m_blockSize = header.blockSize;
+
+    m_index = LoadTable(m_file, header.indexOffset, header.fileCount, m_ownedIndex);
+    m_blocks = LoadTable(m_file, header.blockTableOffset, header.blockCount, m_ownedBlocks);
+    if ((header.fileCount > 0 && m_index.empty()) || (header.blockCount > 0 && m_blocks.empty())) {
+        Close();
+        m_lastError = "WDZ tables extend past end of file";
+        return false;
+    }
+
+    for (const Block& b : m_blocks) {
+        if (b.rawSize > m_blockSize || b.storedSize > C3Lz::CompressBound(b.rawSize) ||
+            m_file.View(b.offset, b.storedSize).size() != b.storedSize) {
+            Close();
+            m_lastError = "Corrupt WDZ block table";
+            return false;
+        }
+        m_rawBytes += b.rawSize;
+        m_storedBytes += b.storedSize;
+    }
+
+    for (size_t i = 0; i < m_index.size(); i++) {
+        const IndexEntry& e = m_index[i];
+        uint64_t expectedBlocks = (uint64_t(e.size) + m_blockSize - 1) / m_blockSize;
+        if (e.blockCount != expectedBlocks || uint64_t(e.firstBlock) + e.blockCount > m_blocks.size() ||
+            (i > 0 && m_index[i - 1].uid >= e.uid)) {
+            Close();
+            m_lastError = "Corrupt WDZ index";
+            return false;
+        }
+        // Blocks decode straight into their slice of the file, so each must fill it exactly
+        for (uint32_t b = 0; b < e.blockCount; b++) {
+            uint64_t expectedRaw = std::min<uint64_t>(m_blockSize, uint64_t(e.size) - uint64_t(b) * m_blockSize);
+            if (m_blocks[e.firstBlock + b].rawSize != expectedRaw) {
+                Close();
+                m_lastError = "Corrupt WDZ index: block size does not match entry";
+                return false;
+            }
+        }
+    }
+
+    // Same pack id as the uncompressed archive it replaces
+    size_t slash = path.find_last_of("/\\");
+    std::string fileName = (slash == std::string::npos) ? path : path.substr(slash + 1);
+    size_t dot = fileName.find_last_of('.');
+    if (dot != std::string::npos) fileName.resize(dot);
+    m_packId = C3HashSystem::RealName((fileName + ".wdf").c_str());
+    return true;
+}
+
+void C3WdzArchive::Close() {
+    C3Archive::Close();
+    m_index = {};
+    m_blocks = {};
+    m_ownedIndex.clear();
+    m_ownedBlocks.clear();
+    m_blockSize = 0;
+    m_rawBytes = 0;
+    m_storedBytes = 0;
+}
+
+uint32_t C3WdzArchive::PackIdFromPath(const char* path) const {
+    return C3HashSystem::PackName(path);
+}
+
+uint32_t C3WdzArchive::FileIdFromPath(const char* path) const {
+    return C3HashSystem::RealName(path);
+}
+
+C3Archive::Entry C3WdzArchive::GetEntry(size_t index) const {
+    if (index >= m_index.size()) return {};
+    const IndexEntry& e = m_index[index];
+    return { e.uid, e.blockCount ? m_blocks[e.firstBlock].offset : 0, e.size };
+}
+
+const C3WdzArchive::IndexEntry* C3WdzArchive::FindIndex(uint32_t uid) const {
+    if (m_perfectHash.IsLoaded()) {
+        const IndexEntry& e = m_index[m_perfectHash.Lookup(uid)];
+        return e.uid == uid ? &e : nullptr;
+    }
+    auto it = std::lower_bound(m_index.begin(), m_index.end(), uid,
+        [](const IndexEntry& e, uint32_t id) { return e.uid < id; });
+    if (it == m_index.end() || it->uid != uid) return nullptr;
+    return &*it;
+}
+
+bool C3WdzArchive::Find(uint32_t fileId, Entry& out) const {
+    const IndexEntry* e = FindIndex(fileId);
+    if (!e) return false;
+    out = { e->uid, e->blockCount ? m_blocks[e->firstBlock].offset : 0, e->size };
+    return true;
+}
+
+bool C3WdzArchive::DecodeBlock(uint32_t block, uint8_t* dst) const {
+    const Block& b = m_blocks[block];
+    std::span<const uint8_t> stored = m_file.View(b.offset, b.storedSize);
+    if (b.storedSize == b.rawSize) {
+        memcpy(dst, stored.data(), b.rawSize);
+        return true;
+    }
+    return C3Lz::Decompress(stored.data(), stored.size(), dst, b.rawSize);
+}
+
+bool C3WdzArchive::RunJobs(std::vector<BlockJob>& jobs) const {
+    auto runJob = [this](BlockJob& job) {
+        if (!DecodeBlock(job.block, job.dst)) return false;
+        if (job.copyDst) memcpy(job.copyDst, job.dst + job.copyOffset, job.copySize);
+        return true;
+    };
+
+    unsigned threads = m_decodeThreads ? m_decodeThreads : DecodePool::Get().GetHelperCount() + 1;
+    threads = static_cast<unsigned>(std::min<size_t>(threads, jobs.size()));
+    if (threads <= 1 || jobs.size() < kParallelBlockThreshold) {
+        for (auto& job : jobs) {
+            if (!runJob(job)) return false;
+        }
+        return true;
+    }
+
+    // Blocks are independent, so the pool just hands out indices
+    return DecodePool::Get().Run(jobs.size(), threads - 1, [&](size_t i) { return runJob(jobs[i]); });
+}
+
+bool C3WdzArchive::ReadFile(uint32_t fileId, std::vector<uint8_t>& out, std::string* error) const {
+    const IndexEntry* e = FindIndex(fileId);
+    if (!e) {
+        if (error) *error = "File not found in archive";
+        return false;
+    }
+
+    out.resize(e->size);
+    std::vector<BlockJob> jobs(e->blockCount);
+    for (uint32_t i = 0; i < e->blockCount; i++) {
+        jobs[i] = { e->firstBlock + i, out.data() + size_t(i) * m_blockSize, 0, 0, nullptr };
+    }
+
+    if (!RunJobs(jobs)) {
+        if (error) *error = "Corrupt compressed block";
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+bool C3WdzArchive::ReadRange(uint32_t fileId, uint64_t offset, void* dst, size_t size, std::string* error) const {
+    const IndexEntry* e = FindIndex(fileId);
+    if (!e) {
+        if (error) *error = "File not found in archive";
+        return false;
+    }
+    if (offset > e->size || size > e->size - offset) {
+        if (error) *error = "Read past end of archive entry";
+        return false;
+    }
+    if (size == 0) return true;
+
+    const uint32_t first = static_cast<uint32_t>(offset / m_blockSize);
+    const uint32_t last = static_cast<uint32_t>((offset + size - 1) / m_blockSize);
+    uint8_t* out = static_cast<uint8_t*>(dst);
+
+    // Fully covered blocks decode in place; the partial ends go through scratch buffers
+    std::vector<uint8_t> scratch(size_t(std::min<uint32_t>(2, last - first + 1)) * m_blockSize);
+    std::vector<BlockJob> jobs;
+    jobs.reserve(last - first + 1);
+    size_t scratchUsed = 0;
+
+    for (uint32_t b = first; b <= last; b++) {
+        uint64_t blockStart = uint64_t(b) * m_blockSize;
+        uint64_t blockEnd = std::min<uint64_t>(blockStart + m_blockSize, e->size);
+        uint64_t copyStart = std::max(blockStart, offset);
+        uint64_t copyEnd = std::min(blockEnd, offset + size);
+        uint8_t* target = out + (copyStart - offset);
+
+        if (copyStart == blockStart && copyEnd == blockEnd) {
+            jobs.push_back({ e->firstBlock + b, target, 0, 0, nullptr });
+        }
+        else {
+            jobs.push_back({ e->firstBlock + b, scratch.data() + scratchUsed, size_t(copyStart - blockStart),
+                size_t(copyEnd - copyStart), target });
+            scratchUsed += m_blockSize;
+        }
+    }
+
+    if (!RunJobs(jobs)) {
+        if (error) *error = "Corrupt compressed block";
+        return false;
+    }
+    return true;
+}
+
+bool C3WdzArchive::Prefetch(uint32_t fileId, bool blocking) const {
+    const IndexEntry* e = FindIndex(fileId);
+    if (!e) return false;
+    if (e->blockCount == 0) return true;
+
+    // A file's blocks are stored back to back
+    uint64_t begin = UINT64_MAX, end = 0;
+    for (uint32_t b = e->firstBlock; b < e->firstBlock + e->blockCount; b++) {
+        begin = std::min<uint64_t>(begin, m_blocks[b].offset);
+        end = std::max<uint64_t>(end, m_blocks[b].offset + m_blocks[b].storedSize);
+    }
+    return PrefetchStored(begin, end - begin, blocking);
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "C3Archive.h"
+
+// Block-compressed variant of WDF. Each file is cut into fixed-size blocks
+// that are compressed independently with C3Lz, and a per-file block table
+// lets range reads decode only the blocks they touch. Paths resolve exactly
+// as in the matching .wdf (PackName/RealName), so a WDZ can stand in for it.
+class C3WdzArchive : public C3Archive {
+public:
+#pragma pack(push, 1)
+    struct Header {
+        char magic[4];             // "WDZ1"
+        uint32_t version;
+        uint32_t blockSize;        // Uncompressed bytes per block
+        uint32_t fileCount;
+        uint32_t blockCount;
+        uint32_t reserved;
+        uint64_t indexOffset;      // IndexEntry[fileCount], sorted by uid
+        uint64_t blockTableOffset; // Block[blockCount]
+    };
+
+    struct IndexEntry {
+        uint32_t uid;
+        uint32_t size;       // Uncompressed size
+        uint32_t firstBlock;
+        uint32_t blockCount;
+    };
+
+    struct Block {
+        uint64_t offset;
+        uint32_t storedSize; // Equal to rawSize when the block is stored uncompressed
+        uint32_t rawSize;
+    };
+#pragma pack(pop)
+
+    static constexpr char kMagic[4] = { 'W', 'D', 'Z', '1' };
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kDefaultBlockSize = 64 * 1024;
+
+    bool Open(const std::string& path) override;
+    void Close() override;
+    const char* GetFormatName() const override { return "WDZ"; }
+    const char* GetFileExtension() const override { return ".wdz"; }
+    bool SupportsZeroCopy() const override { return false; }
+
+    uint32_t PackIdFromPath(const char* path) const override;
+    uint32_t FileIdFromPath(const char* path) const override;
+    const char* GetIdScheme() const override { return "WDF"; }
+
+    size_t GetEntryCount() const override { return m_index.size(); }
+    Entry GetEntry(size_t index) const override;
+    bool Find(uint32_t fileId, Entry& out) const override;
+    using C3Archive::Find;
+
+    // Decompresses the whole file; large files decode their blocks in parallel
+    bool ReadFile(uint32_t fileId, std::vector<uint8_t>& out, std::string* error = nullptr) const override;
+    using C3Archive::ReadFile;
+    // Decodes only the blocks overlapping [offset, offset + size)
+    bool ReadRange(uint32_t fileId, uint64_t offset, void* dst, size_t size, std::string* error = nullptr) const override;
+    // Prefetches the compressed blocks; decoding still happens on read
+    bool Prefetch(uint32_t fileId, bool blocking = false) const override;
+
+    const IndexEntry* FindIndex(uint32_t uid) const;
+    uint32_t GetBlockSize() const { return m_blockSize; }
+    uint64_t GetRawBytes() const { return m_rawBytes; }
+    uint64_t GetStoredBytes() const { return m_storedBytes; }
+
+    // Threads used to decode one request, the caller included; helpers come
+    // from a process-wide pool sized to the machine. 0 = all of them, 1 = serial
+    void SetDecodeThreads(unsigned threads) { m_decodeThreads = threads; }
+
+private:
+    struct BlockJob {
+        uint32_t block;
+        uint8_t* dst;      // Receives the whole decoded block
+        size_t copyOffset; // Partial blocks: bytes to skip in the decoded block
+        size_t copySize;
+        uint8_t* copyDst;  // Partial blocks: final destination, nullptr otherwise
+    };
+
+    std::span<const IndexEntry> m_index;
+    std::span<const Block> m_blocks;
+    std::vector<IndexEntry> m_ownedIndex;
+    std::vector<Block> m_ownedBlocks;
+    uint32_t m_blockSize = 0;
+    uint64_t m_rawBytes = 0;
+    uint64_t m_storedBytes = 0;
+    unsigned m_decodeThreads = 0;
+
+    bool DecodeBlock(uint32_t block, uint8_t* dst) const;
+    bool RunJobs(std::vector<BlockJob>& jobs) const;
+};
@@ -0,0 +1,439 @@
+#include "C3ArchivePacker.h"
+#include "../Core/C3DnpArchive.h"
+#include "../Core/C3HashSystem.h"
+#include "../Core/C3Lz.h"
+#include "../Core/C3VirtualFileSystem.h"
+#include "../Core/C3WdfArchive.h"
+#include "../Core/C3WdzArchive.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+uint64_t AlignUp(uint64_t value, uint32_t alignment) {
+    if (alignment <= 1) return value;
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool CopyFileData(std::ofstream& out, const std::string& path, uint64_t size, std::vector<char>& buffer) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    while (size > 0) {
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(size, buffer.size()));
+        in.read(buffer.data(), chunk);
+        if (static_cast<size_t>(in.gcount()) != chunk) return false;
+        out.write(buffer.data(), chunk);
+        size -= chunk;
+    }
+    return true;
+}
+
+void WritePadding(std::ofstream& out, uint64_t count) {
+    static const char zeros[4096] = {};
+    while (count > 0) {
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(count, sizeof(zeros)));
+        out.write(zeros, chunk);
+        count -= chunk;
+    }
+}
+
+} // namespace
+
+bool C3ArchivePacker::AddDirectory(const std::string& root, const std::string& prefix) {
+    std::error_code ec;
+    fs::path rootPath(root);
+    if (!fs::is_directory(rootPath, ec)) {
+        m_lastError = "Not a directory: " + root;
+        return false;
+    }
+
+    for (fs::recursive_directory_iterator it(rootPath, fs::directory_options::skip_permission_denied, ec), end;
+        it != end; it.increment(ec)) {
+        if (ec) break;
+        if (!it->is_regular_file(ec)) continue;
+
+        std::string relative = fs::relative(it->path(), rootPath, ec).generic_string();
+        if (ec || relative.empty()) continue;
+        AddFile(prefix + relative, it->path().string());
+    }
+
+    if (ec) {
+        m_lastError = "Failed to scan directory: " + ec.message();
+        return false;
+    }
+    return true;
+}
+
+void C3ArchivePacker::AddFile(const std::string& virtualPath, const std::string& diskPath) {
+    File file;
+    file.virtualPath = C3VirtualFileSystem::NormalizePath(virtualPath);
+    file.diskPath = diskPath;
+    m_files.push_back(std::move(file));
+}
+
+void C3ArchivePacker::HashFiles(Format format, unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(1, m_files.size() / 256)));
+
+    auto hashRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            File& f = m_files[i];
+            f.id = (format == Format::DNP) ? C3HashSystem::DnpRealName(f.virtualPath.c_str())
+                                           : C3HashSystem::RealName(f.virtualPath.c_str());
+            std::error_code ec;
+            f.size = fs::file_size(f.diskPath, ec);
+            if (ec) f.size = UINT64_MAX;
+        }
+    };
+
+    if (threads <= 1) {
+        hashRange(0, m_files.size());
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    size_t perThread = (m_files.size() + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; t++) {
+        size_t begin = t * perThread;
+        size_t end = std::min(m_files.size(), begin + perThread);
+        if (begin >= end) break;
+        workers.emplace_back(hashRange, begin, end);
+    }
+    for (auto& w : workers) w.join();
+}
+
+bool C3ArchivePacker::DetectCollisions() {
+    m_collisions.clear();
+
+    std::vector<uint32_t> byId(m_files.size());
+    for (uint32_t i = 0; i < byId.size(); i++) byId[i] = i;
+    std::sort(byId.begin(), byId.end(), [&](uint32_t a, uint32_t b) {
+        return m_files[a].id != m_files[b].id ? m_files[a].id < m_files[b].id : a < b;
+    });
+
+    // The same virtual path added twice keeps the last one; different paths sharing an id is a collision
+    std::vector<uint8_t> dropped(m_files.size(), 0);
+    for (size_t i = 1; i < byId.size(); i++) {
+        const File& a = m_files[byId[i - 1]];
+        const File& b = m_files[byId[i]];
+        if (a.id != b.id) continue;
+        if (a.virtualPath == b.virtualPath) {
+            dropped[byId[i - 1]] = 1;
+        }
+        else {
+            m_collisions.push_back({ a.id, a.virtualPath, b.virtualPath });
+        }
+    }
+
+    size_t write = 0;
+    for (size_t i = 0; i < m_files.size(); i++) {
+        if (dropped[i]) continue;
+        if (write != i) m_files[write] = std::move(m_files[i]);
+        write++;
+    }
+    m_files.resize(write);
+    return m_collisions.empty();
+}
+
+void C3ArchivePacker::ApplyLayout(const Options& options) {
+    std::unordered_map<std::string, size_t> rank;
+    for (size_t i = 0; i < options.order.size(); i++) {
+        rank.emplace(C3VirtualFileSystem::NormalizePath(options.order[i]), i);
+    }
+
+    // Traced files first in trace order, then the rest grouped by directory
+    std::vector<size_t> keys(m_files.size());
+    m_stats.orderedFiles = 0;
+    for (size_t i = 0; i < m_files.size(); i++) {
+        auto it = rank.find(m_files[i].virtualPath);
+        keys[i] = (it != rank.end()) ? it->second : SIZE_MAX;
+        if (it != rank.end()) m_stats.orderedFiles++;
+    }
+
+    std::vector<size_t> order(m_files.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (keys[a] != keys[b]) return keys[a] < keys[b];
+        return m_files[a].virtualPath < m_files[b].virtualPath;
+    });
+
+    std::vector<File> sorted;
+    sorted.reserve(m_files.size());
+    for (size_t i : order) sorted.push_back(std::move(m_files[i]));
+    m_files = std::move(sorted);
+}
+
+bool C3ArchivePacker::Write(const std::string& outputPath, const Options& options) {
+    m_stats = Stats{};
+    if (m_files.empty()) {
+        m_lastError = "No files to pack";
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    HashFiles(options.format, options.threads);
+    m_stats.hashMs = ElapsedMs(start);
+
+    for (const File& f : m_files) {
+        if (f.size == UINT64_MAX) {
+            m_lastError = "Failed to read file: " + f.diskPath;
+            return false;
+        }
+        if (f.size > UINT32_MAX) {
+            m_lastError = "File too large for archive: " + f.diskPath;
+            return false;
+        }
+    }
+
+    if (!DetectCollisions()) {
+        m_lastError = std::to_string(m_collisions.size()) + " id collision(s), first: " +
+            m_collisions[0].first + " / " + m_collisions[0].second;
+        return false;
+    }
+
+    // Every entry must be reachable through the pack id the readers derive from the file name
+    std::string archiveName = fs::path(outputPath).filename().string();
+    std::transform(archiveName.begin(), archiveName.end(), archiveName.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    std::string stem = archiveName.substr(0, archiveName.find_last_of('.'));
+    uint32_t packId = 0;
+    if (options.format == Format::WDF) {
+        packId = C3HashSystem::RealName(archiveName.c_str());
+    }
+    else if (options.format == Format::WDZ) {
+        packId = C3HashSystem::RealName((stem + ".wdf").c_str());
+    }
+    else {
+        packId = C3HashSystem::StringToID(stem.c_str());
+    }
+    for (const File& f : m_files) {
+        uint32_t filePack = (options.format == Format::DNP) ? C3HashSystem::DnpPackName(f.virtualPath.c_str())
+                                                            : C3HashSystem::PackName(f.virtualPath.c_str());
+        if (filePack != packId) {
+            m_lastError = "Path does not belong to " + archiveName + ": " + f.virtualPath;
+            return false;
+        }
+    }
+
+    ApplyLayout(options);
+
+    if (options.format == Format::WDZ) {
+        return WriteCompressed(outputPath, options);
+    }
+
+    start = std::chrono::steady_clock::now();
+
+    // Assign offsets: WDF puts data right after its header, DNP after header and index
+    uint64_t cursor = (options.format == Format::WDF)
+        ? sizeof(C3WdfArchive::Header)
+        : sizeof(C3DnpArchive::Header) + m_files.size() * sizeof(C3DnpArchive::IndexEntry);
+    cursor = AlignUp(cursor, options.alignment);
+    const uint64_t dataStart = cursor;
+    for (File& f : m_files) {
+        f.offset = cursor;
+        uint64_t next = AlignUp(cursor + f.size, options.alignment);
+        f.space = next - cursor;
+        m_stats.dataBytes += f.size;
+        m_stats.paddingBytes += f.space - f.size;
+        cursor = next;
+    }
+    if (cursor > UINT32_MAX) {
+        m_lastError = "Archive exceeds 4 GB";
+        return false;
+    }
+
+    std::ofstream out(outputPath, std::ios::binary);
+    if (!out.is_open()) {
+        m_lastError = "Failed to create file: " + outputPath;
+        return false;
+    }
+
+    std::vector<const File*> byId(m_files.size());
+    for (size_t i = 0; i < m_files.size(); i++) byId[i] = &m_files[i];
+    std::sort(byId.begin(), byId.end(), [](const File* a, const File* b) { return a->id < b->id; });
+
+    if (options.format == Format::WDF) {
+        C3WdfArchive::Header header{ C3WdfArchive::kHeaderId, static_cast<int32_t>(m_files.size()),
+            static_cast<uint32_t>(cursor) };
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    else {
+        C3DnpArchive::Header header{};
+        strncpy(header.tag, C3DnpArchive::kTag, sizeof(header.tag));
+        header.version = C3DnpArchive::kVersion;
+        header.count = static_cast<uint32_t>(m_files.size());
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (const File* f : byId) {
+            C3DnpArchive::IndexEntry entry{ f->id, static_cast<uint32_t>(f->size), static_cast<uint32_t>(f->offset) };
+            out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        }
+    }
+    WritePadding(out, dataStart - static_cast<uint64_t>(out.tellp()));
+
+    std::vector<char> buffer(1 << 20);
+    for (const File& f : m_files) {
+        if (!CopyFileData(out, f.diskPath, f.size, buffer)) {
+            m_lastError = "Failed to read file: " + f.diskPath;
+            return false;
+        }
+        WritePadding(out, f.space - f.size);
+    }
+
+    // WDF keeps its uid-sorted index at the end
+    if (options.format == Format::WDF) {
+        for (const File* f : byId) {
+            C3WdfArchive::IndexEntry entry{ f->id, static_cast<uint32_t>(f->offset),
+                static_cast<uint32_t>(f->size), static_cast<uint32_t>(f->space) };
+            out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        }
+    }
+
+    if (!out) {
+        m_lastError = "Failed to write archive: " + outputPath;
+        return false;
+    }
+
+    m_stats.fileCount = m_files.size();
+    m_stats.storedBytes = m_stats.dataBytes;
+    m_stats.writeMs = ElapsedMs(start);
+    return true;
+}
+
+bool C3ArchivePacker::WriteCompressed(const std::string& outputPath, const Options& options) {
+    auto start = std::chrono::steady_clock::now();
+    const uint32_t blockSize = options.blockSize ? options.blockSize : C3WdzArchive::kDefaultBlockSize;
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    std::ofstream out(outputPath, std::ios::binary);
+    if (!out.is_open()) {
+        m_lastError = "Failed to create file: " + outputPath;
+        return false;
+    }
+
+    C3WdzArchive::Header header{};
+    memcpy(header.magic, C3WdzArchive::kMagic, sizeof(header.magic));
+    header.version = C3WdzArchive::kVersion;
+    header.blockSize = blockSize;
+    header.fileCount = static_cast<uint32_t>(m_files.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    struct BlockJob {
+        const uint8_t* src;
+        uint32_t size;
+    };
+
+    std::vector<C3WdzArchive::Block> blocks;
+    std::vector<C3WdzArchive::IndexEntry> index;
+    index.reserve(m_files.size());
+    std::vector<uint8_t> input;
+    std::vector<size_t> inputOffsets;
+    std::vector<BlockJob> jobs;
+    std::vector<std::vector<uint8_t>> compressed;
+    uint64_t cursor = sizeof(header);
+
+    // Whole files are read in ~64 MB batches whose blocks compress in parallel
+    constexpr uint64_t kBatchBytes = 64ull << 20;
+    size_t batchBegin = 0;
+    while (batchBegin < m_files.size()) {
+        size_t batchEnd = batchBegin;
+        input.clear();
+        inputOffsets.clear();
+        while (batchEnd < m_files.size() && (batchEnd == batchBegin || input.size() + m_files[batchEnd].size <= kBatchBytes)) {
+            const File& f = m_files[batchEnd];
+            inputOffsets.push_back(input.size());
+            input.resize(input.size() + f.size);
+
+            std::ifstream in(f.diskPath, std::ios::binary);
+            in.read(reinterpret_cast<char*>(input.data() + inputOffsets.back()), static_cast<std::streamsize>(f.size));
+            if (!in.is_open() || static_cast<uint64_t>(in.gcount()) != f.size) {
+                m_lastError = "Failed to read file: " + f.diskPath;
+                return false;
+            }
+            batchEnd++;
+        }
+
+        jobs.clear();
+        for (size_t i = batchBegin; i < batchEnd; i++) {
+            const uint8_t* data = input.data() + inputOffsets[i - batchBegin];
+            for (uint64_t pos = 0; pos < m_files[i].size; pos += blockSize) {
+                jobs.push_back({ data + pos, static_cast<uint32_t>(std::min<uint64_t>(blockSize, m_files[i].size - pos)) });
+            }
+        }
+
+        compressed.assign(jobs.size(), {});
+        std::atomic<size_t> next{ 0 };
+        auto worker = [&]() {
+            for (size_t j = next++; j < jobs.size(); j = next++) {
+                C3Lz::Compress(jobs[j].src, jobs[j].size, compressed[j]);
+                if (compressed[j].size() >= jobs[j].size) compressed[j].clear(); // Store raw
+            }
+        };
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < std::min<size_t>(threads, jobs.size()); t++) pool.emplace_back(worker);
+        worker();
+        for (auto& t : pool) t.join();
+
+        size_t job = 0;
+        for (size_t i = batchBegin; i < batchEnd; i++) {
+            File& f = m_files[i];
+            uint64_t aligned = AlignUp(cursor, options.alignment);
+            WritePadding(out, aligned - cursor);
+            m_stats.paddingBytes += aligned - cursor;
+            cursor = aligned;
+
+            f.offset = cursor;
+            C3WdzArchive::IndexEntry entry{ f.id, static_cast<uint32_t>(f.size),
+                static_cast<uint32_t>(blocks.size()), 0 };
+            for (uint64_t pos = 0; pos < f.size; pos += blockSize, job++) {
+                const bool raw = compressed[job].empty();
+                const uint8_t* data = raw ? jobs[job].src : compressed[job].data();
+                uint32_t stored = raw ? jobs[job].size : static_cast<uint32_t>(compressed[job].size());
+
+                out.write(reinterpret_cast<const char*>(data), stored);
+                blocks.push_back({ cursor, stored, jobs[job].size });
+                cursor += stored;
+                entry.blockCount++;
+                m_stats.storedBytes += stored;
+            }
+            m_stats.dataBytes += f.size;
+            index.push_back(entry);
+        }
+
+        batchBegin = batchEnd;
+    }
+
+    header.blockCount = static_cast<uint32_t>(blocks.size());
+    header.blockTableOffset = cursor;
+    out.write(reinterpret_cast<const char*>(blocks.data()), blocks.size() * sizeof(C3WdzArchive::Block));
+    header.indexOffset = cursor + blocks.size() * sizeof(C3WdzArchive::Block);
+
+    std::sort(index.begin(), index.end(),
+        [](const C3WdzArchive::IndexEntry& a, const C3WdzArchive::IndexEntry& b) { return a.uid < b.uid; });
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(C3WdzArchive::IndexEntry));
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if (!out) {
+        m_lastError = "Failed to write archive: " + outputPath;
+        return false;
+    }
+
+    m_stats.fileCount = m_files.size();
+    m_stats.writeMs = ElapsedMs(start);
+    return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Builds WDF, DNP or block-compressed WDZ archives from loose files. Ids are computed on all
+// cores with the same C3HashSystem functions the readers use, and id
+// collisions are reported instead of silently shadowing a file. File data
+// is laid out in a caller-supplied order (e.g. a recorded load trace) with
+// the remaining files grouped by directory, optionally page aligned.
+class C3ArchivePacker {
+public:
+    enum class Format { WDF, DNP, WDZ };
+
+    struct Options {
+        Format format = Format::WDF;
+        std::vector<std::string> order; // Virtual paths to place first, in this order
+        uint32_t alignment = 0;         // Align each file's data, e.g. 4096; 0 packs tightly
+        unsigned threads = 0;           // Hashing and compression threads, 0 = hardware concurrency
+        uint32_t blockSize = 0;         // WDZ only: uncompressed block size, 0 = 64 KB
+    };
+
+    struct Collision {
+        uint32_t id;
+        std::string first;
+        std::string second;
+    };
+
+    struct Stats {
+        size_t fileCount = 0;
+        uint64_t dataBytes = 0;
+        uint64_t paddingBytes = 0;
+        uint64_t storedBytes = 0; // Data bytes as written; below dataBytes when compressed
+        size_t orderedFiles = 0; // Files placed from Options::order
+        double hashMs = 0.0;
+        double writeMs = 0.0;
+    };
+
+    // Adds every file under root as prefix + relative path (e.g. prefix "c3/")
+    bool AddDirectory(const std::string& root, const std::string& prefix = "");
+    void AddFile(const std::string& virtualPath, const std::string& diskPath);
+    void Clear() { m_files.clear(); }
+
+    bool Write(const std::string& outputPath, const Options& options);
+
+    size_t GetFileCount() const { return m_files.size(); }
+    const std::vector<Collision>& GetCollisions() const { return m_collisions; }
+    const Stats& GetStats() const { return m_stats; }
+    const std::string& GetLastError() const { return m_lastError; }
+
+private:
+    struct File {
+        std::string virtualPath; // Normalized: lowercase, forward slashes
+        std::string diskPath;
+        uint32_t id = 0;
+        uint64_t size = 0;
+        uint64_t offset = 0;
+        uint64_t space = 0;
+    };
+
+    std::vector<File> m_files;
+    std::vector<Collision> m_collisions;
+    Stats m_stats;
+    std::string m_lastError;
+
+    void HashFiles(Format format, unsigned threads);
+    bool DetectCollisions();
+    void ApplyLayout(const Options& options);
+    bool WriteCompressed(const std::string& outputPath, const Options& options);
+};
@@ -10,6 +10,7 @@ public:
         bool exportNormals = true;
         bool exportTexCoords = true;
         bool embedBinary = false;
+        bool exportLODs = true;
         std::string outputPath;
     };
 
@@ -62,10 +62,76 @@ bool C3ToGLTF::Export(const C3Model& model, const ExportOptions& options) {
     gltf["accessors"] = json::array();
     gltf["meshes"] = json::array();
 
-    int accessorIdx = 0;
-
     // Export first mesh (multi-mesh support can be added later)
     const auto& mesh = meshes[0];
+    if (!ExportMesh(mesh, bufferData, options, &gltf)) {
+        return false;
+    }
+
+    // Nodes and scene
+    gltf["nodes"] = json::array({
+        {{"name", "C3Model"}, {"mesh", 0}}
+        });
+
+    // LOD levels become extra nodes referenced through MSFT_lod (highest detail first)
+    if (options.exportLODs && !mesh.lods.empty()) {
+        json lodIds = json::array();
+        for (const auto& lod : mesh.lods) {
+            if (!ExportMesh(lod, bufferData, options, &gltf)) {
+                return false;
+            }
+            gltf["nodes"].push_back({ {"name", lod.name}, {"mesh", gltf["meshes"].size() - 1} });
+            lodIds.push_back(gltf["nodes"].size() - 1);
+        }
+        gltf["nodes"][0]["extensions"] = { {"MSFT_lod", {{"ids", lodIds}}} };
+        gltf["extensionsUsed"] = json::array({ "MSFT_lod" });
+    }
+
+    gltf["scenes"] = json::array({
+        {{"name", "Scene"}, {"nodes", json::array({0})}}
+        });
+    gltf["scene"] = 0;
+
+    // Determine output paths
+    std::filesystem::path outputPath(options.outputPath);
+    std::string basePath = outputPath.parent_path().string() + "/" + outputPath.stem().string();
+    std::string binPath = basePath + ".bin";
+    std::string gltfPath = basePath + ".gltf";
+
+    // Write binary file
+    std::ofstream binFile(binPath, std::ios::binary);
+    if (!binFile) {
+        m_lastError = "Failed to create .bin file";
+        return false;
+    }
+    binFile.write(reinterpret_cast<const char*>(bufferData.data.data()), bufferData.data.size());
+    binFile.close();
+
+    // Write glTF JSON
+    std::string binFilename = std::filesystem::path(binPath).filename().string();
+    gltf["buffers"] = json::array({
+        {{"byteLength", bufferData.data.size()}, {"uri", binFilename}}
+        });
+
+    std::ofstream gltfFile(gltfPath);
+    if (!gltfFile) {
+        m_lastError = "Failed to create .gltf file";
+        return false;
+    }
+    gltfFile << gltf.dump(2);
+    gltfFile.close();
+
+    return true;
+}
+
+bool C3ToGLTF::ExportMesh(const C3Model::MeshPart& mesh, BufferData& buffer,
+    const ExportOptions& opts, void* jsonMesh) {
+    json& gltf = *static_cast<json*>(jsonMesh);
+
+    if (mesh.vertices.empty()) {
+        m_lastError = "Mesh has no vertices: " + mesh.name;
+        return false;
+    }
 
     // Calculate bounds
     XMFLOAT3 minPos{ FLT_MAX, FLT_MAX, FLT_MAX };
@@ -81,12 +147,12 @@ bool C3ToGLTF::Export(const C3Model& model, const ExportOptions& options) {
     }
 
     // Write position data (base morph target)
-    size_t posOffset = bufferData.data.size();
+    size_t posOffset = buffer.data.size();
     for (const auto& v : mesh.vertices) {
-        bufferData.WriteFloat3(v.positions[0]);
+        buffer.WriteFloat3(v.positions[0]);
     }
-    bufferData.Align4();
-    size_t posSize = bufferData.data.size() - posOffset;
+    buffer.Align4();
+    size_t posSize = buffer.data.size() - posOffset;
 
     gltf["bufferViews"].push_back({
         {"buffer", 0},
@@ -103,10 +169,10 @@ bool C3ToGLTF::Export(const C3Model& model, const ExportOptions& options) {
         {"min", json::array({minPos.x, minPos.y, minPos.z})},
         {"max", json::array({maxPos.x, maxPos.y, maxPos.z})}
         });
-    int posAccessor = accessorIdx++;
+    int posAccessor = static_cast<int>(gltf["accessors"].size()) - 1;
 
     // Write normals (calculated from morph targets)
-    size_t normOffset = bufferData.data.size();
+    size_t normOffset = buffer.data.size();
     for (const auto& v : mesh.vertices) {
         XMFLOAT3 v0 = v.positions[0];
         XMFLOAT3 v1 = v.positions[1];
@@ -122,10 +188,10 @@ bool C3ToGLTF::Export(const C3Model& model, const ExportOptions& options) {
 
         XMFLOAT3 n;
         XMStoreFloat3(&n, normal);
-        bufferData.WriteFloat3(n);
+        buffer.WriteFloat3(n);
     }
-    bufferData.Align4();
-    size_t normSize = bufferData.data.size() - normOffset;
+    buffer.Align4();
+    size_t normSize = buffer.data.size() - normOffset;
 
     gltf["bufferViews"].push_back({
         {"buffer", 0},
@@ -140,15 +206,15 @@ bool C3ToGLTF::Export(const C3Model& model, const ExportOptions& options) {
         {"count", mesh.vertices.size()},
         {"type", "VEC3"}
         });
-    int normAccessor = accessorIdx++;
+    int normAccessor = static_cast<int>(gltf["accessors"].size()) - 1;
 
     // Write UVs
-    size_t uvOffset = bufferData.data.size();
+    size_t uvOffset = buffer.data.size();
     for (const auto& v : mesh.vertices) {
-        bufferData.WriteFloat2(XMFLOAT2(v.u, v.v));
+        buffer.WriteFloat2(XMFLOAT2(v.u, v.v));
     }
-    bufferData.Align4();
-    size_t uvSize = bufferData.data.size() - uvOffset;
+    buffer.Align4();
+    size_t uvSize = buffer.data.size() - uvOffset;
 
     gltf["bufferViews"].push_back({
         {"buffer", 0},
@@ -163,19 +229,19 @@ bool C3ToGLTF::Export(const C3Model& model, const ExportOptions& options) {
         {"count", mesh.vertices.size()},
         {"type", "VEC2"}
         });
-    int uvAccessor = accessorIdx++;
+    int uvAccessor = static_cast<int>(gltf["accessors"].size()) - 1;
 
     // Write colors
-    size_t colorOffset = bufferData.data.size();
+    size_t colorOffset = buffer.data.size();
     for (const auto& v : mesh.vertices) {
         uint8_t a = (v.color >> 24) & 0xFF;
         uint8_t r = (v.color >> 16) & 0xFF;
         uint8_t g = (v.color >> 8) & 0xFF;
         uint8_t b = v.color & 0xFF;
-        bufferData.WriteFloat4(XMFLOAT4(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f));
+        buffer.WriteFloat4(XMFLOAT4(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f));
     }
-    bufferData.Align4();
-    size_t colorSize = bufferData.data.size() - colorOffset;
+    buffer.Align4();
+    size_t colorSize = buffer.data.size() - colorOffset;
 
     gltf["bufferViews"].push_back({
         {"buffer", 0},
@@ -190,18 +256,18 @@ bool C3ToGLTF::Export(const C3Model& model, const ExportOptions& options) {
         {"count", mesh.vertices.size()},
         {"type", "VEC4"}
         });
-    int colorAccessor = accessorIdx++;
+    int colorAccessor = static_cast<int>(gltf["accessors"].size()) - 1;
 
     // Write indices (combine normal + alpha)
     std::vector<uint16_t> allIndices = mesh.normalIndices;
     allIndices.insert(allIndices.end(), mesh.alphaIndices.begin(), mesh.alphaIndices.end());
 
-    size_t idxOffset = bufferData.data.size();
+    size_t idxOffset = buffer.data.size();
     for (uint16_t idx : allIndices) {
-        bufferData.WriteUInt16(idx);
+        buffer.WriteUInt16(idx);
     }
-    bufferData.Align4();
-    size_t idxSize = bufferData.data.size() - idxOffset;
+    buffer.Align4();
+    size_t idxSize = buffer.data.size() - idxOffset;
 
     gltf["bufferViews"].push_back({
         {"buffer", 0},
@@ -216,22 +282,22 @@ bool C3ToGLTF::Export(const C3Model& model, const ExportOptions& options) {
         {"count", allIndices.size()},
         {"type", "SCALAR"}
         });
-    int idxAccessor = accessorIdx++;
+    int idxAccessor = static_cast<int>(gltf["accessors"].size()) - 1;
 
     // Morph targets (if enabled)
     std::vector<int> morphAccessors;
-    if (options.exportMorphTargets) {
+    if (opts.exportMorphTargets) {
         for (int target = 1; target < 4; target++) {
-            size_t morphOffset = bufferData.data.size();
+            size_t morphOffset = buffer.data.size();
             for (const auto& v : mesh.vertices) {
                 XMFLOAT3 delta;
                 delta.x = v.positions[target].x - v.positions[0].x;
                 delta.y = v.positions[target].y - v.positions[0].y;
                 delta.z = v.positions[target].z - v.positions[0].z;
-                bufferData.WriteFloat3(delta);
+                buffer.WriteFloat3(delta);
             }
-            bufferData.Align4();
-            size_t morphSize = bufferData.data.size() - morphOffset;
+            buffer.Align4();
+            size_t morphSize = buffer.data.size() - morphOffset;
 
             gltf["bufferViews"].push_back({
                 {"buffer", 0},
@@ -246,7 +312,7 @@ bool C3ToGLTF::Export(const C3Model& model, const ExportOptions& options) {
                 {"count", mesh.vertices.size()},
                 {"type", "VEC3"}
                 });
-            morphAccessors.push_back(accessorIdx++);
+            morphAccessors.push_back(static_cast<int>(gltf["accessors"].size()) - 1);
         }
     }
 
@@ -275,44 +341,5 @@ bool C3ToGLTF::Export(const C3Model& model, const ExportOptions& options) {
         {"primitives", json::array({primitive})}
         });
 
-    // Nodes and scene
-    gltf["nodes"] = json::array({
-        {{"name", "C3Model"}, {"mesh", 0}}
-        });
-
-    gltf["scenes"] = json::array({
-        {{"name", "Scene"}, {"nodes", json::array({0})}}
-        });
-    gltf["scene"] = 0;
-
-    // Determine output paths
-    std::filesystem::path outputPath(options.outputPath);
-    std::string basePath = outputPath.parent_path().string() + "/" + outputPath.stem().string();
-    std::string binPath = basePath + ".bin";
-    std::string gltfPath = basePath + ".gltf";
-
-    // Write binary file
-    std::ofstream binFile(binPath, std::ios::binary);
-    if (!binFile) {
-        m_lastError = "Failed to create .bin file";
-        return false;
-    }
-    binFile.write(reinterpret_cast<const char*>(bufferData.data.data()), bufferData.data.size());
-    binFile.close();
-
-    // Write glTF JSON
-    std::string binFilename = std::filesystem::path(binPath).filename().string();
-    gltf["buffers"] = json::array({
-        {{"byteLength", bufferData.data.size()}, {"uri", binFilename}}
-        });
-
-    std::ofstream gltfFile(gltfPath);
-    if (!gltfFile) {
-        m_lastError = "Failed to create .gltf file";
-        return false;
-    }
-    gltfFile << gltf.dump(2);
-    gltfFile.close();
-
     return true;
 }
\ No newline at end of file
@@ -34,7 +34,16 @@ bool C3Writer::Write(const C3Model& model, const std::string& path) {
     // Write PHYS/PHY chunks
     const auto& meshes = model.GetMeshes();
     for (const auto& mesh : meshes) {
-        WritePHYChunk(file, mesh, type);
+        WritePHYChunk(file, mesh, mesh.name, type);
+    }
+
+    // LOD levels follow as extra PHY chunks, named "<mesh>_lod<N>"
+    if (m_writeLODs) {
+        for (const auto& mesh : meshes) {
+            for (size_t level = 0; level < mesh.lods.size(); level++) {
+                WritePHYChunk(file, mesh.lods[level], mesh.name + "_lod" + std::to_string(level + 1), type);
+            }
+        }
     }
 
     // Write MOTI chunks (animations)
@@ -59,7 +68,8 @@ bool C3Writer::Write(const C3Model& model, const std::string& path) {
     return true;
 }
 
-void C3Writer::WritePHYChunk(std::ofstream& file, const C3Model::MeshPart& mesh, C3ChunkType type) {
+void C3Writer::WritePHYChunk(std::ofstream& file, const C3Model::MeshPart& mesh, const std::string& name,
+    C3ChunkType type) {
     // Chunk header
     ChunkHeader chunk;
     if (type == C3ChunkType::PHY3) {
@@ -74,9 +84,9 @@ void C3Writer::WritePHYChunk(std::ofstream& file, const C3Model::MeshPart& mesh,
     file.write(reinterpret_cast<const char*>(&chunk), sizeof(chunk));
 
     // Name
-    uint32_t nameLen = static_cast<uint32_t>(mesh.name.length());
+    uint32_t nameLen = static_cast<uint32_t>(name.length());
     file.write(reinterpret_cast<const char*>(&nameLen), 4);
-    file.write(mesh.name.c_str(), nameLen);
+    file.write(name.c_str(), nameLen);
     chunk.dwChunkSize += 4 + nameLen;
 
     // Blend count
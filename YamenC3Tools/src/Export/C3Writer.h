@@ -9,12 +9,18 @@ public:
     bool Write(const C3Model& model, const std::string& path);
     const std::string& GetLastError() const { return m_lastError; }
 
+    // Also store MeshPart::lods, as extra PHY chunks named "<mesh>_lod<N>".
+    // C3Model folds them back into lods on load; other readers draw them as
+    // meshes of their own, so this is off by default.
+    void SetWriteLODs(bool write) { m_writeLODs = write; }
+
 private:
-    void WritePHYChunk(std::ofstream& file, const C3Model::MeshPart& mesh, C3ChunkType type);
+    void WritePHYChunk(std::ofstream& file, const C3Model::MeshPart& mesh, const std::string& name, C3ChunkType type);
     void WriteMOTIChunk(std::ofstream& file, const C3Model::Animation& anim);
     void WriteSHAPChunk(std::ofstream& file, const C3Model::ShapeData& shape);
     void WritePTCLChunk(std::ofstream& file, const C3Model::ParticleSystem& ps);
 
     std::string m_lastError;
+    bool m_writeLODs = false;
 };
 
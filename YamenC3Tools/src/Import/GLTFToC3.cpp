@@ -1,7 +1,8 @@
 #include "GLTFToC3.h"
 #include "../Core/C3Model.h"
 #include "../Core/C3Types.h"
-#include <fstream>
+#include "../Core/C3MeshSplitter.h"
+#include "../Core/C3VirtualFileSystem.h"
 #include <filesystem>
 #include <cstring>
 #include <DirectXMath.h>
@@ -11,41 +12,32 @@ using json = nlohmann::json;
 
 bool GLTFToC3::Import(const std::string& path, C3Model& outModel, const ImportOptions& options) {
     // Parse glTF JSON
-    std::ifstream file(path);
-    if (!file) {
+    std::vector<uint8_t> jsonData;
+    if (!C3VirtualFileSystem::Get().ReadFile(path, jsonData)) {
         m_lastError = "Failed to open glTF file";
         return false;
     }
 
     json gltf;
     try {
-        file >> gltf;
+        gltf = json::parse(jsonData.begin(), jsonData.end());
     }
     catch (const std::exception& e) {
         m_lastError = std::string("Failed to parse JSON: ") + e.what();
         return false;
     }
-    file.close();
 
     // Load binary data
     std::filesystem::path gltfPath(path);
     std::string binPath = gltfPath.parent_path().string() + "/" +
         gltf["buffers"][0]["uri"].get<std::string>();
 
-    std::ifstream binFile(binPath, std::ios::binary);
-    if (!binFile) {
+    std::vector<uint8_t> binData;
+    if (!C3VirtualFileSystem::Get().ReadFile(binPath, binData)) {
         m_lastError = "Failed to open .bin file";
         return false;
     }
 
-    binFile.seekg(0, std::ios::end);
-    size_t binSize = binFile.tellg();
-    binFile.seekg(0, std::ios::beg);
-
-    std::vector<uint8_t> binData(binSize);
-    binFile.read(reinterpret_cast<char*>(binData.data()), binSize);
-    binFile.close();
-
     // Parse mesh
     if (!gltf.contains("meshes") || gltf["meshes"].empty()) {
         m_lastError = "No meshes found in glTF";
@@ -58,21 +50,29 @@ bool GLTFToC3::Import(const std::string& path, C3Model& outModel, const ImportOp
 
     // Read positions
     int posAccessor = attributes["POSITION"];
-    std::vector<XMFLOAT3> positions = ReadVec3Accessor(gltf, binData, posAccessor);
+    std::vector<XMFLOAT3> positions;
+    if (!ReadVec3Accessor(gltf, binData, posAccessor, positions)) {
+        return false;
+    }
 
     // Read morph targets
     std::vector<std::vector<XMFLOAT3>> morphTargets;
     if (primitive.contains("targets") && options.preserveMorphTargets) {
         for (const auto& target : primitive["targets"]) {
             int morphAccessor = target["POSITION"];
-            morphTargets.push_back(ReadVec3Accessor(gltf, binData, morphAccessor));
+            morphTargets.emplace_back();
+            if (!ReadVec3Accessor(gltf, binData, morphAccessor, morphTargets.back())) {
+                return false;
+            }
         }
     }
 
     // Read UVs
     std::vector<XMFLOAT2> uvs;
     if (attributes.contains("TEXCOORD_0")) {
-        uvs = ReadVec2Accessor(gltf, binData, attributes["TEXCOORD_0"]);
+        if (!ReadVec2Accessor(gltf, binData, attributes["TEXCOORD_0"], uvs)) {
+            return false;
+        }
     }
     else {
         uvs.resize(positions.size(), XMFLOAT2{ 0, 0 });
@@ -81,7 +81,9 @@ bool GLTFToC3::Import(const std::string& path, C3Model& outModel, const ImportOp
     // Read colors
     std::vector<XMFLOAT4> colors;
     if (attributes.contains("COLOR_0") && options.importVertexColors) {
-        colors = ReadVec4Accessor(gltf, binData, attributes["COLOR_0"]);
+        if (!ReadVec4Accessor(gltf, binData, attributes["COLOR_0"], colors)) {
+            return false;
+        }
     }
     else {
         colors.resize(positions.size(), XMFLOAT4{ 1, 1, 1, 1 });
@@ -89,15 +91,25 @@ bool GLTFToC3::Import(const std::string& path, C3Model& outModel, const ImportOp
 
     // Read indices
     int indexAccessor = primitive["indices"];
-    std::vector<uint16_t> indices = ReadU16Accessor(gltf, binData, indexAccessor);
+    std::vector<uint32_t> indices;
+    if (!ReadIndexAccessor(gltf, binData, indexAccessor, indices)) {
+        return false;
+    }
+
+    // Every per-vertex stream is indexed by the POSITION count below
+    bool streamsMatch = uvs.size() == positions.size() && colors.size() == positions.size();
+    for (const auto& target : morphTargets) streamsMatch = streamsMatch && target.size() == positions.size();
+    if (!streamsMatch) {
+        m_lastError = "Vertex attribute counts do not match POSITION";
+        return false;
+    }
 
-    // Convert to C3 format
-    C3Model::MeshPart part;
-    part.name = mesh.contains("name") ? mesh["name"].get<std::string>() : "imported_mesh";
-    part.vertices.resize(positions.size());
+    // Convert to C3 format (32-bit indices until the mesh is split into PHY parts)
+    C3MeshSplitter::SourceMesh source;
+    source.vertices.resize(positions.size());
 
     for (size_t i = 0; i < positions.size(); i++) {
-        PhyVertex& v = part.vertices[i];
+        PhyVertex& v = source.vertices[i];
 
         // Base position
         v.positions[0] = positions[i];
@@ -132,58 +144,103 @@ bool GLTFToC3::Import(const std::string& path, C3Model& outModel, const ImportOp
         v.boneWeights[1] = 0.0f;
     }
 
-    part.normalIndices = indices;
+    source.normalIndices = std::move(indices);
+
+    C3Model::MeshPart templ;
+    templ.name = mesh.contains("name") ? mesh["name"].get<std::string>() : "imported_mesh";
+
+    // PHY indices are 16-bit; oversized meshes become several parts
+    std::vector<C3Model::MeshPart> parts;
+    if (!C3MeshSplitter::Split(source, templ, parts, &m_lastError)) {
+        return false;
+    }
 
     // Add mesh to model (using non-const version)
-    outModel.GetMeshes().push_back(part);
+    for (auto& part : parts) {
+        outModel.GetMeshes().push_back(std::move(part));
+    }
+    outModel.RecalculateBounds();
     
     return true;
 }
 
-std::vector<XMFLOAT3> GLTFToC3::ReadVec3Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx) {
-    const auto& accessor = gltf["accessors"][accessorIdx];
-    const auto& bufferView = gltf["bufferViews"][int(accessor["bufferView"])];
-
-    size_t offset = bufferView.value("byteOffset", 0) + accessor.value("byteOffset", 0);
-    size_t count = accessor["count"];
+const uint8_t* GLTFToC3::AccessorData(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx,
+    size_t elementSize, size_t& count) {
+    const json& accessors = gltf["accessors"];
+    if (accessorIdx < 0 || size_t(accessorIdx) >= accessors.size()) {
+        m_lastError = "Invalid accessor index: " + std::to_string(accessorIdx);
+        return nullptr;
+    }
+    const auto& accessor = accessors[accessorIdx];
+    const int viewIdx = accessor.value("bufferView", -1);
+    if (viewIdx < 0 || size_t(viewIdx) >= gltf["bufferViews"].size()) {
+        m_lastError = "Accessor " + std::to_string(accessorIdx) + " has no valid bufferView";
+        return nullptr;
+    }
+    const auto& bufferView = gltf["bufferViews"][viewIdx];
 
-    std::vector<XMFLOAT3> result(count);
-    memcpy(result.data(), binData.data() + offset, count * sizeof(XMFLOAT3));
-    return result;
+    size_t offset = bufferView.value("byteOffset", size_t(0)) + accessor.value("byteOffset", size_t(0));
+    count = accessor.value("count", size_t(0));
+    if (offset > binData.size() || count > (binData.size() - offset) / elementSize) {
+        m_lastError = "Accessor " + std::to_string(accessorIdx) + " reads past the end of the .bin file";
+        return nullptr;
+    }
+    return binData.data() + offset;
 }
 
-std::vector<XMFLOAT2> GLTFToC3::ReadVec2Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx) {
-    const auto& accessor = gltf["accessors"][accessorIdx];
-    const auto& bufferView = gltf["bufferViews"][int(accessor["bufferView"])];
-
-    size_t offset = bufferView.value("byteOffset", 0) + accessor.value("byteOffset", 0);
-    size_t count = accessor["count"];
-
-    std::vector<XMFLOAT2> result(count);
-    memcpy(result.data(), binData.data() + offset, count * sizeof(XMFLOAT2));
-    return result;
+bool GLTFToC3::ReadVec3Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx, std::vector<XMFLOAT3>& out) {
+    size_t count = 0;
+    const uint8_t* src = AccessorData(gltf, binData, accessorIdx, sizeof(XMFLOAT3), count);
+    if (!src) return false;
+    out.resize(count);
+    memcpy(out.data(), src, count * sizeof(XMFLOAT3));
+    return true;
 }
 
-std::vector<XMFLOAT4> GLTFToC3::ReadVec4Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx) {
-    const auto& accessor = gltf["accessors"][accessorIdx];
-    const auto& bufferView = gltf["bufferViews"][int(accessor["bufferView"])];
-
-    size_t offset = bufferView.value("byteOffset", 0) + accessor.value("byteOffset", 0);
-    size_t count = accessor["count"];
+bool GLTFToC3::ReadVec2Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx, std::vector<XMFLOAT2>& out) {
+    size_t count = 0;
+    const uint8_t* src = AccessorData(gltf, binData, accessorIdx, sizeof(XMFLOAT2), count);
+    if (!src) return false;
+    out.resize(count);
+    memcpy(out.data(), src, count * sizeof(XMFLOAT2));
+    return true;
+}
 
-    std::vector<XMFLOAT4> result(count);
-    memcpy(result.data(), binData.data() + offset, count * sizeof(XMFLOAT4));
-    return result;
+bool GLTFToC3::ReadVec4Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx, std::vector<XMFLOAT4>& out) {
+    size_t count = 0;
+    const uint8_t* src = AccessorData(gltf, binData, accessorIdx, sizeof(XMFLOAT4), count);
+    if (!src) return false;
+    out.resize(count);
+    memcpy(out.data(), src, count * sizeof(XMFLOAT4));
+    return true;
 }
 
-std::vector<uint16_t> GLTFToC3::ReadU16Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx) {
-    const auto& accessor = gltf["accessors"][accessorIdx];
-    const auto& bufferView = gltf["bufferViews"][int(accessor["bufferView"])];
+bool GLTFToC3::ReadIndexAccessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx, std::vector<uint32_t>& out) {
+    if (accessorIdx < 0 || size_t(accessorIdx) >= gltf["accessors"].size()) {
+        m_lastError = "Invalid accessor index: " + std::to_string(accessorIdx);
+        return false;
+    }
+    const int componentType = gltf["accessors"][accessorIdx].value("componentType", 5123);
+    const size_t componentSize = (componentType == 5125) ? sizeof(uint32_t) : // UNSIGNED_INT
+        (componentType == 5121) ? sizeof(uint8_t) : sizeof(uint16_t);        // UNSIGNED_BYTE, UNSIGNED_SHORT
 
-    size_t offset = bufferView.value("byteOffset", 0) + accessor.value("byteOffset", 0);
-    size_t count = accessor["count"];
+    size_t count = 0;
+    const uint8_t* src = AccessorData(gltf, binData, accessorIdx, componentSize, count);
+    if (!src) return false;
 
-    std::vector<uint16_t> result(count);
-    memcpy(result.data(), binData.data() + offset, count * sizeof(uint16_t));
-    return result;
-}
\ No newline at end of file
+    out.resize(count);
+    if (componentSize == sizeof(uint32_t)) {
+        memcpy(out.data(), src, count * sizeof(uint32_t));
+    }
+    else if (componentSize == sizeof(uint8_t)) {
+        for (size_t i = 0; i < count; i++) out[i] = src[i];
+    }
+    else {
+        for (size_t i = 0; i < count; i++) {
+            uint16_t idx;
+            memcpy(&idx, src + i * sizeof(uint16_t), sizeof(uint16_t));
+            out[i] = idx;
+        }
+    }
+    return true;
+}
@@ -11,8 +11,13 @@ public:
 private:
     using json = nlohmann::json;
 
-    std::vector<XMFLOAT3> ReadVec3Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx);
-    std::vector<XMFLOAT2> ReadVec2Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx);
-    std::vector<XMFLOAT4> ReadVec4Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx);
-    std::vector<uint16_t> ReadU16Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx);
+    // Start of the accessor's tightly packed elements in binData, or null
+    // (with m_lastError set) if count * elementSize bytes do not fit there
+    const uint8_t* AccessorData(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx,
+        size_t elementSize, size_t& count);
+
+    bool ReadVec3Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx, std::vector<XMFLOAT3>& out);
+    bool ReadVec2Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx, std::vector<XMFLOAT2>& out);
+    bool ReadVec4Accessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx, std::vector<XMFLOAT4>& out);
+    bool ReadIndexAccessor(const json& gltf, const std::vector<uint8_t>& binData, int accessorIdx, std::vector<uint32_t>& out);
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 ﻿#include "D3D11Renderer.h"
+#include "../Core/C3MeshOps.h"
 #include <d3dcompiler.h>
 #include <algorithm>
 
@@ -442,9 +443,8 @@ bool D3D11Renderer::LoadModel(const C3Model& model) {
     const auto& meshes = model.GetMeshes();
     if (meshes.empty()) return false;
 
-    XMFLOAT3 center = model.GetCenter();
-    float radius = model.GetRadius();
-    float scale = (radius > 0) ? (2.0f / radius) : 1.0f;
+    // Center and scale to a radius of 2, applied as one batched transform per mesh
+    XMMATRIX normalize = C3MeshOps::NormalizationMatrix(model, 2.0f);
 
     for (const auto& mesh : meshes) {
         if (mesh.vertices.empty()) continue;
@@ -455,27 +455,11 @@ bool D3D11Renderer::LoadModel(const C3Model& model) {
         for (const auto& v : mesh.vertices) {
             RenderVertex rv;
 
-            // Set all 4 morph target positions (FIXED!)
-            rv.pos0 = XMFLOAT3(
-                (v.positions[0].x - center.x) * scale,
-                (v.positions[0].y - center.y) * scale,
-                (v.positions[0].z - center.z) * scale
-            );
-            rv.pos1 = XMFLOAT3(
-                (v.positions[1].x - center.x) * scale,
-                (v.positions[1].y - center.y) * scale,
-                (v.positions[1].z - center.z) * scale
-            );
-            rv.pos2 = XMFLOAT3(
-                (v.positions[2].x - center.x) * scale,
-                (v.positions[2].y - center.y) * scale,
-                (v.positions[2].z - center.z) * scale
-            );
-            rv.pos3 = XMFLOAT3(
-                (v.positions[3].x - center.x) * scale,
-                (v.positions[3].y - center.y) * scale,
-                (v.positions[3].z - center.z) * scale
-            );
+            // All 4 morph target positions, normalized below
+            rv.pos0 = v.positions[0];
+            rv.pos1 = v.positions[1];
+            rv.pos2 = v.positions[2];
+            rv.pos3 = v.positions[3];
 
             rv.texCoord = XMFLOAT2(v.u, v.v);
 
@@ -492,6 +476,11 @@ bool D3D11Renderer::LoadModel(const C3Model& model) {
             vertices.push_back(rv);
         }
 
+        C3MeshOps::TransformPositions(&vertices[0].pos0, sizeof(RenderVertex), vertices.size(), normalize);
+        C3MeshOps::TransformPositions(&vertices[0].pos1, sizeof(RenderVertex), vertices.size(), normalize);
+        C3MeshOps::TransformPositions(&vertices[0].pos2, sizeof(RenderVertex), vertices.size(), normalize);
+        C3MeshOps::TransformPositions(&vertices[0].pos3, sizeof(RenderVertex), vertices.size(), normalize);
+
         MeshBuffer mb = {};
 
         D3D11_BUFFER_DESC vbd = {};
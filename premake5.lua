@@ -72,4 +72,49 @@ project "YamenC3Tools"
         defines { "NDEBUG" }
         runtime "Release"
         optimize "speed"
-        inlining "auto"
\ No newline at end of file
+        inlining "auto"
+
+project "YamenC3Bench"
+    location "YamenC3Tools"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+    staticruntime "off"
+
+    targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+    objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+
+    files {
+        "YamenC3Tools/src/Core/**.h",
+        "YamenC3Tools/src/Core/**.cpp",
+        "YamenC3Tools/src/Export/C3ArchivePacker.h",
+        "YamenC3Tools/src/Export/C3ArchivePacker.cpp",
+        "YamenC3Tools/bench/**.h",
+        "YamenC3Tools/bench/**.cpp"
+    }
+
+    includedirs {
+        "YamenC3Tools/src"
+    }
+
+    defines {
+        "_CRT_SECURE_NO_WARNINGS",
+        "NOMINMAX",
+        "WIN32_LEAN_AND_MEAN"
+    }
+
+    filter "system:windows"
+        systemversion "latest"
+        defines { "PLATFORM_WINDOWS" }
+
+    filter "configurations:Debug"
+        defines { "DEBUG" }
+        runtime "Debug"
+        symbols "on"
+        optimize "off"
+
+    filter "configurations:Release"
+        defines { "NDEBUG" }
+        runtime "Release"
+        optimize "speed"
+        inlining "auto"